@@ -129,7 +129,8 @@ public:
   /// Yanks range to register, default to yank register.
   bool Yank(const char name = '0') const;
 private:  
-  const std::string BuildReplacement(const std::string& text) const;
+  static const std::string BuildReplacement(
+    const std::string& text, std::string target);
   int Confirm(const std::string& pattern, const std::string& replacement);
   bool Parse(const std::string& command, 
     std::string& pattern, std::string& replacement, std::string& options) const;
@@ -145,6 +146,8 @@ private:
     m_End.SetLine(end);};
   void Set(wxExAddress& begin, wxExAddress& end, int lines);
   bool SetSelection() const;
+  int SubstituteAll(const std::string& pattern, const std::string& repl,
+    int flags, bool global, int begin_line, int end_line) const;
 
   static inline std::string m_Pattern;
   static inline std::string m_Replacement;
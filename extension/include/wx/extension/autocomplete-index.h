@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      autocomplete-index.h
+// Purpose:   Declaration of class wxExAutoCompleteIndex
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+
+/// Offers a prefix index on words, used for autocompletion.
+/// The words are kept in a sorted array, the candidates for a prefix
+/// are a range in this array. If the prefix extends the previous prefix,
+/// as it does while typing, the range is narrowed from the previous range.
+class wxExAutoCompleteIndex
+{
+public:
+  /// Constructor.
+  wxExAutoCompleteIndex(
+    /// words shorter than min size are not added
+    size_t min_size = 0,
+    /// max number of candidates returned by Get
+    size_t max_candidates = 1000);
+
+  /// Adds a word, returns false if the word was too short,
+  /// or already present.
+  bool Add(const std::string& word);
+
+  /// Replaces all words by the words in the set.
+  void Assign(const std::set<std::string>& words);
+
+  /// Clears all words.
+  void Clear();
+
+  /// Returns the candidates starting with the prefix, each one
+  /// followed by a space, and at most the max candidates.
+  /// The result is kept in a buffer that is reused by the next call.
+  const std::string& Get(const std::string& prefix);
+
+  /// Returns number of words.
+  auto GetSize() const {return m_Words.size();};
+private:
+  const size_t m_MaxCandidates;
+  const size_t m_MinSize;
+
+  std::vector<std::string> m_Words;
+
+  // The previous prefix, its range, and its candidates.
+  bool m_Valid {false};
+  std::string m_Prefix;
+  size_t m_First {0}, m_Last {0};
+  std::string m_Buffer;
+};
@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 #include <wx/dlimpexp.h>
+#include <wx/extension/autocomplete-index.h>
 #include <wx/extension/ctags-entry.h>
 
 class wxExSTC;
@@ -41,8 +42,8 @@ public:
 private:
   void Clear();
   bool ShowCTags(bool show) const;
-  bool ShowInserts(bool show) const;
-  bool ShowKeywords(bool show) const;
+  bool ShowInserts(bool show);
+  bool ShowKeywords(bool show);
   bool Use() const;
 
   const size_t m_MinSize;
@@ -50,7 +51,11 @@ private:
   bool m_Use {true};
 
   std::string m_Text;
-  std::set< std:: string > m_Inserts;
+
+  wxExAutoCompleteIndex m_Inserts, m_Keywords;
+
+  // The lexer version the keywords index was built from.
+  size_t m_KeywordsVersion {0};
 
   wxExCTagsEntry m_Filter;
   wxExSTC* m_STC;
@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      batch.h
+// Purpose:   Declaration of class wxExBatch
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <wx/extension/path.h>
+
+/// Applies a script to files without showing them,
+/// used by the batch command line option.
+/// Files are read and written on worker threads, while
+/// the script runs on the main thread, as a stc cannot
+/// be used on other threads.
+/// While running, a hidden managed frame is the top window,
+/// as used by the ex commands.
+class wxExBatch
+{
+public:
+  /// Constructor, each line of the script is a vi or ex command.
+  wxExBatch(const std::vector<std::string>& script)
+    : m_Script(script) {;};
+
+  /// Runs the script on the files, a directory is expanded to
+  /// all files matching filespec in it and its subdirectories,
+  /// hidden and version control directories are skipped.
+  /// Modified files are written back, each file is reported on stdout.
+  /// Returns number of files that failed.
+  int Run(
+    const std::vector<wxExPath>& files,
+    const std::string& filespec = "*") const;
+private:
+  const std::vector<std::string> m_Script;
+};
@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      ctags-index.h
+// Purpose:   Declaration of class wxExCTagsIndex
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <ctime>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class wxExCTagsEntry;
+
+/// Offers an in memory index on a ctags file.
+/// The file is read once, and all tag lines are indexed in a table
+/// sorted on name, so full and prefix matches are a binary search.
+/// The kind, class and access of each tag are kept as well,
+/// so a wxExCTagsEntry filter does not parse the extension fields again.
+/// An index is shared by all users of the same tags file, see Get.
+/// The shared index can be updated for some files without
+/// loading the tags file again, see Update.
+class wxExCTagsIndex
+{
+public:
+  /// Access types.
+  enum wxExCTagsAccess
+  {
+    ACCESS_NONE,      ///< no access field
+    ACCESS_PUBLIC,    ///< public
+    ACCESS_PROTECTED, ///< protected
+    ACCESS_PRIVATE,   ///< private
+  };
+
+  /// A tag, as parsed from its tag line.
+  struct wxExCTag
+  {
+    std::string_view m_Name;      ///< name
+    std::string_view m_File;      ///< file
+    std::string_view m_Pattern;   ///< search pattern, including delimiters
+    std::string_view m_Kind;      ///< kind
+    std::string_view m_Class;     ///< class field
+    std::string_view m_Signature; ///< signature field
+    std::string_view m_Typeref;   ///< typeref field
+    wxExCTagsAccess m_Access {ACCESS_NONE}; ///< access field
+    int m_LineNumber {0};         ///< line number, 0 if there is a pattern
+  };
+
+  /// Constructor, loads the tags file.
+  wxExCTagsIndex(const std::string& path);
+
+  /// The tags refer to the contents, so an index is not copied.
+  wxExCTagsIndex(const wxExCTagsIndex&) = delete;
+
+  /// The tags refer to the contents, so an index is not assigned.
+  wxExCTagsIndex& operator=(const wxExCTagsIndex&) = delete;
+
+  /// Returns the index for the tags file, the index is loaded once
+  /// and shared by all users. While it is loaded, other users
+  /// of the same file wait, other files can be used.
+  /// If the modification time of the file changed since it was loaded,
+  /// it is loaded again in the background, until then the current
+  /// index is returned.
+  /// Returns nullptr if the file could not be loaded.
+  static std::shared_ptr<const wxExCTagsIndex> Get(const std::string& path);
+
+  /// Returns true if the row passes the filter.
+  bool Filter(size_t row, const wxExCTagsEntry& filter) const;
+
+  /// Returns the rows with exactly this name, in file order.
+  std::pair<size_t, size_t> Find(const std::string_view& name) const;
+
+  /// Invokes the callback for the rows of which the name contains
+  /// the text as a subsequence, and that start with the same character,
+  /// until the callback returns false.
+  void FindFuzzy(const std::string_view& text,
+    std::function<bool(size_t)> callback) const;
+
+  /// Returns the rows of which the name starts with the prefix.
+  std::pair<size_t, size_t> FindPrefix(const std::string_view& prefix) const;
+
+  /// Returns the rows with this class field, or nullptr if there are none.
+  const std::vector<uint32_t>* GetClassRows(const std::string& name) const;
+
+  /// Returns the modification time of the file when it was loaded.
+  auto GetModificationTime() const {return m_ModificationTime;};
+
+  /// Returns the name of the row.
+  const auto& GetName(size_t row) const {return m_Rows[row].m_Name;};
+
+  /// Returns number of rows (tags).
+  auto GetSize() const {return m_Rows.size();};
+
+  /// Returns the tag of the row.
+  const wxExCTag GetTag(size_t row) const;
+
+  /// Returns true if the file was loaded.
+  bool IsOk() const {return m_IsOk;};
+
+  /// Loads the tags file now, and replaces the shared index,
+  /// as used when the file was just written.
+  /// Returns false if the file could not be loaded.
+  static bool Reload(const std::string& path);
+
+  /// Replaces in the shared index the tags of the files by the 
+  /// tag lines specified, a file without lines has its tags removed.
+  /// The tags of other files are kept, the tags file is not loaded.
+  /// Returns false if the index is not loaded, or being loaded,
+  /// then the tags file should be written and reloaded instead.
+  static bool Update(const std::string& path,
+    const std::map<std::string, std::vector<std::string>>& files);
+
+  /// Waits until loading the tags file in the background 
+  /// (as started by Get) is finished, the next Get 
+  /// returns the loaded index.
+  static void Wait(const std::string& path);
+
+  /// Tells that the tags file was just written with the tags
+  /// the shared index already has, so it is not loaded again.
+  static void Written(const std::string& path);
+private:
+  // The name is the start of the tag line.
+  struct wxExCTagsRow
+  {
+    std::string_view m_Name;
+    uint32_t m_Length;
+    uint32_t m_File;
+    uint32_t m_Kind;
+    uint32_t m_Class;
+    uint32_t m_Access;
+  };
+
+  // Constructor used by Update.
+  wxExCTagsIndex(const wxExCTagsIndex& index,
+    const std::map<std::string, std::vector<std::string>>& files);
+
+  void AddClassRows();
+  void AddRows(const std::string_view& text);
+  uint32_t Intern(const std::string_view& text);
+  void Load();
+
+  // The file is not mapped, as ctags might rewrite it
+  // while the index is still in use.
+  // An updated index shares the contents, and adds the new tag lines.
+  std::vector<std::shared_ptr<const std::string>> m_Contents;
+  bool m_IsOk {false};
+  time_t m_ModificationTime {0};
+
+  std::vector<wxExCTagsRow> m_Rows;
+
+  // Files, kinds, classes and access are kept once, 
+  // id 0 is the empty string.
+  std::vector<std::string_view> m_Strings {std::string_view()};
+  std::unordered_map<std::string_view, uint32_t> m_StringIds {{std::string_view(), 0}};
+
+  std::unordered_map<uint32_t, std::vector<uint32_t>> m_ClassRows;
+};
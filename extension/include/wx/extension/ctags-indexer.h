@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      ctags-indexer.h
+// Purpose:   Declaration of class wxExCTagsIndexer
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/// Offers incremental generation of a tags file for project files.
+/// Files are indexed by universal-ctags on a few low priority threads,
+/// only if their modification time or size changed since the last run,
+/// as kept in a manifest next to the tags file.
+/// Files are passed to ctags in batches, files that ctags could not
+/// index are not indexed again until they are changed.
+/// Hidden and version control directories are skipped, and only files
+/// having a lexer are indexed.
+/// After each batch the new tags are merged into the shared 
+/// wxExCTagsIndex, so wxExCTags uses them at once.
+/// The tags file is written lazily, when idle and a while after 
+/// it was last written, or at once if the shared index could not 
+/// be updated, and when the indexer is destroyed.
+class wxExCTagsIndexer
+{
+public:
+  /// Constructor, specify the tags file to generate,
+  /// and number of threads.
+  wxExCTagsIndexer(const std::string& tags, int threads = 2);
+
+  /// Destructor, stops indexing, files not yet indexed
+  /// are indexed next time.
+ ~wxExCTagsIndexer();
+
+  /// Adds a file or folder to be indexed, for a folder
+  /// all files in it matching one of the patterns are added.
+  void Add(const std::string& path,
+    const std::string& patterns = std::string());
+
+  /// Returns the indexer, default the tags file is
+  /// generated in the config dir.
+  static wxExCTagsIndexer* Get(bool createOnDemand = true);
+
+  /// Returns the tags file.
+  const auto& GetTagsFile() const {return m_TagsFile;};
+
+  /// Sets the object as the current one, returns the pointer
+  /// to the previous current object
+  /// (both the parameter and returned value may be nullptr).
+  static wxExCTagsIndexer* Set(wxExCTagsIndexer* indexer);
+
+  /// Indexes the file again, as it was saved.
+  /// Returns false if the file is not indexed by this indexer.
+  bool Update(const std::string& path);
+
+  /// Waits until all files added are indexed.
+  void Wait();
+private:
+  struct wxExCTagsIndexerFile
+  {
+    time_t m_ModificationTime {0};
+    long m_Size {0};
+    // Shared, so the files can be copied to be written.
+    std::shared_ptr<const std::vector<std::string>> m_Lines;
+  };
+
+  struct wxExCTagsIndexerItem
+  {
+    std::string m_Path;
+    std::string m_Patterns;
+    bool m_Force;
+    bool m_IsDirectory;
+  };
+
+  void Expand(const wxExCTagsIndexerItem& item);
+  bool Index(
+    const std::vector<std::string>& paths, 
+    std::map<std::string, std::vector<std::string>>& lines);
+  void Load();
+  void Run();
+  void Write();
+
+  const std::string m_TagsFile, m_ManifestFile;
+
+  bool 
+    m_Changed {false}, m_Stop {false}, m_Missing {false},
+    m_Reloading {false}, m_Stale {false};
+  int m_Busy {0};
+
+  std::map<std::string, wxExCTagsIndexerFile> m_Files;
+  // Files ctags failed on, with their modification time.
+  std::map<std::string, time_t> m_Failed;
+  std::deque<wxExCTagsIndexerItem> m_Queue;
+  std::unordered_set<std::string> m_Queued;
+
+  std::condition_variable m_Condition, m_Idle;
+  std::mutex m_Mutex, m_WriteMutex;
+  std::chrono::steady_clock::time_point m_Written {
+    std::chrono::steady_clock::now()};
+  std::once_flag m_Loaded;
+  std::vector<std::thread> m_Threads;
+
+  static wxExCTagsIndexer* m_Self;
+};
@@ -15,9 +15,10 @@
 class wxExCTagsInfo;
 class wxExEx;
 class wxExFrame;
-typedef struct sTagFile tagFile;
 
 /// Offers ctags handling.
+/// The ctags file is kept in a wxExCTagsIndex, that is shared
+/// by all wxExCTags using the same file.
 class WXDLLIMPEXP_BASE wxExCTags
 {
 public:  
@@ -33,10 +34,10 @@ public:
   /// Constructor, opens default ctags file.
   wxExCTags(wxExFrame* frame);
   
-  /// Destructor, closes ctags file.
- ~wxExCTags();
-  
   /// Tries to autocomplete text using the tags file.
+  /// Tags starting with text are returned first, if config
+  /// vi tag fuzzy is set, these are followed by tags
+  /// containing the characters of text in the same order.
   /// Returns a string with matches, or empty string if no match is found.
   std::string AutoComplete(
     /// text to be completed
@@ -79,7 +80,7 @@ private:
 
   wxExEx* m_Ex {nullptr};
   wxExFrame* m_Frame;
-  tagFile* m_File {nullptr};
+  std::string m_Path;
   const int m_Separator;
   bool m_Prepare {false};
   static std::map< std::string, wxExCTagsInfo > m_Matches;
@@ -64,6 +64,15 @@ public:
   /// Not made pure virtual, to allow this 
   /// class to be tested by calling FindFiles.
   virtual bool OnFile(const wxExPath& ) {return true;};
+protected:
+  /// Override to do action before finding begins.
+  /// The default does nothing.
+  virtual void FindFilesBegin() {;};
+  
+  /// Override to do action after finding has ended
+  /// (still running as interruptable process).
+  /// The default does nothing.
+  virtual void FindFilesEnd() {;};
 private:
   const wxExPath m_Dir;
   const std::string m_FileSpec;
@@ -31,6 +31,10 @@ class WXDLLIMPEXP_BASE wxExEx
 {
   friend class wxExViMacrosMode;
 public:
+  /// The stc marker number the global command uses to mark lines,
+  /// it is not used for character markers.
+  static constexpr int MARKER_GLOBAL = 24;
+
   /// Constructor. 
   /// Sets ex mode.
   wxExEx(wxExSTC* stc);
@@ -59,8 +63,8 @@ public:
   /// Returns command.
   const auto & GetCommand() const {return m_Command;};
 
-  /// Returns the ctags.
-  auto & GetCTags() {return m_CTags;};
+  /// Returns the ctags, created on first use.
+  wxExCTags* GetCTags();
   
   /// Returns frame.
   auto* GetFrame() {return m_Frame;};
@@ -141,7 +145,7 @@ protected:
 
   wxExExCommand m_Command;
 private:
-  bool CommandHandle(const std::string& command) const;
+  bool CommandHandle(const std::string& command);
   bool CommandAddress(const std::string& command);
   template <typename S, typename T> 
     bool HandleContainer(
@@ -176,7 +180,7 @@ private:
   wxExManagedFrame* m_Frame;  
   wxExCTags* m_CTags {nullptr};
 
-  const std::vector<std::pair<
+  static const std::vector<std::pair<
     const std::string, 
-    std::function<bool(const std::string& command)>>> m_Commands;
+    bool (*)(wxExEx* ex, const std::string& command)>> m_Commands;
 };
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      file-watcher.h
+// Purpose:   Declaration of class wxExFileWatcher
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <wx/dlimpexp.h>
+
+/// Offers a watch on a file, as returned by wxExFileWatcher::Watch.
+class WXDLLIMPEXP_BASE wxExFileWatch
+{
+  friend class wxExFileWatcher;
+public:
+  /// Constructor.
+  wxExFileWatch(const std::string& fullpath, int descriptor)
+    : m_Descriptor(descriptor)
+    , m_FullPath(fullpath) {;};
+
+  /// Returns the fullpath.
+  const auto & GetFullPath() const {return m_FullPath;};
+
+  /// Returns true if the file changed since last reset.
+  /// Initially true.
+  bool IsChanged() const {return m_Changed;};
+
+  /// Returns true if the file was moved or removed
+  /// (e.g. rotated), you need a new watch on the fullpath.
+  bool IsLost() const {return m_Lost;};
+
+  /// Resets changed.
+  void Reset() {m_Changed = false;};
+private:
+  const int m_Descriptor;
+  const std::string m_FullPath;
+  std::atomic_bool m_Changed {true}, m_Lost {false};
+};
+
+/// Offers event driven watching of files, so files can be synced
+/// without polling (stat) them. 
+/// Uses inotify, on other platforms watching is not available.
+/// Events are read by a thread, that wakes up idle processing 
+/// for each change.
+class WXDLLIMPEXP_BASE wxExFileWatcher
+{
+public:
+  /// Destructor, stops watching.
+ ~wxExFileWatcher();
+
+  /// Returns the file watcher.
+  static wxExFileWatcher* Get(bool createOnDemand = true);
+
+  /// Returns true if watching is available.
+  bool IsAvailable() const {return m_Descriptor != -1;};
+
+  /// Sets the object as the current one, returns the pointer 
+  /// to the previous current object 
+  /// (both the parameter and returned value may be nullptr). 
+  static wxExFileWatcher* Set(wxExFileWatcher* watcher);
+
+  /// Starts watching the file. Returns the watch, or nullptr if 
+  /// watching is not available, or the file does not exist.
+  /// Watching stops when the watch is destroyed.
+  std::shared_ptr<wxExFileWatch> Watch(const std::string& fullpath);
+private:
+  wxExFileWatcher();
+
+  void Remove(wxExFileWatch* watch);
+  void Run();
+
+  int m_Descriptor {-1};
+  int m_Pipe[2] {-1, -1};
+
+  std::map<int, std::vector<wxExFileWatch*>> m_Watches;
+  std::mutex m_Mutex;
+  std::thread m_Thread;
+
+  static wxExFileWatcher* m_Self;
+};
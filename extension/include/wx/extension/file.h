@@ -7,14 +7,19 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <wx/file.h>
 #include <wx/extension/path.h>
 #include <wx/extension/stat.h>
 
+class wxExFileWatch;
+
 /// Adds several File* methods to wxFile. All the File* methods update
 /// the wxExStat member. Also takes care of synchronization,
 /// all you have to do is call CheckSync once in a while.
+/// If available the file is watched by wxExFileWatcher, and CheckSync 
+/// only accesses the file after it was changed.
 class WXDLLIMPEXP_BASE wxExFile
 {
 public:
@@ -59,6 +64,7 @@ public:
   /// Checks whether this file can be synced, and 
   /// syncs (invokes DoFileLoad) the file if so.
   /// Returns true if this file was synced.
+  /// If the file is watched and not changed, returns false at once.
   bool CheckSync();
 
   /// Sets the filename member, opens the file if asked for,
@@ -103,6 +109,13 @@ public:
   /// Writes file from string.
   bool Write(const std::string& s) {
     return m_File->IsOpened() && m_File->Write(s);}; 
+
+  /// Writes string to file at seek position, 
+  /// overwriting the bytes already there.
+  bool Write(wxFileOffset seek_position, const std::string& s) {
+    return m_File->IsOpened() && 
+      m_File->Seek(seek_position) != wxInvalidOffset &&
+      m_File->Write(s.data(), s.size()) == s.size();};
 protected:
   /// Assigns the filename.
   /// Does not open the file, the filename does not need
@@ -112,7 +125,13 @@ protected:
   void Assign(const wxExPath& filename) {
     m_Path = filename;
     m_IsLoaded = true;
-    m_Stat = filename.Path().string();};
+    m_Stat = filename.Path().string();
+    m_SyncLength = 0;
+    m_Watch.reset();};
+
+  /// Returns true if DoFileSave only overwrites changed bytes,
+  /// then the file is not truncated when opened by FileSave.
+  virtual bool CanSaveInPlace() const {return false;};
 
   /// Invoked by FileLoad, allows you to load the file.
   /// The file is already opened, so you can call Read.
@@ -127,22 +146,51 @@ protected:
   /// The file is already opened.
   virtual void DoFileSave(bool save_as = false) {;};
 
+  /// Returns true if FileSave opened the file without truncating it,
+  /// as CanSaveInPlace returned true.
+  /// Valid during DoFileSave, otherwise false.
+  bool IsSavedInPlace() const {return m_IsSavedInPlace;};
+
+  /// Returns true if the file on disk is the file last loaded or saved:
+  /// same inode, size and modification time.
+  bool IsUnchangedOnDisk() const;
+
+  /// Returns true if the file only grew since it was last loaded
+  /// (same file, larger, and the part that was read is unchanged), 
+  /// so only the new data needs to be read.
+  /// Valid during DoFileLoad when synced, otherwise false.
+  bool IsAppended() const {return m_IsAppended;};
+
   /// Returns length.
   wxFileOffset Length() const {return m_File->Length();};
 private:
+  std::uint32_t Checksum(wxFileOffset length);
   bool Close() {return m_File->IsOpened() && m_File->Close();};
   bool Get(bool synced);
   void MakeAbsolute() {
     m_Path.MakeAbsolute();
-    if (m_Path.m_Stat.Sync(m_Path.Path().string())) {
+    if (m_Path.Sync()) {
       m_Stat.Sync(m_Path.Path().string());};};
   
+  bool m_IsAppended = false;
   bool m_IsLoaded = false;
+  bool m_IsSavedInPlace = false;
   bool m_OpenFile;
+
+  // Length and checksum of the part read by last load, 
+  // to detect whether the file was appended, or truncated or rotated.
+  wxFileOffset m_SyncLength = 0;
+  std::uint32_t m_SyncChecksum = 0;
   
+  std::shared_ptr<wxExFileWatch> m_Watch;
+
   std::unique_ptr<wxCharBuffer> m_Buffer;
   std::unique_ptr<wxFile> m_File;
 
   wxExPath m_Path;
   wxExStat m_Stat; // used for syncing, no public access
+  
+  // Stat of the file when last loaded or saved, unlike m_Stat 
+  // it is not synced if a sync was not done.
+  wxExStat m_ContentsStat;
 };
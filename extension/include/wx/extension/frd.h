@@ -8,11 +8,44 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <regex>
 #include <string>
+#include <string_view>
 #include <wx/fdrepdlg.h> // for wxFindReplaceData
 #include <wx/extension/textctrl.h>
 
+/// Offers a regular expression engine, used by wxExFindReplaceData.
+class WXDLLIMPEXP_BASE wxExRegExEngine
+{
+public:
+  /// The engines available.
+  enum wxExRegExEngineType
+  {
+    REGEX_STD, ///< std::regex, ECMAScript grammar
+    REGEX_DFA, ///< wxExRegExDFA, uses std::regex if regex is not supported
+  };
+
+  /// Returns a new engine for the regular expression.
+  /// Throws std::regex_error if the regular expression is invalid.
+  static std::unique_ptr<wxExRegExEngine> Create(
+    const std::string& regex, 
+    bool match_case = true,
+    wxExRegExEngineType type = REGEX_STD);
+
+  /// Destructor.
+  virtual ~wxExRegExEngine() {;};
+
+  /// Returns -1 if regular expression does not match text,
+  /// otherwise start pos of match.
+  virtual int Matches(const std::string_view& text) const = 0;
+
+  /// Replaces all matches in text by replace (ECMAScript format),
+  /// in one pass over the text.
+  /// Returns number of replacements done in text.
+  virtual int ReplaceAll(std::string& text, const std::string& replace) const = 0;
+};
+
 /// Adds an existing config to wxFindReplaceData, and some members.
 class WXDLLIMPEXP_BASE wxExFindReplaceData
 {
@@ -37,6 +70,9 @@ public:
   /// Access to data.
   auto & GetFRD() {return m_FRD;};
 
+  /// Returns the regular expression engine type.
+  auto GetRegExEngine() const {return m_RegExEngineType;};
+
   /// Returns the replace string.
   const auto GetReplaceString() const {return m_FRD.GetReplaceString().ToStdString();};
 
@@ -69,7 +105,7 @@ public:
   
   /// Returns -1 if GetFindString as regular expression does not match text,
   /// otherwise start pos of match.
-  int RegExMatches(const std::string& text) const;
+  int RegExMatches(const std::string_view& text) const;
   
   /// Replaces all occurrences of GetFindString as regular expression
   /// in text by GetReplaceString.
@@ -103,6 +139,10 @@ public:
   /// Sets flags for match word.
   void SetMatchWord(bool value);
 
+  /// Sets the regular expression engine type, 
+  /// and sets the regular expression again.
+  void SetRegExEngine(wxExRegExEngine::wxExRegExEngineType type);
+
   /// Sets the replace string.
   void SetReplaceString(const std::string& value);
 
@@ -125,6 +165,7 @@ private:
   static std::string m_TextMatchCase;
   static std::string m_TextMatchWholeWord;
   static std::string m_TextRegEx;
+  static std::string m_TextRegExEngine;
   static std::string m_TextReplaceWith;
   static std::string m_TextSearchDown;
   
@@ -135,7 +176,9 @@ private:
   wxExTextCtrlInput m_FindStrings;
   wxExTextCtrlInput m_ReplaceStrings;
 
-  std::regex m_FindRegEx;
+  wxExRegExEngine::wxExRegExEngineType m_RegExEngineType {
+    wxExRegExEngine::REGEX_STD};
+  std::shared_ptr<const wxExRegExEngine> m_RegExEngine;
 
   static wxExFindReplaceData* m_Self;
 };
@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      glob.h
+// Purpose:   Declaration of wxExGlob class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Offers a compiled file spec, a number of glob patterns separated 
+/// by a ; sign. In a pattern a * matches any sequence of characters,
+/// and a ? matches one character, all other characters match themselves.
+/// No regular expressions are used, so compile once and match many times.
+class wxExGlob
+{
+public:
+  /// Default constructor, compiles the pattern.
+  wxExGlob(const std::string& pattern = std::string());
+
+  /// Returns the compiled pattern from a small cache
+  /// of most recently used patterns (compiles it if not present).
+  static std::shared_ptr<const wxExGlob> Get(const std::string& pattern);
+
+  /// Returns the pattern.
+  const auto & GetPattern() const {return m_Pattern;};
+  
+  /// Returns true if text contains glob wildcards.
+  static bool IsWildcard(const std::string_view& text) {
+    return text.find_first_of("*?") != std::string_view::npos;};
+
+  /// Returns true if fullname matches one of the patterns.
+  bool Matches(const std::string_view& fullname) const;
+private:
+  enum wxExGlobType
+  {
+    GLOB_ANY,      ///< * only
+    GLOB_EXACT,    ///< no wildcards
+    GLOB_PREFIX,   ///< text followed by *
+    GLOB_SUFFIX,   ///< * followed by text
+    GLOB_WILDCARD, ///< all other patterns
+  };
+
+  struct wxExGlobPart
+  {
+    wxExGlobType m_Type;
+    std::string m_Text;
+  };
+
+  static bool MatchWildcard(
+    const std::string_view& pattern, const std::string_view& text);
+
+  const std::string m_Pattern;
+  std::vector<wxExGlobPart> m_Parts;
+};
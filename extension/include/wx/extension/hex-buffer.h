@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      hex-buffer.h
+// Purpose:   Declaration of class wxExHexBuffer
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// Offers the bytes edited in hex mode.
+/// The original bytes are kept once, and never changed,
+/// edits are kept as pieces referring to the original bytes
+/// or to the bytes added, so an edit does not copy the buffer.
+/// Each edit is kept in a journal as well, as the pieces
+/// it removed and inserted, used for undo and redo.
+class wxExHexBuffer
+{
+public:
+  /// The bytes changed by an undo or redo.
+  struct wxExHexChange
+  {
+    size_t m_Offset {0};    ///< offset of first byte changed
+    size_t m_Length {0};    ///< number of bytes changed, 0 if nothing changed
+    bool m_Resized {false}; ///< whether the bytes after the change moved
+  };
+
+  /// Appends bytes. These become part of the original bytes,
+  /// so these are not in the journal.
+  void Append(const std::string_view& text);
+
+  /// Assigns the original bytes, the journal is cleared,
+  /// and the save point set.
+  void Assign(std::string text);
+
+  /// Starts an edit, all changes until EndEdit are
+  /// undone and redone at once.
+  void BeginEdit() {if (!m_Editing) {m_Editing = true; m_EditStarted = false;}};
+
+  /// Returns true if there is an edit to redo.
+  bool CanRedo() const {return m_Done < m_Journal.size();};
+
+  /// Returns true if there is an edit to undo.
+  bool CanUndo() const {return m_Done > 0;};
+
+  /// Removes the save point, the bytes are modified
+  /// until the next save point.
+  void ClearSavePoint();
+
+  /// Copies at most count bytes starting at offset to the buffer,
+  /// returns number of bytes copied.
+  size_t Copy(size_t offset, size_t count, char* buffer) const;
+
+  /// Ends an edit.
+  void EndEdit() {m_Editing = false;};
+
+  /// Erases count bytes starting at offset.
+  /// Returns false if offset is out of range.
+  bool Erase(size_t offset, size_t count);
+
+  /// Returns count bytes starting at offset, default all bytes.
+  const std::string Get(
+    size_t offset = 0, size_t count = std::string::npos) const;
+
+  /// Returns the ranges (offset and length) of bytes that differ
+  /// from the bytes at the save point.
+  /// Only valid if the buffer is not resized.
+  const std::vector<std::pair<size_t, size_t>> GetChanged() const;
+
+  /// Returns number of bytes.
+  auto GetSize() const {return m_Offsets.back();};
+
+  /// Inserts bytes before offset.
+  /// Returns false if offset is out of range.
+  bool Insert(size_t offset, const std::string_view& text);
+
+  /// Returns true if the bytes differ from the save point.
+  bool IsModified() const {return m_Done != m_SavedDone;};
+
+  /// Returns true if the number of bytes differs from the save point.
+  bool IsResized() const {return GetSize() != m_SavedOffsets.back();};
+
+  /// Redoes the last edit undone.
+  const wxExHexChange Redo();
+
+  /// Replaces the byte at offset.
+  /// Returns false if offset is out of range.
+  bool Replace(size_t offset, char c);
+
+  /// Returns offset of the first occurrence of the text
+  /// at or after offset, or std::string::npos if there is none.
+  size_t Search(const std::string_view& text, 
+    size_t offset = 0, bool match_case = true) const;
+
+  /// Returns offset of the last occurrence of the text,
+  /// or std::string::npos if there is none.
+  size_t SearchLast(const std::string_view& text, bool match_case = true) const;
+
+  /// Sets the save point, as the bytes were saved.
+  void SetSavePoint();
+
+  /// Undoes the last edit.
+  const wxExHexChange Undo();
+private:
+  struct wxExHexPiece
+  {
+    bool m_Added;
+    size_t m_Start;
+    size_t m_Length;
+  };
+
+  struct wxExHexPatch
+  {
+    size_t m_Offset;
+    std::vector<wxExHexPiece> m_Removed, m_Inserted;
+  };
+
+  size_t Find(size_t offset) const;
+  std::vector<wxExHexPiece> Patch(
+    size_t offset, size_t count, const std::vector<wxExHexPiece>& insert);
+  void Record(wxExHexPatch patch);
+  size_t Split(size_t offset);
+  void Update(size_t piece = 0);
+
+  static size_t Length(const std::vector<wxExHexPiece>& pieces);
+
+  std::string m_Original, m_Added;
+
+  std::vector<wxExHexPiece> m_Pieces, m_SavedPieces;
+
+  // The offset of each piece, and the size.
+  std::vector<size_t> m_Offsets {0}, m_SavedOffsets {0};
+
+  // Each edit is a group of patches, edits before m_Done are done.
+  std::vector<std::vector<wxExHexPatch>> m_Journal;
+  size_t m_Done {0}, m_SavedDone {0};
+  bool m_Editing {false}, m_EditStarted {false};
+};
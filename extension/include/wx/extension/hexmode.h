@@ -8,11 +8,16 @@
 #pragma once
 
 #include <string>
+#include <wx/extension/hex-buffer.h>
 
 class wxExHexModeLine;
 class wxExSTC;
 
 /// Offers a hex mode.
+/// Only the lines that are visible, or about to be, are rendered
+/// into the stc component, others are rendered when needed.
+/// Searching, replacing and ex commands work on the stc component,
+/// these render the lines they need, see RenderFind.
 class WXDLLIMPEXP_BASE wxExHexMode
 {
   friend wxExHexModeLine;
@@ -46,7 +51,10 @@ public:
   
   /// Returns the buffer.
   /// The buffer contains the normal text, without hex info.
-  const auto & GetBuffer() const {return m_Buffer;};
+  const std::string GetBuffer() const {return m_Buffer.Get();};
+  
+  /// Returns the hex buffer, containing the original text and edits.
+  const auto & GetHexBuffer() const {return m_Buffer;};
   
   /// Returns info about current index,
   /// depending on which field is current.
@@ -71,6 +79,33 @@ public:
   /// hex codes, e.g. "30" inserts one byte space.
   bool Insert(const std::string& text, int pos = -1);
   
+  /// Redoes the last change of the buffer undone.
+  void Redo();
+
+  /// Renders the stc component again from the buffer,
+  /// keeping the current position.
+  void Refresh();
+  
+  /// Renders all lines not yet rendered.
+  void RenderAll() {RenderLines(m_Buffer.GetSize() / m_BytesPerLine);};
+
+  /// Renders lines until the next occurrence of the text 
+  /// after the lines rendered, or until the last occurrence
+  /// if not forward. The text is looked for as bytes, using
+  /// the search flags of the stc component, and as the bytes
+  /// it codes if it is a hex field, like "0A 0B".
+  /// For a regular expression all lines are rendered.
+  /// Returns false if no lines were rendered.
+  bool RenderFind(const std::string& text, bool forward = true);
+
+  /// Renders the lines containing bytes changed since last render,
+  /// and ends the buffer edit.
+  void RenderChanges();
+  
+  /// Renders lines, until at least the specified line 
+  /// is available on the stc component.
+  void RenderLines(int line);
+  
   /// Replaces current line at current index (if pos -1) with char for
   /// both ascii and hex field. Otherwise at specified pos.
   bool Replace(char c, int pos = -1);
@@ -95,21 +130,35 @@ public:
   /// where we are.
   void SetPos(const wxKeyEvent& event);
   
+  /// Sets the save point of the buffer, as it was saved.
+  void SetSavePoint() {m_Buffer.SetSavePoint();};
+
   /// Sets text, if hex mode is on. 
   /// The text should be normal ascii text, it is encoded while appending.
+  /// The buffer has no save point afterwards.
   void SetText(const std::string text);
 
-  /// Undo change, sets the buffer to the original buffer.
+  /// Undoes the last change of the buffer, if hex mode is on,
+  /// otherwise checks whether the undo activated hex mode.
   void Undo();
 private:
   void Activate();
+  void Changed(size_t offset, size_t length, bool resized, bool render);
   void Deactivate();
+  const std::string MakeLines(size_t from, size_t to);
+  void Render();
   
   const wxFileOffset m_BytesPerLine, m_EachHexField;
 
   bool m_Active = false;
   int m_Goto = 0;
   
-  std::string m_Buffer, m_BufferOriginal;
+  // Number of bytes rendered.
+  size_t m_Rendered = 0;
+  
+  // The bytes changed, not yet rendered.
+  wxExHexBuffer::wxExHexChange m_Changed;
+  
+  wxExHexBuffer m_Buffer;
   wxExSTC* m_STC;
 };
@@ -7,9 +7,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <wx/dlimpexp.h>
 
 /// Offers methods to start, stop things.
+/// The state is atomic, so worker threads can check for cancel.
 class WXDLLIMPEXP_BASE wxExInterruptable
 {
 public:
@@ -30,6 +32,6 @@ public:
   /// Stops interruptable process.
   static void Stop();
 private:
-  static bool m_Cancelled;
-  static bool m_Running;
+  static std::atomic_bool m_Cancelled;
+  static std::atomic_bool m_Running;
 };
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 #include <wx/extension/property.h>
@@ -68,28 +69,28 @@ public:
   const std::string CommentComplete(const std::string& comment) const;
     
   /// Returns the comment begin.
-  const auto & GetCommentBegin() const {return m_CommentBegin;};
+  const auto & GetCommentBegin() const {return m_Definition->m_CommentBegin;};
 
   /// Returns the comment begin 2.
-  const auto & GetCommentBegin2() const {return m_CommentBegin2;};
+  const auto & GetCommentBegin2() const {return m_Definition->m_CommentBegin2;};
 
   /// Returns the comment end.
-  const auto & GetCommentEnd() const {return m_CommentEnd;};
+  const auto & GetCommentEnd() const {return m_Definition->m_CommentEnd;};
 
   /// Returns the comment end 2.
-  const auto & GetCommentEnd2() const {return m_CommentEnd2;};
+  const auto & GetCommentEnd2() const {return m_Definition->m_CommentEnd2;};
 
   /// Returns the display lexer (as shown in dialog).
-  const auto & GetDisplayLexer() const {return m_DisplayLexer;};
+  const auto & GetDisplayLexer() const {return m_Definition->m_DisplayLexer;};
 
   /// Returns the edge mode.
-  const auto GetEdgeMode() const {return m_EdgeMode;};
+  const auto GetEdgeMode() const {return m_Definition->m_EdgeMode;};
 
   /// Returns the extensions.
-  const auto & GetExtensions() const {return m_Extensions;};
+  const auto & GetExtensions() const {return m_Definition->m_Extensions;};
 
   /// Returns the keywords.
-  const auto & GetKeywords() const {return m_Keywords;};
+  const auto & GetKeywords() const {return m_Definition->m_Keywords;};
 
   /// Returns the keywords as one large string, 
   const std::string GetKeywordsString(
@@ -103,25 +104,29 @@ public:
     const std::string& prefix = std::string()) const;
 
   /// Returns the language.
-  const auto & GetLanguage() const {return m_Language;};
+  const auto & GetLanguage() const {return m_Definition->m_Language;};
   
   /// Returns the line size.
-  const auto GetLineSize() const {return m_LineSize;};
+  const auto GetLineSize() const {return m_Definition->m_LineSize;};
   
   /// Returns the properties.
-  const auto & GetProperties() const {return m_Properties;};
+  const auto & GetProperties() const {return m_Definition->m_Properties;};
   
   /// Returns the scintilla lexer.
-  const auto & GetScintillaLexer() const {return m_ScintillaLexer;};
+  const auto & GetScintillaLexer() const {return m_Definition->m_ScintillaLexer;};
 
   /// Returns the styles.
-  const auto & GetStyles() const {return m_Styles;};
+  const auto & GetStyles() const {return m_Definition->m_Styles;};
+
+  /// Returns the version, that changes each time the lexer 
+  /// (e.g. its keywords) changes.
+  auto GetVersion() const {return m_Definition->m_Version;};
   
   /// Is this word a keyword (allways all keywords), case sensitive.
   bool IsKeyword(const std::string& word) const;
 
   /// Is this lexer valid.
-  bool IsOk() const {return m_IsOk;};
+  bool IsOk() const {return m_Definition->m_IsOk;};
 
   /// Does any keyword (allways all keywords) start with this word,
   /// case insensitive.
@@ -146,7 +151,7 @@ public:
     
   /// Returns true if the stc component 
   /// associated with this lexer can be previewed.
-  bool Previewable() const {return m_Previewable;};
+  bool Previewable() const {return m_Definition->m_Previewable;};
 
   /// Resets lexer and applies it to stc.
   /// The is ok member is set to false.
@@ -175,24 +180,33 @@ private:
     bool fill_out) const;
   void Set(const pugi::xml_node* node);
 
-  // The scintilla name for this lexer cannot be const, 
-  // as in wxExPath the operator= is used on a lexer.
+  // The definition is read from the lexers file, and shared by all
+  // lexers copied from the same lexer, so copying a lexer (as done 
+  // by each wxExPath) is cheap. It is copied only when changed (Edit).
   // Normally the lexer displayed is the scintilla lexer,
   // however this might be different, as with c#.
   // In that case the scintilla lexer is cpp, whereas the display lexer is c#.  
-  std::string 
-    m_CommentBegin, m_CommentBegin2, m_CommentEnd, m_CommentEnd2, 
-    m_DisplayLexer, m_Extensions, m_Language, m_ScintillaLexer;
-
-  // each keyword set in a separate keyword set
-  std::map< int, std::set<std::string> > m_KeywordsSet;
-  std::set<std::string> m_Keywords;
-  std::vector<int> m_EdgeColumns;
-  std::vector<wxExProperty> m_Properties;
-  std::vector<wxExStyle> m_Styles;
+  struct wxExLexerDefinition
+  {
+    std::string 
+      m_CommentBegin, m_CommentBegin2, m_CommentEnd, m_CommentEnd2, 
+      m_DisplayLexer, m_Extensions, m_Language, m_ScintillaLexer;
+
+    // each keyword set in a separate keyword set
+    std::map< int, std::set<std::string> > m_KeywordsSet;
+    std::set<std::string> m_Keywords;
+    std::vector<int> m_EdgeColumns;
+    std::vector<wxExProperty> m_Properties;
+    std::vector<wxExStyle> m_Styles;
   
-  bool m_IsOk {false}, m_Previewable {false};
-  size_t m_LineSize {80};
-  wxExEdgeMode m_EdgeMode {wxExEdgeMode::ABSENT};
+    bool m_IsOk {false}, m_Previewable {false};
+    size_t m_LineSize {80}, m_Version {0};
+    wxExEdgeMode m_EdgeMode {wxExEdgeMode::ABSENT};
+  };
+
+  wxExLexerDefinition& Edit();
+  static const std::shared_ptr<const wxExLexerDefinition>& EmptyDefinition();
+
+  std::shared_ptr<const wxExLexerDefinition> m_Definition {EmptyDefinition()};
   wxExSTC* m_STC {nullptr};
 };
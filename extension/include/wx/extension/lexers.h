@@ -8,9 +8,12 @@
 #pragma once
 
 #include <map>
+#include <regex>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <pugixml.hpp>
+#include <wx/extension/glob.h>
 #include <wx/extension/indicator.h>
 #include <wx/extension/lexer.h>
 #include <wx/extension/marker.h>
@@ -45,6 +48,8 @@ public:
   void ApplyMarginTextStyle(wxExSTC* stc, int line) const;
 
   /// Finds a lexer specified by a filename (fullname).
+  /// Uses the index built by LoadDocument, so for extensions and
+  /// plain filenames no lexers are iterated.
   const wxExLexer FindByFileName(const std::string& fullname) const;
 
   /// Finds a lexer specified by the (display scintilla) name.
@@ -126,6 +131,7 @@ public:
   bool ShowThemeDialog(wxWindow* parent);
 private:
   wxExLexers(const wxExPath& filename);
+  void Index();
   void ParseNodeFolding(const pugi::xml_node& node);
   void ParseNodeGlobal(const pugi::xml_node& node);
   void ParseNodeKeyword(const pugi::xml_node& node);
@@ -144,7 +150,12 @@ private:
   std::vector<wxExProperty> m_GlobalProperties;
   std::vector<wxExLexer> m_Lexers;
   std::vector<wxExStyle> m_Styles, m_StylesHex;
-  std::vector<std::pair<std::string, std::string>> m_Texts;
+  std::vector<std::pair<std::string, std::regex>> m_Texts;
+
+  // Index of lexers (into m_Lexers) on extension, e.g. .cpp for *.cpp, 
+  // on plain filename, and for all other patterns (with wildcards) a list.
+  std::unordered_map<std::string, size_t> m_IndexExtensions, m_IndexFileNames;
+  std::vector<std::pair<size_t, wxExGlob>> m_IndexWildcards;
 
   wxExStyle m_DefaultStyle;
 
@@ -36,7 +36,8 @@ public:
   
   /// Inserts the item at index (if -1 at the end of the listview),
   /// and sets all attributes.
-  void Insert(long index = -1);
+  /// If statusbar, the item count on the statusbar is updated as well.
+  void Insert(long index = -1, bool statusbar = true);
 
   /// Returns true if this item is readonly (on the listview).
   bool IsReadOnly() const {return m_IsReadOnly;};
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      listview-sort.h
+// Purpose:   Declaration of wxExListViewSortKeys class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Offers the sort keys of a wxExListView column.
+/// Each item text is parsed once into a key, 
+/// so sorting only compares keys.
+/// Add keys of one kind only: integers (also used for dates), 
+/// floats or strings.
+class wxExListViewSortKeys
+{
+public:
+  /// Constructor.
+  /// If match_case is false, string keys are case folded when added.
+  explicit wxExListViewSortKeys(bool match_case = true)
+    : m_MatchCase(match_case) {;};
+
+  /// Adds an integer key for the next item.
+  void Add(int64_t key) {m_Ints.emplace_back(key);};
+
+  /// Adds a float key for the next item.
+  void Add(double key) {m_Floats.emplace_back(key);};
+
+  /// Adds a string key for the next item.
+  void Add(const std::string& key);
+
+  /// Returns number of keys.
+  size_t GetSize() const {
+    return m_Ints.size() + m_Floats.size() + m_Strings.size();};
+
+  /// Returns the sorted order, the item that becomes item i is order[i].
+  /// The sort is stable, and large lists are sorted using several threads.
+  const std::vector<long> Sort(bool ascending) const;
+private:
+  template <typename T> 
+  void Sort(std::vector<long>& order, const std::vector<T>& keys, bool ascending) const;
+
+  const bool m_MatchCase;
+
+  std::vector<int64_t> m_Ints;
+  std::vector<double> m_Floats;
+  std::vector<std::string> m_Strings;
+};
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      listview-store.h
+// Purpose:   Declaration of wxExListViewStore class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// Offers a columnar store for the rows of a virtual wxExListView.
+/// Each column keeps one 64 bit cell per row, the meaning of the cell
+/// depends on the column type:
+/// - integers are kept as is,
+/// - strings are interned, so a file name used by many rows is kept once,
+/// - texts are kept in an arena, that only grows until the store is cleared.
+class wxExListViewStore
+{
+public:
+  /// Store types.
+  enum wxExStoreType
+  {
+    STORE_INT,    ///< integer, e.g. a line number
+    STORE_STRING, ///< string that is often repeated, e.g. a file name
+    STORE_TEXT,   ///< text that is mostly unique, e.g. a line of context
+  };
+
+  /// Appends a column.
+  void AddColumn(wxExStoreType type);
+
+  /// Appends a row with all columns empty, returns the row.
+  long AddRow();
+
+  /// Clears all rows.
+  void Clear();
+
+  /// Appends a copy of the specified row, returns the new row.
+  /// Copying a row does not copy its strings or texts.
+  long CopyRow(long row);
+
+  /// Deletes the row.
+  void Delete(long row);
+
+  /// Returns the cell text.
+  const std::string Get(long row, int col) const;
+
+  /// Returns number of columns.
+  auto GetColumns() const {return (int)m_Columns.size();};
+
+  /// Returns data associated with the row.
+  auto GetData(long row) const {return m_Data[row];};
+
+  /// Returns image associated with the row.
+  auto GetImage(long row) const {return m_Images[row];};
+
+  /// Returns number of rows.
+  auto GetRows() const {return (long)m_Data.size();};
+
+  /// Returns the column type.
+  /// An integer column becomes a string column
+  /// if a text is set that is not a canonical integer.
+  auto GetType(int col) const {return m_Columns[col].m_Type;};
+
+  /// Inserts a row with all columns empty before the specified row,
+  /// returns the row.
+  long Insert(long row);
+
+  /// Reorders the rows, the new row i is the old row order[i].
+  /// The order should be a permutation of all rows.
+  void Permute(const std::vector<long>& order);
+
+  /// Sets the cell text.
+  void Set(long row, int col, const std::string& text);
+
+  /// Sets data associated with the row.
+  void SetData(long row, long data) {m_Data[row] = data;};
+
+  /// Sets image associated with the row.
+  void SetImage(long row, int image) {m_Images[row] = image;};
+private:
+  struct wxExStoreColumn
+  {
+    wxExStoreType m_Type;
+    std::vector<uint64_t> m_Cells;
+  };
+
+  uint64_t Intern(const std::string& text);
+  const std::string_view View(uint64_t cell, wxExStoreType type) const;
+
+  std::vector<wxExStoreColumn> m_Columns;
+  std::vector<long> m_Data;
+  std::vector<int> m_Images;
+
+  std::string m_Arena;
+
+  // Interned strings, cell 0 is the empty string.
+  std::deque<std::string> m_Strings {std::string()};
+  std::unordered_map<std::string_view, uint64_t> m_StringIds {{std::string_view(), 0}};
+};
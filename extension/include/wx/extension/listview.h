@@ -8,10 +8,12 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <wx/artprov.h> // for wxArtID
 #include <wx/listctrl.h>
 #include <wx/extension/listview-data.h>
+#include <wx/extension/listview-store.h>
 
 class wxExItemDialog;
 class wxExMenu;
@@ -71,6 +73,9 @@ private:
 /// Allows for sorting on any column.
 /// Adds some standard lists, all these lists
 /// have items associated with files or folders.
+/// If the window style contains wxLC_VIRTUAL (default for LIST_FIND),
+/// items are kept in a wxExListViewStore instead of in the control,
+/// and are only retrieved when shown.
 class WXDLLIMPEXP_BASE wxExListView : public wxListView
 {
 public:
@@ -108,6 +113,9 @@ public:
   /// Returns current sorted column no.
   int GetSortedColumnNo() const {return m_SortedColumnNo;};
 
+  /// Returns the store, or nullptr if this list is not virtual.
+  auto* GetStore() {return m_Store.get();};
+
   /// Inserts item with provided columns.
   /// Returns false if insertings fails, or item is empty.
   bool InsertItem(const std::vector < std::string > & item);
@@ -124,6 +132,14 @@ public:
   /// Implement this one if you have images that might be changed after sorting etc.
   virtual void ItemsUpdate();
 
+  /// Returns true if the item is read only.
+  bool IsItemReadOnly(long item_number) const {
+    return (IsVirtual() ? 
+      m_Store->GetData(item_number): GetItemData(item_number)) > 0;};
+
+  /// Returns true if items are kept in the store.
+  bool IsVirtual() const {return m_Store != nullptr;};
+
   /// Prints the list.
   void Print();
 
@@ -134,11 +150,14 @@ public:
   /// Returns false if an error occurred.
   bool SetItem(long index, int column, const std::string &label, int imageId = -1);
 
+  /// Sets the item read only.
+  void SetItemReadOnly(long item_number, bool readonly);
+
   /// Sets the item image, using the image list.
   /// If the listview does not already contain the image, it is added.
   bool SetItemImage(long item_number, const wxArtID& artid) {
     return (m_Data.Image() == IMAGE_ART ?
-      wxListView::SetItemImage(item_number, GetArtID(artid)): false);};
+      SetImage(item_number, GetArtID(artid)): false);};
 
   /// Sorts on a column specified by column name.
   /// Returns true if column was sorted.
@@ -178,6 +197,7 @@ private:
   wxExColumn Column(const std::string& name) const;
   void CopySelectedItemsToClipboard();
   void EditDelete();
+  const std::string GetCellText(long item_number, int col) const;
     
   /// Returns the index of the bitmap in the image list used by this list view.
   /// If the artid is not yet on the image lists, it is added to the image list.
@@ -186,10 +206,16 @@ private:
 
   void ItemActivated(long item_number);
 
+  virtual wxListItemAttr* OnGetItemAttr(long item_number) const override;
+  virtual int OnGetItemImage(long item_number) const override;
+  virtual wxString OnGetItemText(long item_number, long col) const override;
+
+  bool SetImage(long item_number, int image);
+
   /// Sets the item file icon image.
   bool SetItemImage(long item_number, int iconid) {
     return (m_Data.Image() == IMAGE_FILE_ICON ?
-      wxListView::SetItemImage(item_number, iconid): false);};
+      SetImage(item_number, iconid): false);};
 
   const wxUniChar m_FieldSeparator = '\t';
   const int m_ImageHeight;
@@ -205,6 +231,9 @@ private:
   
   std::map<wxArtID, unsigned int> m_ArtIDs;
   std::vector<wxExColumn> m_Columns;
+  std::unique_ptr<wxExListViewStore> m_Store;
+
+  wxListItemAttr m_ReadOnlyAttr;
   
   static wxExItemDialog* m_ConfigDialog;
 };
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      mapped-file.h
+// Purpose:   Declaration of wxExMappedFile class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/// Offers read only access to the contents of a file without copying.
+/// On unix the file is memory mapped, otherwise (or if mapping fails)
+/// the contents are read into a buffer.
+class wxExMappedFile
+{
+public:
+  /// Constructor, maps the file.
+  wxExMappedFile(const std::string& fullpath = std::string()) {
+    Open(fullpath);};
+
+  /// Destructor, unmaps the file.
+ ~wxExMappedFile() {Close();};
+
+  wxExMappedFile(const wxExMappedFile&) = delete;
+  wxExMappedFile& operator=(const wxExMappedFile&) = delete;
+
+  /// Unmaps the file, the contents are no longer accessible.
+  void Close();
+
+  /// Returns the contents.
+  const std::string_view GetContents() const {
+    return std::string_view(m_Data, m_Size);};
+
+  /// Returns true if the file is mapped (and not read into a buffer).
+  bool IsMapped() const {return m_Mapped;};
+
+  /// Returns true if the file is opened.
+  bool IsOpened() const {return m_Opened;};
+
+  /// Closes current file, and maps specified file.
+  /// Returns false if file could not be opened.
+  bool Open(const std::string& fullpath);
+private:
+  bool Read(const std::string& fullpath);
+
+  const char* m_Data {nullptr};
+  size_t m_Size {0};
+  bool m_Mapped {false}, m_Opened {false};
+  std::string m_Buffer;
+};
@@ -13,12 +13,9 @@
 #include <wx/extension/lexer.h>
 #include <wx/extension/stat.h>
 
-class wxExFile;
-
 /// Offers functionality to handle paths.
 class wxExPath
 {
-  friend class wxExFile; // it might update stat
 public:
   /// Default constructor taking a path.
   /// If path is empty, it saves the current path, and when destructed restores it to current.
@@ -33,6 +30,10 @@ public:
   /// Constructor using a char array.
   wxExPath(const char* path);
 
+  /// Constructor using a path and its stat, e.g. as obtained by wxExDir,
+  /// the stat is used instead of retrieving it again.
+  wxExPath(const std::experimental::filesystem::path& p, const wxExStat& stat);
+
   /// Constructor from a vector of paths.
   wxExPath(const std::vector<std::string> v);
 
@@ -65,13 +66,13 @@ public:
   /// Sets current path.
   static void Current(const std::string& path);
 
-  /// Returns true if the directory with this name exists.
-  bool DirExists() const {
-    return std::experimental::filesystem::is_directory(m_path);};
+  /// Returns true if the directory with this name exists
+  /// (as of the last sync).
+  bool DirExists() const {return GetStat().IsDirectory();};
 
-  /// Returns true if the file with this name exists.
-  bool FileExists() const {
-    return std::experimental::filesystem::is_regular_file(m_path);};
+  /// Returns true if the file with this name exists
+  /// (as of the last sync).
+  bool FileExists() const {return GetStat().IsRegularFile();};
 
   /// Returns path extension component (including the .).
   const std::string GetExtension() const {
@@ -99,13 +100,14 @@ public:
   const std::vector<wxExPath> GetPaths() const;
 
   /// Returns the stat.
-  const auto & GetStat() const {return m_Stat;};
+  /// The stat is retrieved on first use, and kept until the next sync.
+  const wxExStat& GetStat() const;
 
   /// Returns true if this path is absolute.
   bool IsAbsolute() const {return m_path.is_absolute();};
   
   /// Returns true if this path (stat) is readonly.
-  bool IsReadOnly() const {return m_Stat.IsReadOnly();};
+  bool IsReadOnly() const {return GetStat().IsReadOnly();};
 
   /// Returns true if this path is relative.
   bool IsRelative() const {return m_path.is_relative();};
@@ -124,9 +126,13 @@ public:
     
   /// Replaces filename.
   wxExPath& ReplaceFileName(const std::string& filename);
+
+  /// Syncs the stat from disk, returns true if the stat is okay.
+  bool Sync();
 private:
   std::experimental::filesystem::path m_path;
   std::string m_path_original;
   wxExLexer m_Lexer;
-  wxExStat m_Stat;
+  mutable wxExStat m_Stat;
+  mutable bool m_StatSynced {false};
 };
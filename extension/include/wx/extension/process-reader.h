@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      process-reader.h
+// Purpose:   Declaration of class wxExProcessReader
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class wxInputStream;
+struct wxExProcessReaderState;
+
+/// Offers reading the output streams of a process.
+/// Each stream is read in large blocks on its own thread,
+/// blocks are split on lines, and collected until you get them,
+/// so output arrives as soon as the process writes it,
+/// and all output collected is handled at once.
+class wxExProcessReader
+{
+public:
+  /// Constructor, starts reading the streams,
+  /// the reader takes ownership of them.
+  wxExProcessReader(
+    /// streams to read, e.g. stdout and stderr
+    const std::vector<wxInputStream*>& streams,
+    /// invoked on a reading thread when output becomes
+    /// available while nothing was collected yet
+    std::function<void()> notify = nullptr);
+
+  /// Destructor, notify is no longer invoked,
+  /// threads still reading end as the streams end.
+ ~wxExProcessReader();
+
+  /// Returns output collected, and clears it.
+  const std::string Get();
+
+  /// Returns true if all streams ended, and
+  /// all output was returned by Get.
+  bool IsEnded() const;
+
+  /// Waits until output is collected, at most specified time.
+  /// Returns true if output is available.
+  bool Wait(std::chrono::milliseconds ms);
+private:
+  std::shared_ptr<wxExProcessReaderState> m_State;
+};
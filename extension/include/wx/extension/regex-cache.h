@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      regex-cache.h
+// Purpose:   Declaration of wxExRegexCache class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <regex>
+#include <string>
+
+/// Offers a cache of compiled regular expressions, so a pattern 
+/// used many times (e.g. for each line of process output) is compiled once.
+/// The cache is shared by all threads, and bounded, 
+/// the least recently used regex is removed when it is full.
+class wxExRegexCache
+{
+public:
+  /// Returns the compiled regex for the pattern and flags,
+  /// from the cache, or compiles and adds it if not present.
+  /// Throws std::regex_error if the pattern is invalid.
+  static std::shared_ptr<const std::regex> Get(
+    const std::string& regex, 
+    std::regex::flag_type flags = std::regex::ECMAScript);
+
+  /// Returns number of times a regex was found in the cache.
+  static size_t GetHits();
+  
+  /// Returns max number of regex kept in the cache.
+  static constexpr size_t GetMaxSize() {return 128;};
+
+  /// Returns number of times a regex was compiled.
+  static size_t GetMisses();
+
+  /// Returns number of regex currently in the cache.
+  static size_t GetSize();
+  
+  /// Clears the cache and the counters.
+  static void Reset();
+};
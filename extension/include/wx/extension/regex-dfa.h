@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      regex-dfa.h
+// Purpose:   Declaration of wxExRegExDFA class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <wx/extension/frd.h>
+
+/// Offers a regular expression engine using deterministic finite 
+/// automata, that are completely built in the constructor, so matching
+/// is done without recursion or backtracking, and the engine can be used 
+/// by several threads at once.
+/// A forward automaton finds the end of a match in one pass over the text,
+/// a reverse automaton finds its start going back from the end.
+/// Supported are: literals, escapes, ., character classes, groups,
+/// alternation, the quantifiers *, +, ?, {n,m}, and ^ and $ anchors.
+/// Matches are leftmost-first, the same as ECMAScript std::regex.
+/// Replacing supports $&, $`, $' and $$. A replacement referring to
+/// a submatch is done by the std::regex engine.
+class wxExRegExDFA : public wxExRegExEngine
+{
+public:
+  /// Constructor, builds the automaton.
+  /// Throws std::regex_error if the regular expression is invalid,
+  /// uses an unsupported construct (backreferences, lookahead, lazy
+  /// quantifiers, word boundaries), can match an empty string, 
+  /// repeats something that can match an empty string,
+  /// or results in too many states.
+  wxExRegExDFA(const std::string& regex, bool match_case = true);
+
+  /// Returns position and length of leftmost-first match in text
+  /// starting at pos, or std::string::npos as position if not found.
+  std::pair<size_t, size_t> Find(
+    const std::string_view& text, size_t pos = 0) const;
+
+  /// Returns number of states of the forward automaton.
+  size_t GetStates() const {return m_Accept.size();};
+
+  // Overridden methods.
+
+  int Matches(const std::string_view& text) const override;
+  int ReplaceAll(std::string& text, const std::string& replace) const override;
+private:
+  const std::string m_Pattern;
+  const bool m_MatchCase;
+
+  std::vector<unsigned char> m_Classes;
+  std::vector<int> m_Next, m_ReverseNext;
+  std::vector<bool> 
+    m_Accept, m_AcceptEnd, m_ReverseAccept, m_ReverseAcceptBegin;
+  
+  size_t m_NoClasses {0};
+  int m_Dead, m_Search, m_SearchBegin;
+  int m_ReverseDead, m_ReverseEnd, m_ReverseMid;
+
+  // The std::regex engine, created when first used for a replacement.
+  mutable std::once_flag m_RegExCreated;
+  mutable std::unique_ptr<wxExRegExEngine> m_RegEx;
+};
@@ -7,12 +7,20 @@
 
 #pragma once
 
+#include <memory>
+#include <thread>
+#include <vector>
 #include <wx/extension/dir.h>
 #include <wx/extension/stream-statistics.h>
 #include <wx/extension/tool.h>
 
+class wxExDirToolQueue;
+
 /// Offers a wxExDir with tool support.
 /// RunTool is FindFiles invoked on all matching files.
+/// For find and replace the tool runs on a number of worker threads,
+/// fed by the directory enumeration. The matches are pushed to the
+/// result sink, that is drained in batches from the main thread.
 class WXDLLIMPEXP_BASE wxExDirTool : public wxExDir
 {
 public:
@@ -22,14 +30,27 @@ public:
     const wxExPath& fullpath,
     const std::string& filespec = std::string(),
     int flags = DIR_DEFAULT);
+
+  /// Destructor.
+ ~wxExDirTool();
     
   /// Returns the statistics.
   auto & GetStatistics() {return m_Statistics;};
 protected:  
+  virtual void FindFilesBegin() override;
+  virtual void FindFilesEnd() override;
   virtual bool OnFile(const wxExPath& file) override;
 private:    
+  void Drain(bool all = false);
+  void RunWorker(wxExStreamStatistics& stats);
+
   wxExStreamStatistics m_Statistics;
   const wxExTool m_Tool;
+  const int m_Threads;
+
+  std::unique_ptr<wxExDirToolQueue> m_Queue;
+  std::vector<wxExStreamStatistics> m_WorkerStatistics;
+  std::vector<std::thread> m_Workers;
 };
 
 class wxExListView;
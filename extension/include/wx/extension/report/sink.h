@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      sink.h
+// Purpose:   Declaration of class 'wxExResultSink'
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <wx/event.h>
+#include <wx/timer.h>
+#include <wx/extension/path.h>
+
+class wxExListView;
+
+/// Offers a sink for find results that are reported to a listview.
+/// Producers push the matches of a file on a lock-free queue,
+/// this can be done from any thread.
+/// The main thread drains the queue in timed batches, each batch is
+/// reported within one Freeze and Thaw, and updates the statusbar once.
+class WXDLLIMPEXP_BASE wxExResultSink : public wxEvtHandler
+{
+public:
+  /// Matches of a file, the line number and the line (context).
+  typedef std::vector<std::pair<size_t, std::string>> wxExResultLines;
+
+  /// Constructor, should be invoked from the main thread.
+  wxExResultSink(wxExListView* listview);
+
+  /// Destructor, deletes results not yet reported.
+ ~wxExResultSink();
+
+  /// Reports pushed results to the listview,
+  /// should be invoked from the main thread.
+  /// If all is false, nothing is reported if the previous batch ended
+  /// within the batch interval, and the batch ends at the first file
+  /// after the batch interval has passed, the other results remain
+  /// for the next batch.
+  /// Returns the number of matches reported.
+  size_t Drain(bool all = false);
+
+  /// Returns the listview.
+  auto* GetListView() const {return m_ListView;};
+
+  /// Returns true if no results are waiting to be reported.
+  bool IsEmpty() const {
+    return m_Pending.empty() && m_Head.load() == nullptr;};
+
+  /// Pushes the matches of a file.
+  /// If the queue was empty, a batch is scheduled on the main thread.
+  void Push(
+    /// the file
+    const wxExPath& path,
+    /// the text that was searched for
+    const std::string& match,
+    /// the matches
+    wxExResultLines&& lines);
+private:
+  struct wxExResultNode
+  {
+    wxExPath m_Path;
+    std::string m_Match;
+    wxExResultLines m_Lines;
+    wxExResultNode* m_Next;
+  };
+
+  size_t Report(const wxExResultNode& node);
+
+  std::atomic<wxExResultNode*> m_Head {nullptr};
+  std::deque<std::unique_ptr<wxExResultNode>> m_Pending;
+  std::chrono::steady_clock::time_point m_LastBatch;
+  std::unique_ptr<wxTimer> m_Timer;
+
+  wxExListView* m_ListView;
+};
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <wx/extension/stream.h>
+#include <wx/extension/report/sink.h>
 
 class wxExFrameWithHistory;
 class wxExListView;
@@ -21,6 +22,15 @@ public:
     const wxExPath& filename,
     const wxExTool& tool);
 
+  /// Leaves reporting the matches to the result sink, that reports
+  /// them in batches, instead of at the end of RunTool.
+  /// This allows RunTool to be invoked from a worker thread.
+  void DeferMatches() {m_DeferMatches = true;};
+
+  /// Returns the result sink for the listview set up by SetupTool,
+  /// or nullptr if there is none.
+  static wxExResultSink* GetSink() {return m_Sink;};
+
   /// Sets up the tool.
   static bool SetupTool(
     /// tool to use
@@ -80,11 +90,15 @@ private:
   
   static wxExListView* m_Report;
   static wxExFrameWithHistory* m_Frame;
+  static wxExResultSink* m_Sink;
 
+  bool m_DeferMatches = false;
   bool m_IsCommentStatement = false;
   bool m_IsString = false;
 
-  int m_ContextSize;
+  const int m_ContextSize;
+  
+  wxExResultSink::wxExResultLines m_Matches;
   
   wxExSyntaxType m_LastSyntaxType = SYNTAX_NONE;
   wxExSyntaxType m_SyntaxType = SYNTAX_NONE;
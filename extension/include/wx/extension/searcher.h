@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      searcher.h
+// Purpose:   Declaration of wxExSearcher class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/// Offers a literal (not a regular expression) search for a string,
+/// optionally ignoring case (ascii only). 
+/// Candidates are found by comparing the first and last character 
+/// of the find string against a whole block of text at once, 
+/// using SSE2 or AVX2 instructions if available, and then verified.
+class wxExSearcher
+{
+public:
+  /// The kernels that can be used.
+  enum wxExSearcherKernel
+  {
+    KERNEL_DEFAULT, ///< best kernel supported
+    KERNEL_SCALAR,  ///< no SIMD instructions
+    KERNEL_SSE2,    ///< SSE2 instructions, 16 bytes at once
+    KERNEL_AVX2,    ///< AVX2 instructions, 32 bytes at once
+  };
+
+  /// Default constructor.
+  /// If the kernel is not supported, the scalar kernel is used.
+  wxExSearcher(
+    /// string to find
+    const std::string& find = std::string(),
+    /// match case
+    bool match_case = true,
+    /// kernel to use
+    wxExSearcherKernel kernel = KERNEL_DEFAULT);
+
+  /// Returns position of first occurrence of the find string in text,
+  /// starting at pos, or std::string::npos if not found.
+  /// An empty find string is never found.
+  size_t Find(const std::string_view& text, size_t pos = 0) const;
+
+  /// Returns the find string.
+  const auto & GetFindString() const {return m_Find;};
+
+  /// Returns the kernel used.
+  auto GetKernel() const {return m_Kernel;};
+
+  /// Returns true if specified kernel is supported on this machine.
+  static bool IsSupported(wxExSearcherKernel kernel);
+
+  /// Returns true if case is matched.
+  bool MatchCase() const {return m_MatchCase;};
+private:
+  bool Equal(const char* text) const;
+  size_t FindAVX2(const char* text, size_t size) const;
+  size_t FindScalar(const char* text, size_t size) const;
+  size_t FindSSE2(const char* text, size_t size) const;
+
+  std::string m_Find, m_FindUpper;
+  bool m_MatchCase;
+  wxExSearcherKernel m_Kernel;
+  
+  // First and last character of find string (lower and upper case).
+  char m_First[2], m_Last[2];
+};
@@ -9,6 +9,7 @@
 
 #include <list>
 #include <vector>
+#include <wx/extension/statistics.h>
 #include <wx/extension/stc.h>
 
 class wxExProcess;
@@ -25,6 +26,8 @@ class wxExProcess;
 /// - If you enter !\<abbreviation\> the last command starting with 
 ///   \<abbreviation\> is entered.
 /// - Tab expansion is available for text entered matching existing files.
+/// The number of lines kept can be bounded, then the oldest lines are
+/// removed while output is appended.
 class WXDLLIMPEXP_BASE wxExShell: public wxExSTC
 {
 public:
@@ -53,6 +56,11 @@ public:
   /// repositioned at the end after appending the text, 
   virtual void AppendText(const wxString& text) override;
  
+  /// Appends output, e.g. from a process.
+  /// The output is collected, and appended at once when the
+  /// event loop is run again, or when other text is appended.
+  void AppendOutput(const std::string& text);
+  
   /// Enable/disable shell processing.
   /// Default (and after constructed) shell processing is enabled.
   /// When disabled, shell is a normal STC.
@@ -65,12 +73,19 @@ public:
   /// separated by a newline (for testing).
   const std::string GetHistory() const;
 
+  /// Returns the maximum number of lines kept, 0 if all lines are kept.
+  auto GetMaxLines() const {return m_MaxLines;};
+
   /// Returns the prompt.
   const auto& GetPrompt() const {return m_Prompt;};
 
   /// Returns whether shell processing is enabled.
   bool GetShellEnabled() const {return m_Enabled;};
   
+  /// Returns statistics of the output appended, and the output
+  /// dropped to keep the maximum number of lines.
+  const auto& GetStatistics() const {return m_Statistics;};
+  
   // Paste the contents of the clipboard into the document replacing the selection.
   virtual void Paste() override;
   
@@ -86,6 +101,11 @@ public:
     const std::string& text = std::string(),
     bool add_eol = true);
   
+  /// Sets the maximum number of lines kept, 0 keeps all lines.
+  /// The last line, not yet ended by an eol, is not counted.
+  /// Default the number is taken from the config.
+  void SetMaxLines(int lines) {m_MaxLines = lines;};
+
   /// Sets the process to which commands are sent.
   /// If you do not set this, commands are sent to the parent.
   void SetProcess(wxExProcess* process);
@@ -98,6 +118,7 @@ public:
   virtual void Undo() override;
 private:
   void Expand();
+  void Flush();
   void KeepCommand();
   void ProcessCharDefault(int key);
   /// Set command for command specified as number or as start of command,
@@ -118,9 +139,13 @@ private:
   std::vector < std::string > m_AutoCompleteList;
 
   std::string m_Command;
+  std::string m_Output;
   std::string m_Prompt;
   int m_CommandStartPosition = 0; /// position after the prompt from where commands can be inserted
+  int m_MaxLines;
   bool m_Enabled = true;
   
+  wxExStatistics<long long> m_Statistics;
+  
   wxExProcess* m_Process = nullptr;
 };
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <sys/stat.h> // for stat
 
@@ -23,12 +24,19 @@ public:
   /// Returns the modification time.
   const std::string GetModificationTime() const;
 
+  /// Returns true if the stat is okay and is a directory.
+  bool IsDirectory() const;
+
   /// Returns true if the stat is okay (last sync was okay).
   bool IsOk() const {return m_IsOk;};
 
   /// Returns true if this stat is readonly.
+  /// The result is kept until the next sync.
   bool IsReadOnly() const;
 
+  /// Returns true if the stat is okay and is a regular file.
+  bool IsRegularFile() const;
+
   /// Sets (syncs) this stat, returns result and keeps it in IsOk.
   bool Sync();
 
@@ -39,4 +47,5 @@ public:
 private:
   std::string m_FullPath;
   bool m_IsOk;
+  mutable std::optional<bool> m_IsReadOnly;
 };
@@ -60,6 +60,10 @@ public:
   /// Paste text from clipboard.
   virtual void Paste() override;
 
+  /// If there is a redo facility and the last operation can be redone, 
+  /// redoes the last operation. 
+  virtual void Redo() override;
+
   /// Deselects selected text in the control.
   // Reimplemented, since scintilla version sets empty sel at 0, and sets caret on pos 0.
   virtual void SelectNone() override;
@@ -176,6 +180,10 @@ public:
   /// If selected text is a link, opens the link.
   bool LinkOpen();
 
+  /// Adds a change marker to the line.
+  /// Returns false if marker change is not loaded.
+  bool MarkerAddChange(int line);
+  
   /// Deletes all change markers.
   /// Returns false if marker change is not loaded.
   bool MarkerDeleteAllChange();
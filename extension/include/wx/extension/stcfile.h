@@ -27,6 +27,7 @@ public:
   virtual bool GetContentsChanged() const override;
   virtual void ResetContentsChanged() override;
 protected:
+  virtual bool CanSaveInPlace() const override;
   virtual bool DoFileLoad(bool synced = false) override;
   virtual void DoFileNew() override;
   virtual void DoFileSave(bool save_as = false) override;
@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <string_view>
 #include <wx/extension/path.h>
+#include <wx/extension/searcher.h>
 #include <wx/extension/stream-statistics.h>
 #include <wx/extension/tool.h>
 
@@ -35,6 +37,9 @@ public:
   const auto & GetTool() const {return m_Tool;};
   
   /// Runs the tool.
+  /// The file is scanned from a memory mapped buffer, for find
+  /// lines are only copied if they are reported to ProcessMatch,
+  /// for replace the result is written back in one write.
   bool RunTool();
 
   /// Resets static members.
@@ -73,6 +78,9 @@ protected:
   auto IncStatistics(const std::string& keyword) {return
     m_Stats.m_Elements.Inc(keyword);};
 private:
+  bool FindInLine(const std::string_view& line, size_t line_no);
+  bool FindInText(const std::string_view& text);
+  bool HandleMatch(const std::string_view& line, size_t line_no, int pos, int count);
   bool IsWordCharacter(int c) const {return isalnum(c) || c == '_';};
 
   const wxExPath m_Path;
@@ -87,7 +95,7 @@ private:
   
   wxExFindReplaceData* m_FRD;
 
-  std::string m_FindString;
+  wxExSearcher m_Searcher;
 
   static bool m_Asked;
 };
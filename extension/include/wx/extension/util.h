@@ -8,6 +8,7 @@
 #pragma once
 
 #include <list>
+#include <regex>
 #include <vector>
 #include <wx/combobox.h>
 #include <wx/filedlg.h> // for wxFD_OPEN etc.
@@ -235,6 +236,7 @@ long wxExMake(
 bool wxExMarkerAndRegisterExpansion(wxExEx* ex, std::string& command);
 
 /// Regular expression match.
+/// The regular expression is compiled once, and kept in wxExRegexCache.
 /// Returns:
 /// - -1 if text does not match or there is an error
 /// - 0 if text matches, but no submatches present, v is untouched
@@ -247,6 +249,16 @@ int wxExMatch(
   /// vector is filled with submatches
   std::vector<std::string>& v);
 
+/// Regular expression match, using an already compiled regex.
+/// Returns same values as above.
+int wxExMatch(
+  /// regular expression
+  const std::regex& regex,
+  /// text to match
+  const std::string& text, 
+  /// vector is filled with submatches
+  std::vector<std::string>& v);
+
 /// Returns true if filename (fullname) matches one of the
 /// fields in specified pattern (fields separated by ; sign).
 bool wxExMatchesOneOf(const std::string& fullname, const std::string& patterns);
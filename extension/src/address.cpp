@@ -5,6 +5,7 @@
 // Copyright: (c) 2018 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <limits>
 #include <memory>
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
@@ -126,7 +127,16 @@ int wxExAddress::GetLine() const
     m_Ex->GetSTC()->SetTargetStart(m_Ex->GetSTC()->GetCurrentPos());
     m_Ex->GetSTC()->SetTargetEnd(m_Ex->GetSTC()->GetTextLength());
     
-    if (m_Ex->GetSTC()->SearchInTarget(v[0]) != -1)
+    bool found = (m_Ex->GetSTC()->SearchInTarget(v[0]) != -1);
+
+    // In hex mode the match might be in lines not yet rendered.
+    while (!found && m_Ex->GetSTC()->GetHexMode().RenderFind(v[0]))
+    {
+      m_Ex->GetSTC()->SetTargetEnd(m_Ex->GetSTC()->GetTextLength());
+      found = (m_Ex->GetSTC()->SearchInTarget(v[0]) != -1);
+    }
+
+    if (found)
     {
       return m_Ex->GetSTC()->LineFromPosition(m_Ex->GetSTC()->GetTargetStart()) + 1;
     }
@@ -152,6 +162,8 @@ int wxExAddress::GetLine() const
       return m_Ex->GetSTC()->LineFromPosition(m_Ex->GetSTC()->GetTargetStart()) + 1;
     }
     
+    // In hex mode the last match might be in lines not yet rendered.
+    m_Ex->GetSTC()->GetHexMode().RenderFind(v[0], false);
     m_Ex->GetSTC()->SetTargetStart(m_Ex->GetSTC()->GetTextLength());
     m_Ex->GetSTC()->SetTargetEnd(m_Ex->GetSTC()->GetCurrentPos());
     
@@ -172,13 +184,14 @@ int wxExAddress::GetLine() const
   {
     return 1;
   }
-  else if (sum > m_Ex->GetSTC()->GetLineCount())
+  else 
   {
-    return m_Ex->GetSTC()->GetLineCount();
-  }  
-  else
-  {
-    return sum;
+    // In hex mode the line might not be rendered yet.
+    m_Ex->GetSTC()->GetHexMode().RenderLines(
+      std::min<double>(sum, std::numeric_limits<int>::max()) - 1);
+
+    return sum > m_Ex->GetSTC()->GetLineCount() ? 
+      m_Ex->GetSTC()->GetLineCount(): (int)sum;
   }
 }
 
@@ -273,6 +286,8 @@ bool wxExAddress::Read(const std::string& arg) const
   
 void wxExAddress::SetLine(int line)
 {
+  m_Ex->GetSTC()->GetHexMode().RenderLines(line - 1);
+
   if (line > m_Ex->GetSTC()->GetLineCount())
   {
     m_Line = m_Ex->GetSTC()->GetLineCount();
@@ -5,6 +5,8 @@
 // Copyright: (c) 2018 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <vector>
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
@@ -14,59 +16,101 @@
 #include <wx/extension/frd.h>
 #include <wx/extension/managedframe.h>
 #include <wx/extension/process.h>
+#include <wx/extension/regex-cache.h>
 #include <wx/extension/stc.h>
 #include <wx/extension/tokenizer.h>
 #include <wx/extension/util.h>
 #include <wx/extension/vi-macros.h>
 
+// The global command list, parsed once, and executed 
+// on the lines matching (or not matching) the global pattern.
 class GlobalEnv
 {
 public:
   GlobalEnv(wxExEx* ex, 
-    const wxExIndicator& indicator, const std::string& commands)
-  : m_Ex(ex)
-  , m_FindIndicator(indicator) {
-    m_Ex->GetSTC()->SetSearchFlags(m_Ex->GetSearchFlags());
-    m_Ex->GetSTC()->BeginUndoAction();
+    const wxExIndicator& indicator, 
+    const std::string& pattern,
+    const std::string& commands)
+  : m_FindIndicator(indicator)
+  , m_Ex(ex)
+  , m_STC(ex->GetSTC()) {
+    m_STC->SetSearchFlags(m_Ex->GetSearchFlags());
+    m_STC->BeginUndoAction();
     
     for (wxExTokenizer tkz(commands, "|"); tkz.HasMoreTokens(); )
     {
       // Prevent recursive global.
       if (const auto cmd(tkz.GetNextToken()); cmd[0] != 'g' && cmd[0] != 'v')
       {
-        if (cmd[0] == 'd' || cmd[0] == 'm')
-        {
-          m_Changes++;
-        }
-        
-        m_Commands.emplace_back(cmd);
+        m_Commands.push_back({cmd[0], cmd.substr(1), cmd});
       }
-    }}
+    }
+
+    // A substitute using the global pattern only changes the lines
+    // matching, so it is done once on all these lines.
+    m_SamePattern = (m_Commands.size() == 1 && 
+      m_Commands.front().m_Text.find("s/" + pattern + "/") == 0);}
   
  ~GlobalEnv()
   {
-    m_Ex->GetSTC()->EndUndoAction();
-    m_Ex->MarkerDelete('%');
+    m_STC->MarkerDeleteAll(wxExEx::MARKER_GLOBAL);
+    m_STC->EndUndoAction();
   }
   
-  auto Changes() const {return m_Changes;};
-  
   bool Commands() const {return !m_Commands.empty();};
   
-  bool ForEach(int line) const
+  // Runs the commands on the lines, these should be sorted.
+  bool Run(const std::vector<int>& lines, bool inverse) const
   {
-    if (!Commands())
+    if (lines.empty()) return true;
+
+    // A single command on all lines is done at once if possible.
+    if (m_Commands.size() == 1)
     {
-      m_Ex->GetSTC()->SetIndicator(m_FindIndicator, 
-        m_Ex->GetSTC()->GetTargetStart(), m_Ex->GetSTC()->GetTargetEnd());
+      switch (const auto& cmd(m_Commands.front()); cmd.m_Command)
+      {
+        case 'd': 
+          if (cmd.m_Rest.empty() && 
+            !HasMarkers(lines.front(), lines.back())) return Delete(lines); 
+          break;
+        case 'm': 
+          if ((cmd.m_Rest == "$" || cmd.m_Rest == "0") && 
+            !HasMarkers(cmd.m_Rest == "0" ? 0: lines.front(), 
+              cmd.m_Rest == "0" ? lines.back(): m_STC->GetLineCount() - 1)) 
+            return Move(lines, cmd.m_Rest == "0"); 
+          break;
+        case 'p': 
+          if (cmd.m_Rest.empty() || cmd.m_Rest == "#") 
+            return Print(lines, cmd.m_Rest); 
+          break;
+        case 's': 
+          if (!inverse && m_SamePattern) 
+            return wxExAddressRange(m_Ex, 
+              std::to_string(lines.front() + 1) + "," + 
+              std::to_string(lines.back() + 1)).Substitute(cmd.m_Rest, 's'); 
+          break;
+        case 'y': 
+          if (cmd.m_Rest.size() <= 1) 
+            return Yank(lines, cmd.m_Rest.empty() ? '0': cmd.m_Rest[0]); 
+          break;
+      }
     }
-    else
+
+    // Mark the lines, so lines inserted or deleted by a command 
+    // keep the lines still to be processed.
+    for (const auto line : lines)
+    {
+      m_STC->MarkerAdd(line, wxExEx::MARKER_GLOBAL);
+    }
+
+    for (int line = 0; 
+      (line = m_STC->MarkerNext(line, 1 << wxExEx::MARKER_GLOBAL)) != -1; )
     {
       for (const auto& it : m_Commands)
       {
-        if (!m_Ex->Command(":" + std::to_string(line + 1) + it))
+        if (!Execute(it, line))
         {
-          m_Ex->GetFrame()->ShowExMessage(m_Ex->GetCommand().Command() + " failed");
+          m_Ex->GetFrame()->ShowExMessage(it.m_Text + " failed");
           return false;
         }
       }
@@ -74,49 +118,250 @@ public:
     
     return true;
   }
+private:
+  struct GlobalCommand
+  {
+    char m_Command;
+    std::string m_Rest, m_Text;
+  };
 
-  bool ForEach(int start, int& end, int& hits) const
+  // Deletes the lines, by replacing the text from first to last
+  // line by the lines kept.
+  bool Delete(const std::vector<int>& lines) const
   {
-    if (start < end)
+    if (m_STC->GetReadOnly() || m_STC->HexMode()) return false;
+
+    std::string kept;
+    const auto start = m_STC->PositionFromLine(lines.front());
+    const auto text(Text(lines.front(), lines.back() + 1));
+
+    for (int line = lines.front(), i = 0; line <= lines.back(); line++)
     {
-      for (int i = start;  i < end && i < m_Ex->GetSTC()->GetLineCount() - 1; )
+      if (line == lines[i])
       {
-        if (Commands())
-        {
-          if (!ForEach(i)) return false;
-        }
-        else
-        {
-          m_Ex->GetSTC()->SetIndicator(
-            m_FindIndicator, 
-            m_Ex->GetSTC()->PositionFromLine(i), 
-            m_Ex->GetSTC()->GetLineEndPosition(i));
-        }
-        
-        if (m_Changes == 0) 
+        i++;
+      }
+      else
+      {
+        kept.append(text, m_STC->PositionFromLine(line) - start, m_STC->LineLength(line));
+      }
+    }
+
+    // As each line was deleted, the registers contain the last line.
+    const auto last(m_STC->GetLine(lines.back()).ToStdString());
+    m_Ex->SetRegisterYank(last);
+    m_Ex->SetRegistersDelete(last);
+
+    Replace(start, start + text.size(), kept);
+
+    return true;
+  }
+
+  bool Execute(const GlobalCommand& cmd, int line) const
+  {
+    Unmark(cmd, line);
+
+    wxExAddressRange range(m_Ex, std::to_string(line + 1));
+
+    // Commands without address are executed on the range directly,
+    // others are passed to ex.
+    switch (cmd.m_Command)
+    {
+      case 'c': return range.Change(cmd.m_Rest);
+      case 'd': return range.Delete();
+      case 'j': return range.Join();
+      case 'm': return range.Move(wxExAddress(m_Ex, cmd.m_Rest));
+      case 's':
+      case '&':
+      case '~': return range.Substitute(cmd.m_Rest, cmd.m_Command);
+      case 't': return range.Copy(wxExAddress(m_Ex, cmd.m_Rest));
+      case 'y': return range.Yank(cmd.m_Rest.empty() ? '0': cmd.m_Rest[0]);
+      case '>': return range.Indent(true);
+      case '<': return range.Indent(false);
+      default: 
+        if (IsAddress(cmd.m_Command))
         {
-          i++;
+          // The command has its own address, relative to the line.
+          m_STC->GotoLine(line);
+          return m_Ex->Command(":" + cmd.m_Text);
         }
-        else 
+        return m_Ex->Command(":" + std::to_string(line + 1) + cmd.m_Text);
+    }
+  }
+  
+  // Returns true if other markers (bookmarks, change markers or vi marks)
+  // are present on lines from first up to and including last,
+  // these are lost if the text is replaced at once.
+  bool HasMarkers(int first, int last) const
+  {
+    const auto line = m_STC->MarkerNext(first, ~(1 << wxExEx::MARKER_GLOBAL));
+    return line != -1 && line <= last;
+  }
+  
+  static bool IsAddress(char c) {
+    return isdigit(c) || c == '.' || c == '$' || c == '+' || c == '-';};
+  
+  // Moves the lines to the end, or to the begin (reversing them),
+  // by replacing the text from first line to the end,
+  // or from the begin to the last line.
+  bool Move(const std::vector<int>& lines, bool begin) const
+  {
+    if (m_STC->GetReadOnly() || m_STC->HexMode()) return false;
+
+    const auto first = (begin ? 0: lines.front());
+    const auto last = (begin ? lines.back(): m_STC->GetLineCount() - 1);
+    const auto start = m_STC->PositionFromLine(first);
+    const auto text(Text(first, last + 1));
+    
+    std::vector<std::string> moved;
+    std::string kept;
+    bool eol = true;
+
+    for (int line = first, i = 0; line <= last; line++)
+    {
+      auto l(text.substr(m_STC->PositionFromLine(line) - start, m_STC->LineLength(line)));
+
+      if (l.empty() && line == m_STC->GetLineCount() - 1) break;
+      
+      if (m_STC->GetLineEndPosition(line) == m_STC->PositionFromLine(line) + m_STC->LineLength(line))
+      {
+        // The last line without eol, add it, and remove it afterwards.
+        l += m_STC->GetEOL();
+        eol = false;
+      }
+
+      if (i < (int)lines.size() && line == lines[i])
+      {
+        i++;
+        moved.emplace_back(l);
+      }
+      else
+      {
+        kept += l;
+      }
+    }
+
+    if (begin)
+    {
+      std::reverse(moved.begin(), moved.end());
+    }
+
+    std::string all;
+    all.reserve(text.size() + 2);
+    
+    if (!begin) all += kept;
+    for (const auto& it : moved) all += it;
+    if (begin) all += kept;
+    
+    if (!eol)
+    {
+      all.erase(all.size() - m_STC->GetEOL().size());
+    }
+    
+    Replace(start, start + text.size(), all);
+
+    return true;
+  }
+
+  // Prints the lines at once.
+  bool Print(const std::vector<int>& lines, const std::string& flags) const
+  {
+    std::string text;
+    
+    for (const auto line : lines)
+    {
+      char buffer[16];
+      snprintf(buffer, sizeof(buffer), "%6d ", line + 1);
+    
+      text += (!flags.empty() ? buffer: std::string()) + m_STC->GetLine(line);
+    }
+    
+    m_Ex->GetFrame()->PrintEx(m_Ex, text);
+    
+    return true;
+  }
+
+  void Replace(int start, int end, const std::string& text) const
+  {
+    m_STC->SetTargetStart(start);
+    m_STC->SetTargetEnd(end);
+    m_STC->ReplaceTargetRaw(text.data(), text.size());
+  }
+
+  // Removes the global marker from the lines the command works on,
+  // as the marker of a deleted line is merged into the line kept,
+  // which would then be processed as well.
+  void Unmark(const GlobalCommand& cmd, int line) const
+  {
+    int begin = line, end = line;
+    
+    if (cmd.m_Command == 'j')
+    {
+      end = line + 1;
+    }
+    else if (std::vector<std::string> v; IsAddress(cmd.m_Command) &&
+      wxExMatch("^([0-9\\.\\$\\+\\-]+)(,([0-9\\.\\$\\+\\-]+))?", 
+        cmd.m_Text, v) == 3)
+    {
+      m_STC->GotoLine(line);
+      
+      if (const auto b = wxExAddress(m_Ex, v[0]).GetLine(); b > 0)
+      {
+        begin = end = b - 1;
+      }
+      
+      if (!v[2].empty())
+      {
+        if (const auto e = wxExAddress(m_Ex, v[2]).GetLine(); e > 0)
         {
-          end -= m_Changes;
+          end = e - 1;
         }
-        
-        hits++;
       }
+      
+      if (begin > end) std::swap(begin, end);
     }
-    else
+    
+    for (int i = begin; i <= end && i < m_STC->GetLineCount(); i++)
     {
-      end++;
+      m_STC->MarkerDelete(i, wxExEx::MARKER_GLOBAL);
     }
+  }
+
+  // Returns the raw text of lines from first up to last.
+  const std::string Text(int first, int last) const
+  {
+    const auto start = m_STC->PositionFromLine(first);
+    const auto end = (last < m_STC->GetLineCount() ? 
+      m_STC->PositionFromLine(last): m_STC->GetTextLength());
+    const auto buffer(m_STC->GetTextRangeRaw(start, end));
+
+    return std::string(buffer.data(), buffer.length());
+  }
+
+  // Yanks the lines, as each line was yanked, a register 
+  // contains the last line, an append register all lines.
+  bool Yank(const std::vector<int>& lines, char name) const
+  {
+    if (!isupper(name))
+    {
+      return wxExAddressRange(m_Ex, std::to_string(lines.back() + 1)).Yank(name);
+    }
+
+    std::string text;
     
-    return true;
-  }        
-private:
+    for (const auto line : lines)
+    {
+      text += m_STC->GetLine(line).ToStdString();
+    }
+
+    return wxExEx::GetMacros().SetRegister(name, text);
+  }
+
   const wxExIndicator m_FindIndicator;
-  std::vector<std::string> m_Commands;
-  int m_Changes {0};
+  std::vector<GlobalCommand> m_Commands;
+  bool m_SamePattern {false};
   wxExEx* m_Ex;
+  wxExSTC* m_STC;
 };
 
 wxExAddressRange::wxExAddressRange(wxExEx* ex, int lines)
@@ -161,17 +406,9 @@ wxExAddressRange::wxExAddressRange(wxExEx* ex, const std::string& range)
   }
 }
 
-const std::string wxExAddressRange::BuildReplacement(const std::string& text) const
+const std::string wxExAddressRange::BuildReplacement(
+  const std::string& text, std::string target)
 {
-  if (text.find("&") == std::string::npos && 
-      text.find("\0") == std::string::npos)
-  {
-    return text;
-  }
-
-  std::string target(m_STC->GetTextRange(
-    m_STC->GetTargetStart(), m_STC->GetTargetEnd()));
-    
   std::string replacement;
   bool backslash = false;
 
@@ -199,7 +436,6 @@ const std::string wxExAddressRange::BuildReplacement(const std::string& text) co
         if (backslash) 
         {
           std::transform(target.begin(), target.end(), target.begin(), ::tolower);
-          m_STC->Replace(m_STC->GetTargetStart(), m_STC->GetTargetEnd(), target);
         }
         else
           replacement += c;
@@ -210,7 +446,6 @@ const std::string wxExAddressRange::BuildReplacement(const std::string& text) co
         if (backslash) 
         {
           std::transform(target.begin(), target.end(), target.begin(), ::toupper);
-          m_STC->Replace(m_STC->GetTargetStart(), m_STC->GetTargetEnd(), target);
         }
         else
           replacement += c;
@@ -436,39 +671,48 @@ bool wxExAddressRange::Global(const std::string& text, bool inverse) const
     return true;  
   }
   
-  const GlobalEnv g(m_Ex, m_FindIndicator, rest);
-  m_Ex->MarkerAdd('%', m_End.GetLine() - 1);
-  m_STC->SetTargetStart(m_STC->PositionFromLine(m_Begin.GetLine() - 1));
-  m_STC->SetTargetEnd(m_STC->GetLineEndPosition(m_Ex->MarkerLine('%')));
+  const GlobalEnv g(m_Ex, m_FindIndicator, pattern, rest);
+  const auto begin = m_Begin.GetLine() - 1;
+  auto end = m_End.GetLine() - 1;
   
-  const bool infinite = (g.Changes() > 0 && rest != "$" && rest != "1");
+  // Skip the empty line after the last eol.
+  if (end > begin && end == m_STC->GetLineCount() - 1 && m_STC->LineLength(end) == 0)
+  {
+    end--;
+  }
+  
+  // First collect all lines matching, then run the commands on them.
+  std::vector<int> lines;
   int hits = 0;
-  int start = 0;
+  
+  m_STC->SetTargetStart(m_STC->PositionFromLine(begin));
+  m_STC->SetTargetEnd(m_STC->GetLineEndPosition(end));
   
   while (m_STC->SearchInTarget(pattern) != -1)
   {
-    auto match = m_STC->LineFromPosition(m_STC->GetTargetStart());
+    const auto match = m_STC->LineFromPosition(m_STC->GetTargetStart());
     
-    if (!inverse)
+    if (lines.empty() || lines.back() != match)
     {
-      if (!g.ForEach(match)) return false;
-      hits++;
+      lines.emplace_back(match);
     }
-    else
+    
+    if (!inverse && !g.Commands())
     {
-      if (!g.ForEach(start, match, hits)) return false;
-      start = match + 1;
+      m_STC->SetIndicator(m_FindIndicator, 
+        m_STC->GetTargetStart(), m_STC->GetTargetEnd());
+      hits++;
+      
+      // Continue after the match, all matches are indicated.
+      m_STC->SetTargetStart(std::max(
+        m_STC->GetTargetEnd(), m_STC->GetTargetStart() + 1));
     }
-        
-    if (hits > 50 && infinite)
+    else
     {
-      m_Ex->GetFrame()->ShowExMessage(
-        "possible infinite loop at " + std::to_string(match));
-      return false;
+      m_STC->SetTargetStart(m_STC->PositionFromLine(match + 1));
     }
-    
-    m_STC->SetTargetStart(g.Changes() > 0 ? m_STC->PositionFromLine(match): m_STC->GetTargetEnd());
-    m_STC->SetTargetEnd(m_STC->GetLineEndPosition(m_Ex->MarkerLine('%')));
+
+    m_STC->SetTargetEnd(m_STC->GetLineEndPosition(end));
   
     if (m_STC->GetTargetStart() >= m_STC->GetTargetEnd())
     {
@@ -478,7 +722,34 @@ bool wxExAddressRange::Global(const std::string& text, bool inverse) const
   
   if (inverse)
   {
-    if (auto match = m_STC->GetLineCount(); !g.ForEach(start, match, hits)) return false;
+    std::vector<int> others;
+    
+    for (int line = begin, i = 0; line <= end; line++)
+    {
+      if (i < (int)lines.size() && lines[i] == line)
+      {
+        i++;
+      }
+      else
+      {
+        others.emplace_back(line);
+        
+        if (!g.Commands())
+        {
+          m_STC->SetIndicator(m_FindIndicator, 
+            m_STC->PositionFromLine(line), m_STC->GetLineEndPosition(line));
+        }
+      }
+    }
+    
+    lines.swap(others);
+    hits = lines.size();
+  }
+  
+  if (g.Commands())
+  {
+    if (!g.Run(lines, inverse)) return false;
+    hits = lines.size();
   }
   
   if (hits > 0)
@@ -627,8 +898,8 @@ bool wxExAddressRange::Print(const std::string& flags) const
   
   for (auto i = m_Begin.GetLine() - 1; i < m_End.GetLine(); i++)
   {
-    char buffer[8];
-    sprintf(buffer, "%6d ", i + 1);
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%6d ", i + 1);
     
     text += (flags.find("#") != std::string::npos ? buffer: std::string()) + 
       m_STC->GetLine(i);
@@ -792,55 +1063,66 @@ bool wxExAddressRange::Substitute(const std::string& text, const char cmd)
   m_STC->SetTargetStart(m_STC->PositionFromLine(m_Ex->MarkerLine('#')));
   m_STC->SetTargetEnd(m_STC->GetLineEndPosition(m_Ex->MarkerLine('$')));
 
-  int nr_replacements = 0;
-  int result = wxID_YES;
-  const bool build = (repl.find_first_of("&0LU\\") != std::string::npos);
   const bool confirm = (options.find("c") != std::string::npos);
   const bool global = (options.find("g") != std::string::npos);
-  auto replacement(repl);
+  
+  // Without confirm all matches are replaced at once, if possible,
+  // otherwise each match is replaced.
+  int nr_replacements = (!confirm ? SubstituteAll(
+    pattern, repl, searchFlags, global, 
+    m_Ex->MarkerLine('#'), m_Ex->MarkerLine('$')): -1);
 
-  while (m_STC->SearchInTarget(pattern) != -1 && result != wxID_CANCEL)
+  if (nr_replacements == -1)
   {
-    if (build)
-    {
-      replacement = BuildReplacement(repl);
-    }
+    nr_replacements = 0;
+    int result = wxID_YES;
+    const bool build = (repl.find_first_of("&0LU\\") != std::string::npos);
+    auto replacement(repl);
     
-    if (confirm)
-    {
-      result = Confirm(pattern, replacement);
-    }
-        
-    if (result == wxID_YES)
+    while (m_STC->SearchInTarget(pattern) != -1 && result != wxID_CANCEL)
     {
-      if (m_STC->HexMode())
-      {  
-        m_STC->GetHexMode().ReplaceTarget(replacement, false);
+      if (build)
+      {
+        replacement = BuildReplacement(repl, m_STC->GetTextRange(
+          m_STC->GetTargetStart(), m_STC->GetTargetEnd()).ToStdString());
       }
-      else
+    
+      if (confirm)
       {
-        (searchFlags & wxSTC_FIND_REGEXP) ?
-           m_STC->ReplaceTargetRE(replacement):
-           m_STC->ReplaceTarget(replacement);
+        result = Confirm(pattern, replacement);
       }
         
-      nr_replacements++;
-    }
+      if (result == wxID_YES)
+      {
+        if (m_STC->HexMode())
+        {  
+          m_STC->GetHexMode().ReplaceTarget(replacement, false);
+        }
+        else
+        {
+          (searchFlags & wxSTC_FIND_REGEXP) ?
+             m_STC->ReplaceTargetRE(replacement):
+             m_STC->ReplaceTarget(replacement);
+        }
+        
+        nr_replacements++;
+      }
     
-    m_STC->SetTargetStart(global ? 
-      m_STC->GetTargetEnd():
-      m_STC->GetLineEndPosition(m_STC->LineFromPosition(m_STC->GetTargetEnd())));
-    m_STC->SetTargetEnd(m_STC->GetLineEndPosition(m_Ex->MarkerLine('$')));
+      m_STC->SetTargetStart(global ? 
+        m_STC->GetTargetEnd():
+        m_STC->GetLineEndPosition(m_STC->LineFromPosition(m_STC->GetTargetEnd())));
+      m_STC->SetTargetEnd(m_STC->GetLineEndPosition(m_Ex->MarkerLine('$')));
   
-    if (m_STC->GetTargetStart() >= m_STC->GetTargetEnd())
-    {
-      break;
+      if (m_STC->GetTargetStart() >= m_STC->GetTargetEnd())
+      {
+        break;
+      }
     }
   }
   
   if (m_STC->HexMode())
   {
-    m_STC->GetHexMode().SetText(m_STC->GetHexMode().GetBuffer());
+    m_STC->GetHexMode().RenderChanges();
   }
 
   m_STC->EndUndoAction();
@@ -863,6 +1145,206 @@ bool wxExAddressRange::Substitute(const std::string& text, const char cmd)
   return true;
 }
 
+int wxExAddressRange::SubstituteAll(
+  const std::string& pattern, 
+  const std::string& repl,
+  int flags,
+  bool global, 
+  int begin_line, 
+  int end_line) const
+{
+  const bool regex = (flags & wxSTC_FIND_REGEXP);
+  
+  // Only the C++11 regex used by scintilla can be done here.
+#if wxCHECK_VERSION(3,1,1)
+  const bool cxx11 = (flags & wxSTC_FIND_CXX11REGEX);
+#else
+  const bool cxx11 = false;
+#endif
+
+  if (m_STC->HexMode() || 
+     (regex && !cxx11) ||
+     (flags & (wxSTC_FIND_WHOLEWORD | wxSTC_FIND_WORDSTART)) ||
+     (!regex && pattern.find_first_of("\r\n") != std::string::npos))
+  {
+    return -1;
+  }
+
+  std::shared_ptr<const std::regex> re;
+  
+  if (regex)
+  {
+    try
+    {
+      re = wxExRegexCache::Get(pattern, 
+        ((flags & wxSTC_FIND_POSIX) ? std::regex::basic: std::regex::ECMAScript) |
+        ((flags & wxSTC_FIND_MATCHCASE) ? std::regex::flag_type(): std::regex::icase));
+    }
+    catch (std::regex_error& e)
+    {
+      wxLogStatus("regex error: %s %s", e.what(), pattern);
+      return 0;
+    }
+  }
+  
+  const auto start = m_STC->PositionFromLine(begin_line);
+  const auto end = m_STC->GetLineEndPosition(end_line);
+  const auto buffer(m_STC->GetTextRangeRaw(start, end));
+  const std::string text(buffer.data(), buffer.length());
+  const bool build = (repl.find_first_of("&0LU\\") != std::string::npos);
+  
+  // Returns number of line ends in text starting at pos.
+  const auto eols = [](const std::string& text, size_t pos) {
+    int count = 0;
+    for (auto i = pos; i < text.size(); i++)
+    {
+      if (text[i] == '\n' || (text[i] == '\r' && 
+        (i + 1 == text.size() || text[i + 1] != '\n'))) count++;
+    }
+    return count;};
+    
+  std::string result;
+  result.reserve(text.size());
+  std::vector<int> changed;
+  int nr_replacements = 0;
+  
+  // Each line is done as scintilla does, so a match does not span lines,
+  // and without global only the first match on a line is replaced.
+  for (size_t pos = 0, line = begin_line; pos <= text.size(); line++)
+  {
+    const auto eol = text.find_first_of("\r\n", pos);
+    const auto line_end = (eol == std::string::npos ? text.size(): eol);
+    const auto line_result = result.size();
+    const auto before = nr_replacements;
+    auto col = pos;
+    
+    while (col <= line_end)
+    {
+      size_t match, length;
+      std::string replacement;
+      
+      if (regex)
+      {
+        std::smatch m;
+        
+        if (!std::regex_search(
+          text.begin() + col, text.begin() + line_end, m, *re, col > pos ?
+            std::regex_constants::match_not_bol | std::regex_constants::match_prev_avail:
+            std::regex_constants::match_default)) break;
+        
+        match = col + m.position(0);
+        length = m.length(0);
+        
+        // Groups refer to the text matched, as in ReplaceTargetRE.
+        const auto target(build ? BuildReplacement(repl, m.str(0)): repl);
+        
+        for (size_t i = 0; i < target.size(); i++)
+        {
+          if (target[i] != '\\' || i + 1 == target.size())
+          {
+            replacement += target[i];
+          }
+          else if (const auto c = target[++i]; isdigit(c))
+          {
+            if (const size_t group = c - '0'; group < m.size()) 
+              replacement += m.str(group);
+          }
+          else switch (c)
+          {
+            case 'a': replacement += '\a'; break;
+            case 'b': replacement += '\b'; break;
+            case 'f': replacement += '\f'; break;
+            case 'n': replacement += '\n'; break;
+            case 'r': replacement += '\r'; break;
+            case 't': replacement += '\t'; break;
+            case 'v': replacement += '\v'; break;
+            case '\\': replacement += '\\'; break;
+            default: replacement += '\\'; i--;
+          }
+        }
+      }
+      else
+      {
+        const auto it = std::search(
+          text.begin() + col, text.begin() + line_end, 
+          pattern.begin(), pattern.end(), 
+          [&](char c1, char c2) {return (flags & wxSTC_FIND_MATCHCASE) ? 
+            c1 == c2: 
+            tolower((unsigned char)c1) == tolower((unsigned char)c2);});
+          
+        if (it == text.begin() + line_end) break;
+        
+        match = it - text.begin();
+        length = pattern.size();
+        replacement = (build ? BuildReplacement(repl, text.substr(match, length)): repl);
+      }
+      
+      result.append(text, col, match - col);
+      result += replacement;
+      nr_replacements++;
+      col = match + length;
+      
+      // An empty match is followed by the next char.
+      if (length == 0)
+      {
+        if (match < line_end) result += text[match];
+        col++;
+      }
+      
+      if (!global) break;
+    }
+    
+    if (col < line_end)
+    {
+      result.append(text, col, line_end - col);
+    }
+    
+    // The replacements might have split the line.
+    if (nr_replacements > before)
+    {
+      const auto lines = eols(result, line_result);
+      
+      for (int i = 0; i <= lines; i++)
+      {
+        changed.emplace_back(line + i);
+      }
+      
+      line += lines;
+    }
+    
+    if (eol == std::string::npos) break;
+    
+    pos = eol + (text.compare(eol, 2, "\r\n") == 0 ? 2: 1);
+    result.append(text, eol, pos - eol);
+  }
+  
+  if (nr_replacements > 0)
+  {
+    // Only the text that differs is replaced.
+    const size_t prefix = std::mismatch(
+      text.begin(), text.end(), result.begin(), result.end()).first - text.begin();
+    const size_t suffix = std::mismatch(
+      text.rbegin(), text.rend() - prefix, 
+      result.rbegin(), result.rend() - prefix).first - text.rbegin();
+
+    m_STC->UseModificationMarkers(false);
+    m_STC->SetTargetStart(start + prefix);
+    m_STC->SetTargetEnd(start + text.size() - suffix);
+    m_STC->ReplaceTargetRaw(
+      result.data() + prefix, result.size() - prefix - suffix);
+    m_STC->UseModificationMarkers(true);
+    
+    for (const auto line : changed)
+    {
+      m_STC->MarkerAddChange(line);
+    }
+    
+    m_Ex->MarkerAdd('$', begin_line + eols(result, 0));
+  }
+  
+  return nr_replacements;
+}
+
 bool wxExAddressRange::Write(const std::string& text) const
 {
   if (!SetSelection())
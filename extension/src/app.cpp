@@ -15,7 +15,9 @@
 #include <wx/stdpaths.h>
 #include <wx/extension/app.h>
 #include <wx/extension/addressrange.h>
+#include <wx/extension/ctags-indexer.h>
 #include <wx/extension/ex.h>
+#include <wx/extension/file-watcher.h>
 #include <wx/extension/frd.h>
 #include <wx/extension/lexers.h>
 #include <wx/extension/log.h>
@@ -47,6 +49,8 @@ void wxExApp::OnAssertFailure(
     
 int wxExApp::OnExit()
 {
+  delete wxExCTagsIndexer::Set(nullptr);
+  delete wxExFileWatcher::Set(nullptr);
   delete wxExFindReplaceData::Set(nullptr);
   delete wxExLexers::Set(nullptr);
   delete wxExPrinting::Set(nullptr);
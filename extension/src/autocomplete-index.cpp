@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      autocomplete-index.cpp
+// Purpose:   Implementation of class wxExAutoCompleteIndex
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iterator>
+#include <wx/extension/autocomplete-index.h>
+
+wxExAutoCompleteIndex::wxExAutoCompleteIndex(
+  size_t min_size, size_t max_candidates)
+  : m_MaxCandidates(max_candidates)
+  , m_MinSize(min_size)
+{
+}
+
+bool wxExAutoCompleteIndex::Add(const std::string& word)
+{
+  if (word.size() < m_MinSize) return false;
+
+  if (const auto& it = std::lower_bound(m_Words.begin(), m_Words.end(), word);
+    it != m_Words.end() && *it == word)
+  {
+    return false;
+  }
+  else
+  {
+    m_Words.insert(it, word);
+  }
+
+  m_Valid = false;
+
+  return true;
+}
+
+void wxExAutoCompleteIndex::Assign(const std::set<std::string>& words)
+{
+  m_Words.clear();
+  m_Words.reserve(words.size());
+
+  // The set is already sorted.
+  std::copy_if(words.begin(), words.end(), std::back_inserter(m_Words),
+    [&](const std::string& word) {return word.size() >= m_MinSize;});
+
+  m_Valid = false;
+}
+
+void wxExAutoCompleteIndex::Clear()
+{
+  m_Words.clear();
+  m_Valid = false;
+}
+
+const std::string& wxExAutoCompleteIndex::Get(const std::string& prefix)
+{
+  if (m_Valid && prefix == m_Prefix)
+  {
+    return m_Buffer;
+  }
+
+  auto first = m_Words.begin();
+  auto last = m_Words.end();
+
+  if (m_Valid && prefix.compare(0, m_Prefix.size(), m_Prefix) == 0)
+  {
+    first += m_First;
+    last = m_Words.begin() + m_Last;
+  }
+
+  // All words starting with prefix follow the lower bound of the prefix.
+  first = std::lower_bound(first, last, prefix);
+  last = std::partition_point(first, last, [&](const std::string& word) {
+    return word.compare(0, prefix.size(), prefix) == 0;});
+
+  m_Valid = true;
+  m_Prefix = prefix;
+  m_First = first - m_Words.begin();
+  m_Last = last - m_Words.begin();
+
+  m_Buffer.clear();
+
+  size_t size = 0;
+  const auto end = first + std::min(m_MaxCandidates, m_Last - m_First);
+
+  for (auto it = first; it != end; ++it)
+  {
+    size += it->size() + 1;
+  }
+
+  m_Buffer.reserve(size);
+
+  for (auto it = first; it != end; ++it)
+  {
+    m_Buffer += *it;
+    m_Buffer += ' ';
+  }
+
+  return m_Buffer;
+}
@@ -16,6 +16,8 @@
 wxExAutoComplete::wxExAutoComplete(wxExSTC* stc)
   : m_STC(stc)
   , m_MinSize(3)
+  , m_Inserts(m_MinSize)
+  , m_Keywords(m_MinSize)
 {
 }
 
@@ -82,7 +84,7 @@ bool wxExAutoComplete::Apply(char c)
   {
     if (m_Text.size() > m_MinSize)
     {
-      m_Inserts.emplace(m_Text);
+      m_Inserts.Add(m_Text);
     }
 
     Clear();
@@ -146,13 +148,11 @@ bool wxExAutoComplete::ShowCTags(bool show) const
   }
 }
 
-bool wxExAutoComplete::ShowInserts(bool show) const
+bool wxExAutoComplete::ShowInserts(bool show)
 {
-  if (show && !m_Text.empty() && !m_Inserts.empty())
+  if (show && !m_Text.empty() && m_Inserts.GetSize() > 0)
   {
-    if (const auto comp(wxExGetStringSet(
-      m_Inserts, m_MinSize, m_Text));
-      !comp.empty())
+    if (const auto& comp(m_Inserts.Get(m_Text)); !comp.empty())
     {
       m_STC->AutoCompShow(m_Text.length() - 1, comp);
       return true;
@@ -162,17 +162,25 @@ bool wxExAutoComplete::ShowInserts(bool show) const
   return false;
 }
 
-bool wxExAutoComplete::ShowKeywords(bool show) const
+bool wxExAutoComplete::ShowKeywords(bool show)
 {
-  if (show && !m_Text.empty() && m_STC->GetLexer().KeywordStartsWith(m_Text))
+  if (!show || m_Text.empty())
   {
-    if (const auto comp(
-      m_STC->GetLexer().GetKeywordsString(-1, m_MinSize, m_Text));
-      !comp.empty())
-    {
-      m_STC->AutoCompShow(m_Text.length() - 1, comp);
-      return true;
-    }
+    return false;
+  }
+
+  // Rebuild the index only if the lexer keywords changed.
+  if (const auto& lexer(m_STC->GetLexer()); 
+    lexer.GetVersion() != m_KeywordsVersion)
+  {
+    m_Keywords.Assign(lexer.GetKeywords());
+    m_KeywordsVersion = lexer.GetVersion();
+  }
+
+  if (const auto& comp(m_Keywords.Get(m_Text)); !comp.empty())
+  {
+    m_STC->AutoCompShow(m_Text.length() - 1, comp);
+    return true;
   }
 
   return false;
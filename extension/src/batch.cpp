@@ -0,0 +1,300 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      batch.cpp
+// Purpose:   Implementation of class wxExBatch
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <experimental/filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+#include <wx/extension/batch.h>
+#include <wx/extension/managedframe.h>
+#include <wx/extension/stat.h>
+#include <wx/extension/stc.h>
+#include <wx/extension/util.h>
+#include <wx/extension/vi.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace fs = std::experimental::filesystem;
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  // The frame used by the ex commands, never shown,
+  // text printed by ex is written on stdout.
+  class BatchFrame : public wxExManagedFrame
+  {
+  public:
+    BatchFrame() : wxExManagedFrame() {;};
+    virtual void PrintEx(wxExEx* ex, const std::string& text) override {
+      std::cout << text;};
+  };
+
+  // The state of a file along the steps.
+  struct Step
+  {
+    std::string m_Text;
+    std::string m_Error;
+    bool m_Changed {false};
+    Clock::duration m_Time {0};
+  };
+
+  // Adds the files in the directory and its subdirectories matching
+  // filespec, skipping hidden and version control directories.
+  void Expand(
+    const wxExPath& dir, 
+    const std::string& filespec, 
+    std::vector<wxExPath>& files)
+  {
+    std::error_code ec;
+
+    for (auto it = fs::recursive_directory_iterator(dir.Path(), ec);
+      !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+    {
+      const auto name(it->path().filename().string());
+      std::error_code status;
+
+      if ((!name.empty() && name[0] == '.') || name == "CVS")
+      {
+        if (fs::is_directory(it->status(status))) it.disable_recursion_pending();
+      }
+      else if (
+        fs::is_regular_file(it->status(status)) && 
+        wxExMatchesOneOf(name, filespec))
+      {
+        files.emplace_back(it->path());
+      }
+    }
+  }
+
+  // Reads the file, on a worker thread.
+  Step Load(const wxExPath& path)
+  {
+    const auto start = Clock::now();
+
+    Step step;
+
+    if (std::ifstream ifs(path.Path().string(), std::ios::binary); !ifs)
+    {
+      step.m_Error = "cannot open";
+    }
+    else
+    {
+      step.m_Text.assign(
+        std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    step.m_Time = Clock::now() - start;
+
+    return step;
+  }
+
+  // Runs the script on the text, on the main thread.
+  Step Edit(
+    wxWindow* parent,
+    const wxExPath& path,
+    const std::vector<std::string>& script,
+    Step step)
+  {
+    if (!step.m_Error.empty()) return step;
+
+    const auto start = Clock::now();
+
+    // A new stc for each file, so no marker or mode is left over.
+    auto* stc = new wxExSTC(std::string(), wxExSTCData().
+      Window(wxExWindowData().Parent(parent)));
+
+    stc->GetLexer().Set(path.GetLexer());
+    stc->AddTextRaw(step.m_Text.data(), step.m_Text.size());
+    stc->EmptyUndoBuffer();
+    stc->SetSavePoint();
+    stc->DocumentStart();
+
+    for (const auto& command : script)
+    {
+      if (!stc->GetVi().Command(command))
+      {
+        step.m_Error = "aborted at: " + command;
+        break;
+      }
+    }
+
+    if (step.m_Error.empty() && stc->GetModify())
+    {
+      const auto buffer(stc->GetTextRaw());
+      step.m_Text.assign(buffer.data(), buffer.length());
+      step.m_Changed = true;
+    }
+    else
+    {
+      step.m_Text.clear();
+    }
+
+    delete stc;
+
+    step.m_Time += Clock::now() - start;
+
+    return step;
+  }
+
+  bool Write(const fs::path& path, const std::string& text)
+  {
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    ofs.write(text.data(), text.size());
+    ofs.close();
+    return (bool)ofs;
+  }
+
+  // Writes the text to a temporary file next to the file, having
+  // the same permissions and owner, and renames it over the file,
+  // so a reader never sees a partial file. For a symbolic link
+  // the file it refers to is replaced. If the owner cannot be kept,
+  // the file is written in place.
+  Step Save(const wxExPath& path, Step step)
+  {
+    if (!step.m_Changed) return step;
+
+    const auto start = Clock::now();
+
+    std::error_code ec;
+
+    if (const auto file(fs::canonical(path.Path(), ec)); ec)
+    {
+      step.m_Error = "cannot resolve";
+    }
+    else
+    {
+      const auto tmp(file.parent_path() / ("." + file.filename().string() + ".tmp"));
+      const wxExStat stat(file.string());
+      bool in_place = !stat.IsOk();
+
+      if (!in_place && !Write(tmp, step.m_Text))
+      {
+        step.m_Error = "cannot write";
+      }
+      else if (!in_place)
+      {
+        fs::permissions(tmp, fs::status(file, ec).permissions(), ec);
+#ifndef _WIN32
+        in_place = (chown(tmp.c_str(), stat.st_uid, stat.st_gid) != 0);
+#endif
+        if (!in_place)
+        {
+          fs::rename(tmp, file, ec);
+
+          if (ec)
+          {
+            step.m_Error = "cannot rename";
+          }
+        }
+      }
+
+      if (in_place && !Write(file, step.m_Text))
+      {
+        step.m_Error = "cannot write";
+      }
+
+      if (!step.m_Error.empty() || in_place)
+      {
+        fs::remove(tmp, ec);
+      }
+    }
+
+    step.m_Text.clear();
+    step.m_Time += Clock::now() - start;
+
+    return step;
+  }
+}
+
+int wxExBatch::Run(
+  const std::vector<wxExPath>& args, const std::string& filespec) const
+{
+  std::vector<wxExPath> files;
+
+  for (const auto& arg : args)
+  {
+    if (arg.DirExists())
+    {
+      Expand(arg, filespec.empty() ? "*": filespec, files);
+    }
+    else
+    {
+      files.emplace_back(arg);
+    }
+  }
+
+  const auto start = Clock::now();
+  const size_t ahead = std::max(2u, std::thread::hardware_concurrency());
+
+  // The stcs need a parent, and ex a managed frame as top window.
+  auto* parent = new BatchFrame();
+  auto* top = wxTheApp->GetTopWindow();
+  wxTheApp->SetTopWindow(parent);
+
+  std::deque<std::future<Step>> loading, saving;
+  size_t loaded = 0, reported = 0;
+  int changed = 0, failed = 0;
+
+  const auto report = [&] {
+    const auto step(saving.front().get());
+    saving.pop_front();
+
+    std::cout << files[reported++].Path().string() << ": " <<
+      (!step.m_Error.empty() ? "failed (" + step.m_Error + ")":
+        step.m_Changed ? std::string("changed"): std::string("unchanged")) <<
+      " " << std::chrono::duration_cast<std::chrono::milliseconds>(
+        step.m_Time).count() << " ms\n";
+
+    if (!step.m_Error.empty()) failed++;
+    else if (step.m_Changed) changed++;};
+
+  for (size_t i = 0; i < files.size(); i++)
+  {
+    // Keep the workers reading ahead of the script.
+    for (; loaded < files.size() && loaded < i + ahead; loaded++)
+    {
+      loading.emplace_back(std::async(std::launch::async, Load, files[loaded]));
+    }
+
+    auto step(Edit(parent, files[i], m_Script, loading.front().get()));
+    loading.pop_front();
+
+    saving.emplace_back(std::async(std::launch::async, Save, files[i], std::move(step)));
+
+    // Report in order, so at most ahead files are being written.
+    if (saving.size() > ahead)
+    {
+      report();
+    }
+  }
+
+  while (!saving.empty())
+  {
+    report();
+  }
+
+  wxTheApp->SetTopWindow(top);
+  delete parent;
+
+  std::cout << files.size() << " files, " << changed << " changed, " <<
+    failed << " failed in " <<
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      Clock::now() - start).count() << " ms\n";
+
+  return failed;
+}
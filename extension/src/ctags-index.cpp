@@ -0,0 +1,544 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      ctags-index.cpp
+// Purpose:   Implementation of class wxExCTagsIndex
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+#include <wx/extension/ctags-entry.h>
+#include <wx/extension/ctags-index.h>
+#include <wx/extension/stat.h>
+
+namespace
+{
+  // Parses a tag line, like readtags does, but without copying.
+  bool Parse(const std::string_view& line, wxExCTagsIndex::wxExCTag& tag)
+  {
+    const auto tab1 = line.find('\t');
+    const auto tab2 = (tab1 != std::string_view::npos ?
+      line.find('\t', tab1 + 1): std::string_view::npos);
+
+    if (tab2 == std::string_view::npos)
+    {
+      return false;
+    }
+
+    tag = wxExCTagsIndex::wxExCTag();
+    tag.m_Name = line.substr(0, tab1);
+    tag.m_File = line.substr(tab1 + 1, tab2 - tab1 - 1);
+
+    auto pos = tab2 + 1;
+
+    if (pos < line.size() && (line[pos] == '/' || line[pos] == '?'))
+    {
+      auto end = pos + 1;
+
+      for (; end < line.size() && line[end] != line[pos]; end++)
+      {
+        if (line[end] == '\\') end++;
+      }
+
+      end = std::min(end + 1, line.size());
+      tag.m_Pattern = line.substr(pos, end - pos);
+      pos = end;
+    }
+    else
+    {
+      for (; pos < line.size() && isdigit(line[pos]); pos++)
+      {
+        tag.m_LineNumber = tag.m_LineNumber * 10 + line[pos] - '0';
+      }
+    }
+
+    if (line.compare(pos, 2, ";\"") != 0)
+    {
+      return true;
+    }
+
+    for (pos += 2; pos < line.size(); )
+    {
+      auto end = line.find('\t', pos);
+      if (end == std::string_view::npos) end = line.size();
+
+      const auto field(line.substr(pos, end - pos));
+      pos = end + 1;
+
+      if (const auto colon = field.find(':'); colon == std::string_view::npos)
+      {
+        if (!field.empty()) tag.m_Kind = field;
+      }
+      else
+      {
+        const auto key(field.substr(0, colon));
+        const auto value(field.substr(colon + 1));
+
+        if (key == "kind") tag.m_Kind = value;
+        else if (key == "class") tag.m_Class = value;
+        else if (key == "signature") tag.m_Signature = value;
+        else if (key == "typeref") tag.m_Typeref = value;
+        else if (key == "line") tag.m_LineNumber = atoi(std::string(value).c_str());
+        else if (key == "access")
+        {
+          if (value == "public") tag.m_Access = wxExCTagsIndex::ACCESS_PUBLIC;
+          else if (value == "protected") tag.m_Access = wxExCTagsIndex::ACCESS_PROTECTED;
+          else if (value == "private") tag.m_Access = wxExCTagsIndex::ACCESS_PRIVATE;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  const std::string_view AccessName(wxExCTagsIndex::wxExCTagsAccess access)
+  {
+    switch (access)
+    {
+      case wxExCTagsIndex::ACCESS_PUBLIC: return "public";
+      case wxExCTagsIndex::ACCESS_PROTECTED: return "protected";
+      case wxExCTagsIndex::ACCESS_PRIVATE: return "private";
+      default: return std::string_view();
+    }
+  }
+
+  using wxExCTagsIndexFuture = 
+    std::shared_future<std::shared_ptr<const wxExCTagsIndex>>;
+
+  // A loaded index, the first load, and the index being 
+  // loaded in the background. The modification time is that of
+  // the file the index corresponds with.
+  struct wxExCTagsIndexLoaded
+  {
+    std::shared_ptr<const wxExCTagsIndex> m_Index;
+    wxExCTagsIndexFuture m_Load, m_Reload;
+    time_t m_ModificationTime {0};
+  };
+
+  // All indexes loaded, on path.
+  struct wxExCTagsIndexRegistry
+  {
+    std::mutex m_Mutex;
+    std::map<std::string, wxExCTagsIndexLoaded> m_Loaded;
+  };
+
+  wxExCTagsIndexRegistry& GetRegistry()
+  {
+    static wxExCTagsIndexRegistry registry;
+    return registry;
+  }
+
+  const auto RowLess = [](const auto& a, const auto& b) {
+    return a.m_Name < b.m_Name;};
+}
+
+wxExCTagsIndex::wxExCTagsIndex(const std::string& path)
+{
+  if (const wxExStat stat(path); stat.IsOk())
+  {
+    if (std::ifstream ifs(path, std::ios::binary); ifs.is_open())
+    {
+      auto contents(std::make_shared<std::string>(stat.st_size, '\0'));
+      ifs.read(contents->data(), contents->size());
+      contents->resize(ifs.gcount());
+      m_Contents.emplace_back(contents);
+      m_IsOk = true;
+      m_ModificationTime = stat.st_mtime;
+      Load();
+    }
+  }
+}
+
+wxExCTagsIndex::wxExCTagsIndex(const wxExCTagsIndex& index,
+  const std::map<std::string, std::vector<std::string>>& files)
+  : m_Contents(index.m_Contents)
+  , m_IsOk(index.m_IsOk)
+  , m_ModificationTime(index.m_ModificationTime)
+  , m_Strings(index.m_Strings)
+  , m_StringIds(index.m_StringIds)
+{
+  auto contents(std::make_shared<std::string>());
+  std::unordered_set<uint32_t> removed;
+
+  for (const auto& it : files)
+  {
+    if (const auto& id = m_StringIds.find(it.first); id != m_StringIds.end())
+    {
+      removed.insert(id->second);
+    }
+
+    for (const auto& line : it.second)
+    {
+      contents->append(line);
+      contents->push_back('\n');
+    }
+  }
+
+  m_Contents.emplace_back(contents);
+
+  // The rows of other files are still sorted, the new rows are 
+  // sorted and merged, so the update is linear in the number of tags.
+  m_Rows.reserve(index.m_Rows.size() + 
+    std::count(contents->begin(), contents->end(), '\n'));
+
+  std::copy_if(index.m_Rows.begin(), index.m_Rows.end(), 
+    std::back_inserter(m_Rows), [&](const auto& row) {
+      return removed.find(row.m_File) == removed.end();});
+
+  const auto kept = m_Rows.size();
+
+  AddRows(*contents);
+
+  std::stable_sort(m_Rows.begin() + kept, m_Rows.end(), RowLess);
+  std::inplace_merge(m_Rows.begin(), m_Rows.begin() + kept, m_Rows.end(), RowLess);
+
+  AddClassRows();
+}
+
+void wxExCTagsIndex::AddClassRows()
+{
+  for (size_t row = 0; row < m_Rows.size(); row++)
+  {
+    if (m_Rows[row].m_Class != 0)
+    {
+      m_ClassRows[m_Rows[row].m_Class].emplace_back(row);
+    }
+  }
+}
+
+void wxExCTagsIndex::AddRows(const std::string_view& text)
+{
+  for (size_t start = 0; start < text.size(); )
+  {
+    auto end = text.find('\n', start);
+    if (end == std::string_view::npos) end = text.size();
+
+    auto line(text.substr(start, end - start));
+    start = end + 1;
+
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+    // Skip the pseudo tags.
+    if (line.compare(0, 6, "!_TAG_") == 0) continue;
+
+    if (wxExCTag tag; Parse(line, tag))
+    {
+      m_Rows.push_back({
+        tag.m_Name,
+        (uint32_t)line.size(),
+        Intern(tag.m_File),
+        Intern(tag.m_Kind),
+        Intern(tag.m_Class),
+        Intern(AccessName(tag.m_Access))});
+    }
+  }
+}
+
+bool wxExCTagsIndex::Filter(size_t row, const wxExCTagsEntry& filter) const
+{
+  if (!filter.Active()) return true;
+
+  const auto& r(m_Rows[row]);
+
+  return
+    (filter.Kind().empty() || m_Strings[r.m_Kind] == filter.Kind()) &&
+    (filter.Access().empty() || m_Strings[r.m_Access] == filter.Access()) &&
+    (filter.Class().empty() || m_Strings[r.m_Class] == filter.Class()) &&
+    (filter.Signature().empty() || GetTag(row).m_Signature == filter.Signature());
+}
+
+std::pair<size_t, size_t> wxExCTagsIndex::Find(const std::string_view& name) const
+{
+  const auto first = std::lower_bound(m_Rows.begin(), m_Rows.end(), name,
+    [](const auto& a, const auto& b) {return a.m_Name < b;});
+  const auto last = std::upper_bound(first, m_Rows.end(), name,
+    [](const auto& a, const auto& b) {return a < b.m_Name;});
+
+  return {first - m_Rows.begin(), last - m_Rows.begin()};
+}
+
+void wxExCTagsIndex::FindFuzzy(const std::string_view& text,
+  std::function<bool(size_t)> callback) const
+{
+  if (text.empty()) return;
+
+  const auto range(FindPrefix(text.substr(0, 1)));
+
+  for (auto row = range.first; row < range.second; row++)
+  {
+    const auto& name(m_Rows[row].m_Name);
+    size_t pos = 0;
+
+    for (size_t i = 0; i < name.size() && pos < text.size(); i++)
+    {
+      if (name[i] == text[pos]) pos++;
+    }
+
+    if (pos == text.size() && !callback(row))
+    {
+      return;
+    }
+  }
+}
+
+std::pair<size_t, size_t> wxExCTagsIndex::FindPrefix(
+  const std::string_view& prefix) const
+{
+  const auto first = std::lower_bound(m_Rows.begin(), m_Rows.end(), prefix,
+    [](const auto& a, const auto& b) {return a.m_Name < b;});
+  const auto last = std::partition_point(first, m_Rows.end(),
+    [&](const auto& a) {return a.m_Name.compare(0, prefix.size(), prefix) == 0;});
+
+  return {first - m_Rows.begin(), last - m_Rows.begin()};
+}
+
+std::shared_ptr<const wxExCTagsIndex> wxExCTagsIndex::Get(const std::string& path)
+{
+  auto& registry(GetRegistry());
+  const wxExStat stat(path);
+
+  // The file is loaded without holding the lock, so other lookups 
+  // continue, users of the same file wait for the load.
+  std::packaged_task<std::shared_ptr<const wxExCTagsIndex>()> task;
+  wxExCTagsIndexFuture load;
+
+  {
+    std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+    auto& it = registry.m_Loaded[path];
+
+    if (it.m_Reload.valid() &&
+        it.m_Reload.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+      if (const auto index(it.m_Reload.get()); index->IsOk())
+      {
+        it.m_Index = index;
+        it.m_ModificationTime = index->GetModificationTime();
+      }
+
+      it.m_Reload = wxExCTagsIndexFuture();
+    }
+
+    if (it.m_Index != nullptr)
+    {
+      if (
+        stat.IsOk() &&
+        stat.st_mtime != it.m_ModificationTime &&
+        !it.m_Reload.valid())
+      {
+        it.m_Reload = std::async(std::launch::async, [=] {
+          return std::make_shared<const wxExCTagsIndex>(path);}).share();
+      }
+
+      return it.m_Index;
+    }
+
+    if (it.m_Load.valid())
+    {
+      load = it.m_Load;
+    }
+    else if (!stat.IsOk())
+    {
+      registry.m_Loaded.erase(path);
+      return nullptr;
+    }
+    else
+    {
+      task = std::packaged_task<std::shared_ptr<const wxExCTagsIndex>()>([=] {
+        return std::make_shared<const wxExCTagsIndex>(path);});
+      load = it.m_Load = task.get_future().share();
+    }
+  }
+
+  if (task.valid())
+  {
+    task();
+
+    std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+    auto& it = registry.m_Loaded[path];
+    it.m_Load = wxExCTagsIndexFuture();
+
+    if (const auto index(load.get()); index->IsOk())
+    {
+      // A reload might have been done in the meantime.
+      if (it.m_Index == nullptr)
+      {
+        it.m_Index = index;
+        it.m_ModificationTime = index->GetModificationTime();
+      }
+    }
+    else if (it.m_Index == nullptr && !it.m_Reload.valid())
+    {
+      registry.m_Loaded.erase(path);
+    }
+  }
+
+  const auto& index(load.get());
+
+  return index->IsOk() ? index: nullptr;
+}
+
+const std::vector<uint32_t>* wxExCTagsIndex::GetClassRows(
+  const std::string& name) const
+{
+  if (const auto& id = m_StringIds.find(name); id != m_StringIds.end())
+  {
+    if (const auto& it = m_ClassRows.find(id->second); it != m_ClassRows.end())
+    {
+      return &it->second;
+    }
+  }
+
+  return nullptr;
+}
+
+const wxExCTagsIndex::wxExCTag wxExCTagsIndex::GetTag(size_t row) const
+{
+  wxExCTag tag;
+  Parse(std::string_view(m_Rows[row].m_Name.data(), m_Rows[row].m_Length), tag);
+
+  return tag;
+}
+
+uint32_t wxExCTagsIndex::Intern(const std::string_view& text)
+{
+  if (const auto& it = m_StringIds.find(text); it != m_StringIds.end())
+  {
+    return it->second;
+  }
+
+  m_Strings.emplace_back(text);
+  m_StringIds.insert({text, m_Strings.size() - 1});
+
+  return m_Strings.size() - 1;
+}
+
+bool wxExCTagsIndex::Reload(const std::string& path)
+{
+  const auto index(std::make_shared<const wxExCTagsIndex>(path));
+
+  if (!index->IsOk()) return false;
+
+  auto& registry(GetRegistry());
+
+  // A pending background reload might be older, it is discarded,
+  // after the lock is released, as it waits for the load to finish.
+  wxExCTagsIndexFuture pending;
+
+  {
+    std::lock_guard<std::mutex> lock(registry.m_Mutex);
+    auto& it = registry.m_Loaded[path];
+    it.m_Index = index;
+    it.m_ModificationTime = index->GetModificationTime();
+    pending = std::move(it.m_Reload);
+    it.m_Reload = wxExCTagsIndexFuture();
+  }
+
+  return true;
+}
+
+void wxExCTagsIndex::Load()
+{
+  const std::string_view text(*m_Contents.front());
+
+  m_Rows.reserve(std::count(text.begin(), text.end(), '\n') + 1);
+
+  AddRows(text);
+
+  // Tags files are mostly sorted already, but might be folded
+  // or unsorted, a stable sort keeps tags with the same name in file order.
+  if (!std::is_sorted(m_Rows.begin(), m_Rows.end(), RowLess))
+  {
+    std::stable_sort(m_Rows.begin(), m_Rows.end(), RowLess);
+  }
+
+  AddClassRows();
+}
+
+bool wxExCTagsIndex::Update(const std::string& path,
+  const std::map<std::string, std::vector<std::string>>& files)
+{
+  // Updates are done in turn, so none is lost.
+  static std::mutex update;
+  std::lock_guard<std::mutex> updating(update);
+
+  auto& registry(GetRegistry());
+  std::shared_ptr<const wxExCTagsIndex> current;
+
+  {
+    std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+    if (const auto& it = registry.m_Loaded.find(path);
+      it != registry.m_Loaded.end() && 
+      it->second.m_Index != nullptr && !it->second.m_Reload.valid())
+    {
+      current = it->second.m_Index;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  // The index is built without holding the lock, so lookups continue.
+  const std::shared_ptr<const wxExCTagsIndex> index(
+    new wxExCTagsIndex(*current, files));
+
+  std::lock_guard<std::mutex> lock(registry.m_Mutex);
+  auto& it = registry.m_Loaded[path];
+
+  // A reload might have been done in the meantime.
+  if (it.m_Index != current || it.m_Reload.valid())
+  {
+    return false;
+  }
+
+  it.m_Index = index;
+
+  return true;
+}
+
+void wxExCTagsIndex::Wait(const std::string& path)
+{
+  auto& registry(GetRegistry());
+  wxExCTagsIndexFuture reload;
+
+  {
+    std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+    if (const auto& it = registry.m_Loaded.find(path); 
+      it != registry.m_Loaded.end())
+    {
+      reload = it->second.m_Reload;
+    }
+  }
+
+  if (reload.valid())
+  {
+    reload.wait();
+  }
+}
+
+void wxExCTagsIndex::Written(const std::string& path)
+{
+  auto& registry(GetRegistry());
+  const wxExStat stat(path);
+
+  std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+  if (const auto& it = registry.m_Loaded.find(path);
+    stat.IsOk() && it != registry.m_Loaded.end() && 
+    it->second.m_Index != nullptr)
+  {
+    it->second.m_ModificationTime = stat.st_mtime;
+  }
+}
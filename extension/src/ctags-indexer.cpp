@@ -0,0 +1,615 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      ctags-indexer.cpp
+// Purpose:   Implementation of class wxExCTagsIndexer
+//            https://github.com/universal-ctags/ctags
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdio>
+#include <experimental/filesystem>
+#include <fstream>
+#include <sstream>
+#include <wx/extension/ctags-index.h>
+#include <wx/extension/ctags-indexer.h>
+#include <wx/extension/lexers.h>
+#include <wx/extension/log.h>
+#include <wx/extension/path.h>
+#include <wx/extension/stat.h>
+#include <wx/extension/util.h>
+#include <easylogging++.h>
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+#ifdef _MSC_VER
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace fs = std::experimental::filesystem;
+
+namespace
+{
+  const std::string PROGRAM_NAME("wxExCTagsIndexer");
+
+  // Max number of files passed to ctags at once.
+  const size_t BATCH_SIZE = 100;
+
+  // Min time between writing the tags file, if the shared index
+  // was updated.
+  const auto WRITE_DELAY = std::chrono::seconds(60);
+
+  // Returns the file field of a tag line.
+  const std::string_view FileField(const std::string_view& line)
+  {
+    const auto tab1 = line.find('\t');
+    if (tab1 == std::string_view::npos) return std::string_view();
+    const auto tab2 = line.find('\t', tab1 + 1);
+    if (tab2 == std::string_view::npos) return std::string_view();
+    return line.substr(tab1 + 1, tab2 - tab1 - 1);
+  }
+
+  // Returns the path quoted for the shell.
+  const std::string Quoted(const std::string& path)
+  {
+#ifdef _WIN32
+    return "\"" + path + "\"";
+#else
+    std::string quoted("'");
+
+    for (const auto c : path)
+    {
+      if (c == '\'') quoted += "'\\''";
+      else quoted += c;
+    }
+
+    return quoted + "'";
+#endif
+  }
+
+  // Returns true if the file or directory is hidden, 
+  // or is a version control directory.
+  bool Skip(const fs::path& path)
+  {
+    const auto name(path.filename().string());
+    return (!name.empty() && name[0] == '.') || name == "CVS";
+  }
+}
+
+wxExCTagsIndexer* wxExCTagsIndexer::m_Self = nullptr;
+
+wxExCTagsIndexer::wxExCTagsIndexer(const std::string& tags, int threads)
+  : m_TagsFile(wxExPath(tags).MakeAbsolute().Path().string())
+  , m_ManifestFile(m_TagsFile + ".manifest")
+{
+  for (int i = 0; i < std::max(threads, 1); i++)
+  {
+    m_Threads.emplace_back(&wxExCTagsIndexer::Run, this);
+  }
+}
+
+wxExCTagsIndexer::~wxExCTagsIndexer()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+
+  m_Condition.notify_all();
+  m_Idle.notify_all();
+
+  for (auto& it : m_Threads)
+  {
+    it.join();
+  }
+
+  // Keep files already indexed, so next time these are not indexed again.
+  if (m_Changed)
+  {
+    Write();
+  }
+}
+
+void wxExCTagsIndexer::Add(const std::string& path, const std::string& patterns)
+{
+  if (path.empty()) return;
+
+  const auto fullpath(wxExPath(path).MakeAbsolute().Path().string());
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (!m_Queued.insert(fullpath).second) return;
+
+    std::error_code ec;
+    m_Queue.push_back({fullpath, patterns, false, fs::is_directory(fullpath, ec)});
+  }
+
+  m_Condition.notify_one();
+}
+
+void wxExCTagsIndexer::Expand(const wxExCTagsIndexerItem& item)
+{
+  const auto* lexers = wxExLexers::Get(false);
+  std::vector<std::string> files;
+  std::error_code ec;
+
+  for (auto it = fs::recursive_directory_iterator(item.m_Path, ec);
+    !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+  {
+    std::error_code status;
+
+    if (Skip(it->path()))
+    {
+      if (fs::is_directory(it->status(status))) it.disable_recursion_pending();
+    }
+    else if (
+      fs::is_regular_file(it->status(status)) && 
+      (item.m_Patterns.empty() ||
+       wxExMatchesOneOf(it->path().filename().string(), item.m_Patterns)) &&
+      (lexers == nullptr ||
+       lexers->FindByFileName(it->path().filename().string()).IsOk()))
+    {
+      files.emplace_back(it->path().string());
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  for (const auto& file : files)
+  {
+    if (m_Queued.insert(file).second)
+    {
+      m_Queue.push_back({file, std::string(), false, false});
+    }
+  }
+
+  m_Condition.notify_all();
+}
+
+wxExCTagsIndexer* wxExCTagsIndexer::Get(bool createOnDemand)
+{
+  if (m_Self == nullptr && createOnDemand)
+  {
+    m_Self = new wxExCTagsIndexer(wxExConfigDir() + "/projects.tags");
+  }
+
+  return m_Self;
+}
+
+bool wxExCTagsIndexer::Index(
+  const std::vector<std::string>& paths, 
+  std::map<std::string, std::vector<std::string>>& lines)
+{
+#ifdef _WIN32
+  const std::string null("NUL");
+#else
+  const std::string null("/dev/null");
+#endif
+
+  // The files are passed using a list file, as popen
+  // cannot write and read the same pipe.
+  const std::string list(m_TagsFile + ".list" + 
+    std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())));
+
+  if (std::ofstream ofs(list); ofs.is_open())
+  {
+    for (const auto& path : paths)
+    {
+      ofs << path << "\n";
+      lines[path];
+    }
+  }
+  else
+  {
+    return false;
+  }
+
+  const std::string command("ctags -f - --fields=+aS --sort=no -L " +
+    Quoted(list) + " 2>" + null);
+
+  FILE* fp = popen(command.c_str(), "r");
+
+  if (fp == nullptr)
+  {
+    std::error_code ec;
+    fs::remove(list, ec);
+    return false;
+  }
+
+  const auto add = [&](const std::string& line) {
+    if (line.compare(0, 6, "!_TAG_") != 0)
+    {
+      if (const auto& it = lines.find(std::string(FileField(line)));
+        it != lines.end())
+      {
+        it->second.emplace_back(line);
+      }
+    }};
+
+  char buffer[4096];
+  std::string line;
+
+  while (fgets(buffer, sizeof(buffer), fp) != nullptr)
+  {
+    line += buffer;
+
+    if (line.back() != '\n') continue;
+
+    line.pop_back();
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+
+    add(line);
+
+    line.clear();
+  }
+
+  if (!line.empty())
+  {
+    add(line);
+  }
+
+  const auto result = pclose(fp);
+
+  std::error_code ec;
+  fs::remove(list, ec);
+
+  if (result != 0)
+  {
+    if (std::lock_guard<std::mutex> lock(m_Mutex); !m_Missing)
+    {
+      // Most likely ctags is not installed, log only once.
+      m_Missing = true;
+      wxExLog() << "could not run ctags on:" << paths.front() << 
+        "and" << paths.size() - 1 << "other files";
+    }
+
+    return false;
+  }
+
+  return true;
+}
+
+void wxExCTagsIndexer::Load()
+{
+  std::ifstream manifest(m_ManifestFile);
+  std::ifstream tags(m_TagsFile);
+
+  if (!manifest.is_open() || !tags.is_open())
+  {
+    return;
+  }
+
+  std::map<std::string, wxExCTagsIndexerFile> files;
+  std::map<std::string, std::vector<std::string>> lines;
+  std::string line;
+  bool ours = false;
+
+  // Each manifest line contains modification time, size and path.
+  while (std::getline(manifest, line))
+  {
+    std::istringstream is(line);
+    wxExCTagsIndexerFile file;
+    std::string path;
+
+    if (is >> file.m_ModificationTime >> file.m_Size &&
+        is.get() == '\t' && std::getline(is, path))
+    {
+      files.insert({path, file});
+    }
+  }
+
+  while (std::getline(tags, line))
+  {
+    if (line.compare(0, 6, "!_TAG_") == 0)
+    {
+      if (line == "!_TAG_PROGRAM_NAME\t" + PROGRAM_NAME + "\t//") ours = true;
+    }
+    else if (!ours)
+    {
+      // Another program wrote the tags file, index all files again.
+      return;
+    }
+    else if (const auto& it = files.find(std::string(FileField(line)));
+      it != files.end())
+    {
+      lines[it->first].emplace_back(line);
+    }
+  }
+
+  if (ours)
+  {
+    for (auto& it : files)
+    {
+      it.second.m_Lines = std::make_shared<const std::vector<std::string>>(
+        std::move(lines[it.first]));
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Files indexed while loading are more recent.
+    m_Files.merge(files);
+
+    VLOG(9) << "ctags indexer loaded: " << m_Files.size() << " files";
+  }
+}
+
+void wxExCTagsIndexer::Run()
+{
+#ifdef __linux__
+  // The nice value is per thread, and inherited by ctags.
+  setpriority(PRIO_PROCESS, 0, 10);
+#endif
+
+  std::call_once(m_Loaded, &wxExCTagsIndexer::Load, this);
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
+  while (true)
+  {
+    m_Condition.wait(lock, [&] {return m_Stop || !m_Queue.empty();});
+
+    if (m_Stop) return;
+
+    const auto item(m_Queue.front());
+    m_Queue.pop_front();
+    m_Queued.erase(item.m_Path);
+    m_Busy++;
+
+    if (item.m_IsDirectory)
+    {
+      lock.unlock();
+      Expand(item);
+      lock.lock();
+    }
+    else
+    {
+      std::vector<wxExCTagsIndexerItem> batch{item};
+
+      while (
+        batch.size() < BATCH_SIZE && 
+        !m_Queue.empty() && !m_Queue.front().m_IsDirectory)
+      {
+        batch.emplace_back(m_Queue.front());
+        m_Queue.pop_front();
+        m_Queued.erase(batch.back().m_Path);
+      }
+
+      lock.unlock();
+
+      std::vector<wxExStat> stats;
+
+      for (const auto& it : batch)
+      {
+        stats.emplace_back(it.m_Path);
+      }
+
+      lock.lock();
+
+      std::vector<size_t> index;
+      std::vector<std::string> paths;
+      // Files with new tags, or removed, for the shared index.
+      std::map<std::string, std::vector<std::string>> update;
+
+      for (size_t i = 0; i < batch.size(); i++)
+      {
+        const auto& path(batch[i].m_Path);
+        const auto& stat(stats[i]);
+        const auto& it = m_Files.find(path);
+        const auto& failed = m_Failed.find(path);
+
+        if (!stat.IsOk())
+        {
+          if (it != m_Files.end())
+          {
+            m_Files.erase(it);
+            m_Changed = true;
+            update[path];
+          }
+
+          if (failed != m_Failed.end())
+          {
+            m_Failed.erase(failed);
+          }
+        }
+        else if (batch[i].m_Force || (
+          (it == m_Files.end() ||
+           it->second.m_ModificationTime != stat.st_mtime ||
+           it->second.m_Size != (long)stat.st_size) &&
+          (failed == m_Failed.end() || failed->second != stat.st_mtime)))
+        {
+          index.emplace_back(i);
+          paths.emplace_back(path);
+        }
+      }
+
+      lock.unlock();
+
+      std::map<std::string, std::vector<std::string>> lines;
+      const bool indexed = !paths.empty() && Index(paths, lines);
+
+      lock.lock();
+
+      for (const auto i : index)
+      {
+        const auto& path(batch[i].m_Path);
+        const auto& stat(stats[i]);
+
+        if (indexed)
+        {
+          update[path] = lines[path];
+          m_Files[path] = {stat.st_mtime, (long)stat.st_size, 
+            std::make_shared<const std::vector<std::string>>(
+              std::move(lines[path]))};
+          m_Failed.erase(path);
+          m_Changed = true;
+        }
+        else
+        {
+          m_Failed[path] = stat.st_mtime;
+        }
+      }
+
+      if (!update.empty())
+      {
+        lock.unlock();
+        const bool updated = wxExCTagsIndex::Update(m_TagsFile, update);
+        lock.lock();
+
+        // If not updated, or a reload might not have these tags,
+        // the tags file is written and reloaded.
+        if (!updated || m_Reloading)
+        {
+          m_Changed = true;
+          m_Stale = true;
+        }
+      }
+    }
+
+    // The last busy thread writes the tags, without holding the lock,
+    // and writes again if the tags were changed meanwhile.
+    while (m_Queue.empty() && m_Busy == 1 && m_Changed && (m_Stale ||
+      std::chrono::steady_clock::now() - m_Written >= WRITE_DELAY))
+    {
+      lock.unlock();
+      Write();
+      lock.lock();
+    }
+
+    m_Busy--;
+
+    if (m_Queue.empty() && m_Busy == 0)
+    {
+      m_Idle.notify_all();
+    }
+  }
+}
+
+wxExCTagsIndexer* wxExCTagsIndexer::Set(wxExCTagsIndexer* indexer)
+{
+  wxExCTagsIndexer* old = m_Self;
+  m_Self = indexer;
+  return old;
+}
+
+bool wxExCTagsIndexer::Update(const std::string& path)
+{
+  const auto fullpath(wxExPath(path).MakeAbsolute().Path().string());
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (
+      m_Files.find(fullpath) == m_Files.end() && 
+      m_Failed.find(fullpath) == m_Failed.end())
+    {
+      return m_Queued.find(fullpath) != m_Queued.end();
+    }
+
+    // A saved file is indexed before all others.
+    if (m_Queued.insert(fullpath).second)
+    {
+      m_Queue.push_front({fullpath, std::string(), true, false});
+    }
+  }
+
+  m_Condition.notify_one();
+
+  return true;
+}
+
+void wxExCTagsIndexer::Wait()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
+  m_Idle.wait(lock, [&] {return m_Stop || (m_Queue.empty() && m_Busy == 0);});
+}
+
+void wxExCTagsIndexer::Write()
+{
+  // Writers take a copy in turn, so the last copy is written last.
+  std::lock_guard<std::mutex> write(m_WriteMutex);
+  std::map<std::string, wxExCTagsIndexerFile> files;
+  bool reload = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    
+    if (!m_Changed) return;
+
+    files = m_Files;
+    reload = m_Stale;
+    m_Changed = false;
+    m_Reloading = m_Stale;
+    m_Stale = false;
+  }
+
+  std::vector<const std::string*> lines;
+
+  for (const auto& it : files)
+  {
+    for (const auto& line : *it.second.m_Lines)
+    {
+      lines.emplace_back(&line);
+    }
+  }
+
+  std::sort(lines.begin(), lines.end(),
+    [](const auto* a, const auto* b) {return *a < *b;});
+
+  // Write to a temporary file first, so readers never see a partial file.
+  std::error_code ec;
+
+  if (std::ofstream ofs(m_TagsFile + ".tmp"); ofs.is_open())
+  {
+    ofs <<
+      "!_TAG_FILE_FORMAT\t2\t/extended format/\n"
+      "!_TAG_FILE_SORTED\t1\t/0=unsorted, 1=sorted, 2=foldcase/\n"
+      "!_TAG_PROGRAM_NAME\t" << PROGRAM_NAME << "\t//\n";
+
+    for (const auto* line : lines)
+    {
+      ofs << *line << "\n";
+    }
+  }
+
+  fs::rename(m_TagsFile + ".tmp", m_TagsFile, ec);
+
+  if (ec)
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Reloading = false;
+    wxExLog() << "could not write ctags file:" << m_TagsFile;
+    return;
+  }
+
+  if (std::ofstream ofs(m_ManifestFile + ".tmp"); ofs.is_open())
+  {
+    for (const auto& it : files)
+    {
+      ofs << it.second.m_ModificationTime << "\t" << it.second.m_Size << "\t" <<
+        it.first << "\n";
+    }
+  }
+
+  fs::rename(m_ManifestFile + ".tmp", m_ManifestFile, ec);
+
+  // The shared index already has the tags, unless it could not be updated.
+  if (reload)
+  {
+    wxExCTagsIndex::Reload(m_TagsFile);
+  }
+  else
+  {
+    wxExCTagsIndex::Written(m_TagsFile);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Reloading = false;
+    m_Written = std::chrono::steady_clock::now();
+  }
+
+  VLOG(9) << "ctags indexer written: " << lines.size() << " tags";
+}
@@ -13,6 +13,8 @@
 #include <wx/config.h>
 #include <wx/log.h>
 #include <wx/extension/ctags.h>
+#include <wx/extension/ctags-index.h>
+#include <wx/extension/ctags-indexer.h>
 #include <wx/extension/ex.h>
 #include <wx/extension/frd.h>
 #include <wx/extension/log.h>
@@ -21,7 +23,6 @@
 #include <wx/extension/stc.h>
 #include <wx/extension/util.h>
 #include <easylogging++.h>
-#include <readtags.h>
 
 enum wxExImageAccessType
 {
@@ -36,12 +37,12 @@ class wxExCTagsInfo
 {
 public:
   // Constructor.
-  wxExCTagsInfo(const tagEntry& entry)
-    : m_LineNumber(entry.address.lineNumber)
-    , m_Path(entry.file)
-    , m_Pattern(entry.address.pattern != nullptr ? 
+  wxExCTagsInfo(const wxExCTagsIndex::wxExCTag& tag)
+    : m_LineNumber(tag.m_LineNumber)
+    , m_Path(std::string(tag.m_File))
+    , m_Pattern(!tag.m_Pattern.empty() ? 
       // prepend colon to force ex command
-      ":" + std::string(entry.address.pattern): std::string()) {
+      ":" + std::string(tag.m_Pattern): std::string()) {
     // replace any * with ., somehow the pattern generated by
     // ctags mixes regex with non regex....
     std::replace(m_Pattern.begin(), m_Pattern.end(), '*', '.');};
@@ -64,66 +65,6 @@ private:
   std::string m_Pattern;
 };
 
-void SetImage(const tagEntry& entry, wxExImageAccessType& image)
-{
-  if (const char* value = tagsField(&entry, "access"); value != nullptr)
-  {
-    if (strcmp(value, "public") == 0)
-    {
-      image = IMAGE_PUBLIC;
-    }
-    else if (strcmp(value, "protected") == 0)
-    {
-      image = IMAGE_PROTECTED;
-    }
-    else if (strcmp(value, "private") == 0)
-    {
-      image = IMAGE_PRIVATE;
-    }
-  }
-}
-
-bool Compare(const tagEntry& entry, 
-  const std::string& text, const std::string& field)
-{
-  const char* value = tagsField(&entry, field.c_str());
-  return 
-    value != nullptr && strcmp(text.c_str(), value) == 0;
-}
-
-const std::string Filtered(
-  const tagEntry& entry, 
-  const wxExCTagsEntry& filter, 
-  wxExImageAccessType& image)
-{
-  if (!filter.Active()) return entry.name;
-
-  if (!filter.Kind().empty())
-  { 
-    if (entry.kind == nullptr || strcmp(filter.Kind().c_str(), entry.kind) != 0)
-    {
-      return std::string();
-    }
-  }
-
-  if (!filter.Access().empty() && !Compare(entry, filter.Access(), "access"))
-  {
-    return std::string();
-  }
-
-  if (!filter.Class().empty() && !Compare(entry, filter.Class(), "class"))
-  {
-    return std::string();
-  }
-
-  if (!filter.Signature().empty() && !Compare(entry, filter.Signature(), "signature"))
-  {
-    return std::string();
-  }
-
-  return entry.name;
-}
-
 std::map< std::string, wxExCTagsInfo > wxExCTags::m_Matches;
 std::map< std::string, wxExCTagsInfo >::iterator wxExCTags::m_Iterator;
 
@@ -142,12 +83,7 @@ wxExCTags::wxExCTags(wxExFrame* frame)
   Init(DEFAULT_TAGFILE);
 }
 
-wxExCTags::~wxExCTags()
-{
-  tagsClose(m_File);
-}
-
-std::string skipConst(const char* text)
+std::string skipConst(const std::string& text)
 {
   if (std::vector<std::string> v; wxExMatch("(.*) *const$", text, v) == 1)
     return v[0];
@@ -158,63 +94,68 @@ std::string skipConst(const char* text)
 std::string wxExCTags::AutoComplete(
   const std::string& text, const wxExCTagsEntry& filter)
 {
-  if (m_File == nullptr) return std::string();
-
-  tagEntry entry;
-  
-  if (text.empty())
-  { 
-    if (tagsFirst(m_File, &entry) == TagFailure)
-    {
-      return std::string();
-    }
-  }
-  else if (tagsFind(
-    m_File, 
-    &entry, 
-    text.c_str(), TAG_PARTIALMATCH | TAG_OBSERVECASE) == TagFailure)
-  {
-    return std::string();
-  }
+  const auto index(wxExCTagsIndex::Get(m_Path));
 
-  std::string s, prev_tag;
-
-  const int max{100};
-  int count {0};
-  tagResult result = TagSuccess;
+  if (index == nullptr) return std::string();
 
   if (!m_Prepare)
   {
     AutoCompletePrepare();
   }
 
-  do
-  {
-    wxExImageAccessType image = IMAGE_NONE;
+  std::string s;
+  std::string_view prev_tag;
 
-    if (const auto tag(Filtered(entry, filter, image)); !tag.empty() && 
-      tag != prev_tag)
+  const int max{100};
+  int count {0};
+
+  const auto add = [&](size_t row) {
+    if (const auto& name(index->GetName(row)); 
+      name != prev_tag && index->Filter(row, filter))
     {
+      const auto tag(index->GetTag(row));
+
       if (!s.empty()) s.append(std::string(1, m_Separator));
 
-      s.append(tag);
+      s.append(name);
       count++;
 
-      SetImage(entry, image);
-
       if (filter.Kind() == "f")
       {
-        s.append(skipConst(tagsField(&entry, "signature")));
+        s.append(skipConst(std::string(tag.m_Signature)));
       }
 
-      s.append(image != IMAGE_NONE ? "?" + std::to_string(image): std::string());
+      // The access types are registered as images.
+      s.append(tag.m_Access != wxExCTagsIndex::ACCESS_NONE ? 
+        "?" + std::to_string(tag.m_Access): std::string());
+
+      prev_tag = name;
+    }
+
+    return count < max;};
+
+  if (text.empty() && !filter.Class().empty())
+  {
+    if (const auto* rows = index->GetClassRows(filter.Class()); rows != nullptr)
+    {
+      for (auto it = rows->begin(); it != rows->end() && add(*it); ++it);
+    }
+  }
+  else
+  {
+    const auto range(text.empty() ? 
+      std::make_pair((size_t)0, index->GetSize()): index->FindPrefix(text));
 
-      prev_tag = tag;
-    } 
+    for (auto row = range.first; row < range.second && add(row); row++);
 
-    result = (text.empty() ?
-      tagsNext(m_File, &entry): tagsFindNext(m_File, &entry));
-  } while (result == TagSuccess && count < max);
+    if (count < max && !text.empty() &&
+      wxConfigBase::Get()->ReadBool(_("vi tag fuzzy"), false))
+    {
+      index->FindFuzzy(text, [&](size_t row) {
+        return index->GetName(row).compare(0, text.size(), text) == 0 || 
+          add(row);});
+    }
+  }
 
   VLOG(9) << "ctags AutoComplete: " << count;
 
@@ -236,16 +177,18 @@ void wxExCTags::AutoCompletePrepare()
 
 bool wxExCTags::Find(const std::string& tag)
 {
-  if (m_File == nullptr) return false;
+  const auto index(wxExCTagsIndex::Get(m_Path));
+
+  if (index == nullptr) return false;
 
   if (tag.empty())
   {
     return Next();
   }
 
-  tagEntry entry;
-  
-  if (tagsFind(m_File, &entry, tag.c_str(), TAG_FULLMATCH) == TagFailure)
+  const auto range(index->Find(tag));
+
+  if (range.first == range.second)
   {
     wxLogStatus("tag not found: " + wxString(tag));
     return false;
@@ -253,11 +196,11 @@ bool wxExCTags::Find(const std::string& tag)
   
   m_Matches.clear();
 
-  do
+  for (auto row = range.first; row < range.second; row++)
   {
-    const wxExCTagsInfo ct(entry);
+    const wxExCTagsInfo ct(index->GetTag(row));
     m_Matches.insert({ct.GetName(), ct});
-  } while (tagsFindNext(m_File, &entry) == TagSuccess);
+  }
 
   m_Iterator = m_Matches.begin();
 
@@ -289,59 +232,60 @@ bool wxExCTags::Find(const std::string& tag)
   return true;
 }  
 
-bool Master(const tagEntry& entry)
+bool Master(const wxExCTagsIndex::wxExCTag& tag)
 {
-  return entry.kind != nullptr && 
-     ((strcmp(entry.kind, "c") == 0) ||
-      (strcmp(entry.kind, "e") == 0) ||
-      (strcmp(entry.kind, "m") == 0));
+  return tag.m_Kind == "c" || tag.m_Kind == "e" || tag.m_Kind == "m";
 }
 
 bool wxExCTags::Find(const std::string& tag, 
   wxExCTagsEntry& current,
   wxExCTagsEntry& filter) const
 {
-  if (m_File == nullptr) return false;
+  const auto index(wxExCTagsIndex::Get(m_Path));
+
+  if (index == nullptr) return false;
 
-  tagEntry entry;
+  // The first entry determines which kind of filter will be set.
+  const auto range(index->Find(tag));
 
-  // Find first entry. This entry determines which kind of
-  // filter will be set.
-  if (tagsFind(m_File, &entry, tag.c_str(), TAG_FULLMATCH) == TagFailure)
+  if (range.first == range.second)
   {
     return false;
   }
 
   filter.Clear();
 
-  do 
+  for (auto row = range.first; row < range.second; row++)
   {
-    current.Kind(entry.kind).Class(entry.name);
+    const auto entry(index->GetTag(row));
 
-    if (const char* value = tagsField(&entry, "signature"); value != nullptr)
+    current.Kind(std::string(entry.m_Kind)).Class(std::string(entry.m_Name));
+
+    if (!entry.m_Signature.empty())
     {
-      current.Signature(value);
+      current.Signature(std::string(entry.m_Signature));
     }
 
     // If this is not a master entry find next.
     if (Master(entry))
     {
       // Set filter for member functions for this member or class.
-      if (strcmp(entry.kind, "m") == 0)
+      if (entry.m_Kind == "m")
       {
-        if (const char* value = tagsField(&entry, "typeref"); value != nullptr)
+        if (!entry.m_Typeref.empty())
         {
-          filter.Kind("f").Class(wxExBefore(wxExAfter(value, ':'), ' '));
+          filter.Kind("f").Class(
+            wxExBefore(wxExAfter(std::string(entry.m_Typeref), ':'), ' '));
         }
       }
       else 
       {
-        filter.Kind("f").Class(entry.name);
+        filter.Kind("f").Class(std::string(entry.m_Name));
       }
 
       return true;
     }
-  } while (!Master(entry) && tagsFindNext(m_File, &entry) == TagSuccess);
+  }
 
   return false;
 }
@@ -371,7 +315,13 @@ void wxExCTags::Init(const std::string& filename)
       }
     }
 
-    if (filename != DEFAULT_TAGFILE && m_File == nullptr)
+    // Otherwise use the tags generated for the projects,
+    // even if not yet available, it is used as soon as it is.
+    if (filename == DEFAULT_TAGFILE)
+    {
+      m_Path = wxExCTagsIndexer::Get()->GetTagsFile();
+    }
+    else if (filename != DEFAULT_TAGFILE && m_Path.empty())
     {
       VLOG(9) << "could not locate ctags file:" << filename;
     }
@@ -398,9 +348,12 @@ bool wxExCTags::Next()
 
 bool wxExCTags::Open(const std::string& path, bool show_error)
 {
-  if (tagFileInfo info; (m_File = tagsOpen(path.c_str(), &info)) != nullptr)
+  // The index is shared using the absolute path.
+  if (const auto fullpath(wxExPath(path).MakeAbsolute().Path().string());
+    wxExCTagsIndex::Get(fullpath) != nullptr)
   {
-    VLOG(9) << "ctags file: " << path;
+    m_Path = fullpath;
+    VLOG(9) << "ctags file: " << m_Path;
     return true;
   }
   else if (show_error)
@@ -21,6 +21,7 @@
 #include <wx/extension/menu.h>
 #include <wx/extension/menus.h>
 #include <wx/extension/process.h>
+#include <wx/extension/regex-cache.h>
 #include <wx/extension/shell.h>
 #include <wx/extension/stc.h>
 #include <wx/extension/tokenizer.h>
@@ -241,11 +242,19 @@ void wxExDebug::ProcessStdIn(const std::string& text)
 
 void wxExDebug::ProcessStdOut(const std::string& text)
 {
+  // Called for each line of output, so use compiled regex.
+  static const auto re_break_file(wxExRegexCache::Get(
+    "Breakpoint ([0-9]+) at 0x[0-9a-f]+: file (.*), line ([0-9]+)"));
+  static const auto re_break(wxExRegexCache::Get(
+    "Breakpoint ([0-9]+) at 0x[0-9a-f]+: (.*):([0-9]+)"));
+  static const auto re_at(wxExRegexCache::Get("at (.*):([0-9]+)"));
+  static const auto re_line(wxExRegexCache::Get("^([0-9]+)"));
+
   wxExControlData data;
 
   if (std::vector<std::string> v;
-    wxExMatch("Breakpoint ([0-9]+) at 0x[0-9a-f]+: file (.*), line ([0-9]+)", text, v) == 3 || 
-    wxExMatch("Breakpoint ([0-9]+) at 0x[0-9a-f]+: (.*):([0-9]+)", text, v) == 3)
+    wxExMatch(*re_break_file, text, v) == 3 || 
+    wxExMatch(*re_break, text, v) == 3)
   {
     wxExPath filename(v[1]);
     filename.MakeAbsolute();
@@ -261,12 +270,12 @@ void wxExDebug::ProcessStdOut(const std::string& text)
     }
   }
   else if (DeleteAllBreakpoints(text)) {}
-  else if (wxExMatch("at (.*):([0-9]+)", text, v) > 1)
+  else if (wxExMatch(*re_at, text, v) > 1)
   {
     m_Path = wxExPath(v[0]).MakeAbsolute();
     data.Line(std::stoi(v[1]));
   }
-  else if (wxExMatch("^([0-9]+)", text, v) > 0)
+  else if (wxExMatch(*re_line, text, v) > 0)
   {
     data.Line(std::stoi(v[0]));
   }
@@ -12,6 +12,7 @@
 #endif
 #include <wx/extension/dir.h>
 #include <wx/extension/frame.h>
+#include <wx/extension/glob.h>
 #include <wx/extension/log.h>
 #include <wx/extension/util.h>
 #include <easylogging++.h>
@@ -79,21 +80,23 @@ wxExDir::wxExDir(const wxExPath& dir, const std::string& filespec, int flags)
 {
 }
 
-bool Handle(const fs::directory_entry& e, wxExDir* dir, int& matches)
+bool Handle(const fs::directory_entry& e, wxExDir* dir, const wxExGlob& glob, 
+  int& matches)
 {
-  if (fs::is_regular_file(e.path()))
+  // One stat for each entry, it is kept by the path that is handled.
+  if (const wxExStat stat(e.path().string()); stat.IsRegularFile())
   {
     if ((dir->GetFlags() & DIR_FILES) && 
-      wxExMatchesOneOf(e.path().filename().string(), dir->GetFileSpec()))
+      glob.Matches(e.path().filename().string()))
     {
-      dir->OnFile(e.path());
+      dir->OnFile(wxExPath(e.path(), stat));
       matches++;
     }
   }
-  else if ((dir->GetFlags() & DIR_DIRS) && fs::is_directory(e.path()) &&
-    wxExMatchesOneOf(e.path().filename().string(), dir->GetFileSpec()))
+  else if ((dir->GetFlags() & DIR_DIRS) && stat.IsDirectory() &&
+    glob.Matches(e.path().filename().string()))
   {
-    dir->OnDir(e.path());
+    dir->OnDir(wxExPath(e.path(), stat));
   }
 
   return !wxExInterruptable::Cancelled();
@@ -115,8 +118,11 @@ int wxExDir::FindFiles()
 
   VLOG(9) << "iterating: " << m_Dir.Path() << " on: " << m_FileSpec << " flags: " << m_Flags;
 
+  const wxExGlob glob(m_FileSpec);
   int matches = 0;
 
+  FindFilesBegin();
+
   try
   {
     if (m_Flags & DIR_RECURSIVE)
@@ -130,14 +136,14 @@ int wxExDir::FindFiles()
       
       for (const auto& p: fs::recursive_directory_iterator(m_Dir.Path(), options))
       {
-        if (!Handle(p, this, matches)) break;
+        if (!Handle(p, this, glob, matches)) break;
       }
     }
     else
     {
       for (const auto& p: fs::directory_iterator(m_Dir.Path()))
       {
-        if (!Handle(p, this, matches)) break;
+        if (!Handle(p, this, glob, matches)) break;
       }
     }
   }
@@ -146,6 +152,8 @@ int wxExDir::FindFiles()
     wxExLog(e) << "filesystem";
   }
 
+  FindFilesEnd();
+
   Stop();
 
   return matches;
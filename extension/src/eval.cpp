@@ -59,7 +59,12 @@ std::tuple<double, int, std::string> wxExEvaluator::Eval(wxExEx* ex, const std::
       ex->GetCommand().STC()->GetCurrentLine() + 1));
   }
   
-  // Replace $ with line count.
+  // Replace $ with line count, in hex mode all lines are needed.
+  if (expr.find('$') != std::string::npos)
+  {
+    ex->GetCommand().STC()->GetHexMode().RenderAll();
+  }
+
   wxExReplaceAll(expr, "$", 
     std::to_string(ex->GetCommand().STC()->GetLineCount()));
   
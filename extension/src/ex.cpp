@@ -6,6 +6,7 @@
 // Copyright: (c) 2018 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <regex>
@@ -89,230 +90,234 @@ wxExEvaluator wxExEx::m_Evaluator;
 wxExSTCEntryDialog* wxExEx::m_Dialog = nullptr;
 wxExViMacros wxExEx::m_Macros;
 
-wxExEx::wxExEx(wxExSTC* stc)
-  : m_Command(wxExExCommand(stc))
-  , m_CTags(new wxExCTags(this))
-  , m_Frame(wxDynamicCast(wxTheApp->GetTopWindow(), wxExManagedFrame))
-  , m_Commands {
-    {":ab", [&](const std::string& command) {
-      return HandleContainer<std::string, std::map<std::string, std::string>>(
-        "Abbreviations", command, &m_Macros.GetAbbreviations(),
-        [=](const std::string& name, const std::string& value) {
-          m_Macros.SetAbbreviation(name, value);return true;});}},
+// The commands, sorted on name, a command is handled by
+// the longest name it starts with.
+const std::vector<std::pair<
+  const std::string, 
+  bool (*)(wxExEx* ex, const std::string& command)>> wxExEx::m_Commands {
+  {":ab", [](wxExEx* ex, const std::string& command) {
+    return ex->HandleContainer<std::string, std::map<std::string, std::string>>(
+      "Abbreviations", command, &m_Macros.GetAbbreviations(),
+      [=](const std::string& name, const std::string& value) {
+        m_Macros.SetAbbreviation(name, value);return true;});}},
 #if wxCHECK_VERSION(3,1,0)
-    {":ar", [&](const std::string& command) {
-      wxString text;
-      for (size_t i = 1; i < wxTheApp->argv.GetArguments().size(); i++)
-      {
-        text << wxTheApp->argv.GetArguments()[i] << "\n";
-      }
-      if (!text.empty()) ShowDialog("ar", text.ToStdString());
-      return true;}},
+  {":ar", [](wxExEx* ex, const std::string& command) {
+    wxString text;
+    for (size_t i = 1; i < wxTheApp->argv.GetArguments().size(); i++)
+    {
+      text << wxTheApp->argv.GetArguments()[i] << "\n";
+    }
+    if (!text.empty()) ex->ShowDialog("ar", text.ToStdString());
+    return true;}},
 #endif
-    {":chd", [&](const std::string& command) {
-      if (command.find(" ") == std::string::npos) return true;
-      wxExPath::Current(wxExFirstOf(command, " ")); return true;}},
-    {":close", [&](const std::string& command) {POST_COMMAND( wxID_CLOSE ) return true;}},
-    {":de", [&](const std::string& command) {
-      m_Frame->GetDebug()->Execute(wxExFirstOf(command, " "), m_Command.STC());
-      return true;}},
-    {":e", [&](const std::string& command) {POST_COMMAND( wxID_OPEN ) return true;}},
-    {":f", [&](const std::string& command) {InfoMessage(); return true;}},
-    {":grep", [&](const std::string& command) {POST_COMMAND( ID_TOOL_REPORT_FIND ) return true;}},
-    {":gt", [&](const std::string& command) {return m_Command.STC()->LinkOpen();}},
-    {":help", [&](const std::string& command) {POST_COMMAND( wxID_HELP ) return true;}},
-    {":map", [&](const std::string& command) {
-      switch (ParseCommandWithArg(command))
-      {
-        case wxExCommandArg::INT:
-          // TODO: at this moment you cannot set KEY_CONTROL
-          return HandleContainer<int, wxExViMacrosMapType>(
-            "Map", command, nullptr,
-            [=](const std::string& name, const std::string& value) {
-              m_Macros.SetKeyMap(name, value);return true;}); 
-        break;
-        case wxExCommandArg::NONE: ShowDialog("Maps", 
-            "[String map]\n" +
-            ReportContainer<std::string, std::map<std::string, std::string>>(m_Macros.GetMap()) +
-            "[Key map]\n" +
-            ReportContainer<int, wxExViMacrosMapType>(m_Macros.GetKeysMap()) +
-            "[Alt key map]\n" +
-            ReportContainer<int, wxExViMacrosMapType>(m_Macros.GetKeysMap(KEY_ALT)) +
-            "[Control key map]\n" +
-            ReportContainer<int, wxExViMacrosMapType>(m_Macros.GetKeysMap(KEY_CONTROL)), 
-            true);
-          return true;
-        break;
-        case wxExCommandArg::OTHER:
-          return HandleContainer<std::string, std::map<std::string, std::string>>(
-            "Map", command, nullptr,
-            [=](const std::string& name, const std::string& value) {
-              m_Macros.SetMap(name, value);return true;});
-      }
-      return false;}},
-    {":new", [&](const std::string& command) {POST_COMMAND( wxID_NEW ) return true;}},
-    {":print", [&](const std::string& command) {m_Command.STC()->Print(command.find(" ") == std::string::npos); return true;}},
-    {":pwd", [&](const std::string& command) {wxExLogStatus(wxExPath::Current()); return true;}},
-    {":q!", [&](const std::string& command) {POST_CLOSE( wxEVT_CLOSE_WINDOW, false ) return true;}},
-    {":q", [&](const std::string& command) {POST_CLOSE( wxEVT_CLOSE_WINDOW, true ) return true;}},
-    {":reg", [&](const std::string& command) {
-      ShowDialog("Registers", m_Evaluator.GetInfo(this), true);
-      return true;}},
-    {":sed", [&](const std::string& command) {POST_COMMAND( ID_TOOL_REPLACE ) return true;}},
-    {":set", [&](const std::string& command) {
-      if (command.find(" ") == std::string::npos)
-      {
-        POST_COMMAND( wxID_PREFERENCES )
-      }
-      else
-      {
-        const bool toggle = command.back() != '*'; // modeline does not toggle
-        std::string text(command.substr(4, 
-          command.back() == '*' ? command.size() - 5: std::string::npos));
-        // Convert arguments (add -- to each group, remove all =).
-        // ts=120 ac ic sy=cpp -> --ts 120 --ac --ic --sy cpp
-        std::regex re("[0-9a-z=]+");
-        text = std::regex_replace(text, re, "--&", std::regex_constants::format_sed);
-        std::replace(text.begin(), text.end(), '=', ' ');
-        wxExCmdLine(
-          {{{"a", "ac", "Auto Complete"}, [](bool on){wxConfigBase::Get()->Write(_("Auto complete"), on);}},
-           {{"b", "eb", "Error Bells"}, [](bool on){wxConfigBase::Get()->Write(_("Error bells"), on ? 2: 0);}},
-           {{"C", "ic", "Ignore Case"}, [&](bool on){
-             if (!on) m_SearchFlags |= wxSTC_FIND_MATCHCASE;
-             else     m_SearchFlags &= ~wxSTC_FIND_MATCHCASE;
-             wxExFindReplaceData::Get()->SetMatchCase(!on);}},
-           {{"i", "ai", "Auto Indent"}, [](bool on){wxConfigBase::Get()->Write(_("Auto indent"), on ? 2: 0);}},
-           {{"e", "re", "Regular Expression"}, [&](bool on){
-             if (on) 
-             {
-               m_SearchFlags |= wxSTC_FIND_REGEXP;
+  {":chd", [](wxExEx* ex, const std::string& command) {
+    if (command.find(" ") == std::string::npos) return true;
+    wxExPath::Current(wxExFirstOf(command, " ")); return true;}},
+  {":close", [](wxExEx* ex, const std::string& command) {POST_COMMAND( wxID_CLOSE ) return true;}},
+  {":de", [](wxExEx* ex, const std::string& command) {
+    ex->m_Frame->GetDebug()->Execute(wxExFirstOf(command, " "), ex->m_Command.STC());
+    return true;}},
+  {":e", [](wxExEx* ex, const std::string& command) {POST_COMMAND( wxID_OPEN ) return true;}},
+  {":f", [](wxExEx* ex, const std::string& command) {ex->InfoMessage(); return true;}},
+  {":grep", [](wxExEx* ex, const std::string& command) {POST_COMMAND( ID_TOOL_REPORT_FIND ) return true;}},
+  {":gt", [](wxExEx* ex, const std::string& command) {return ex->m_Command.STC()->LinkOpen();}},
+  {":help", [](wxExEx* ex, const std::string& command) {POST_COMMAND( wxID_HELP ) return true;}},
+  {":map", [](wxExEx* ex, const std::string& command) {
+    switch (ParseCommandWithArg(command))
+    {
+      case wxExCommandArg::INT:
+        // TODO: at this moment you cannot set KEY_CONTROL
+        return ex->HandleContainer<int, wxExViMacrosMapType>(
+          "Map", command, nullptr,
+          [=](const std::string& name, const std::string& value) {
+            m_Macros.SetKeyMap(name, value);return true;}); 
+      break;
+      case wxExCommandArg::NONE: ex->ShowDialog("Maps", 
+          "[String map]\n" +
+          ex->ReportContainer<std::string, std::map<std::string, std::string>>(m_Macros.GetMap()) +
+          "[Key map]\n" +
+          ex->ReportContainer<int, wxExViMacrosMapType>(m_Macros.GetKeysMap()) +
+          "[Alt key map]\n" +
+          ex->ReportContainer<int, wxExViMacrosMapType>(m_Macros.GetKeysMap(KEY_ALT)) +
+          "[Control key map]\n" +
+          ex->ReportContainer<int, wxExViMacrosMapType>(m_Macros.GetKeysMap(KEY_CONTROL)), 
+          true);
+        return true;
+      break;
+      case wxExCommandArg::OTHER:
+        return ex->HandleContainer<std::string, std::map<std::string, std::string>>(
+          "Map", command, nullptr,
+          [=](const std::string& name, const std::string& value) {
+            m_Macros.SetMap(name, value);return true;});
+    }
+    return false;}},
+  {":new", [](wxExEx* ex, const std::string& command) {POST_COMMAND( wxID_NEW ) return true;}},
+  {":print", [](wxExEx* ex, const std::string& command) {ex->m_Command.STC()->Print(command.find(" ") == std::string::npos); return true;}},
+  {":pwd", [](wxExEx* ex, const std::string& command) {wxExLogStatus(wxExPath::Current()); return true;}},
+  {":q", [](wxExEx* ex, const std::string& command) {POST_CLOSE( wxEVT_CLOSE_WINDOW, true ) return true;}},
+  {":q!", [](wxExEx* ex, const std::string& command) {POST_CLOSE( wxEVT_CLOSE_WINDOW, false ) return true;}},
+  {":reg", [](wxExEx* ex, const std::string& command) {
+    ex->ShowDialog("Registers", m_Evaluator.GetInfo(ex), true);
+    return true;}},
+  {":sed", [](wxExEx* ex, const std::string& command) {POST_COMMAND( ID_TOOL_REPLACE ) return true;}},
+  {":set", [](wxExEx* ex, const std::string& command) {
+    if (command.find(" ") == std::string::npos)
+    {
+      POST_COMMAND( wxID_PREFERENCES )
+    }
+    else
+    {
+      const bool toggle = command.back() != '*'; // modeline does not toggle
+      std::string text(command.substr(4, 
+        command.back() == '*' ? command.size() - 5: std::string::npos));
+      // Convert arguments (add -- to each group, remove all =).
+      // ts=120 ac ic sy=cpp -> --ts 120 --ac --ic --sy cpp
+      std::regex re("[0-9a-z=]+");
+      text = std::regex_replace(text, re, "--&", std::regex_constants::format_sed);
+      std::replace(text.begin(), text.end(), '=', ' ');
+      wxExCmdLine(
+        {{{"a", "ac", "Auto Complete"}, [](bool on){wxConfigBase::Get()->Write(_("Auto complete"), on);}},
+         {{"b", "eb", "Error Bells"}, [](bool on){wxConfigBase::Get()->Write(_("Error bells"), on ? 2: 0);}},
+         {{"C", "ic", "Ignore Case"}, [&](bool on){
+           if (!on) ex->m_SearchFlags |= wxSTC_FIND_MATCHCASE;
+           else     ex->m_SearchFlags &= ~wxSTC_FIND_MATCHCASE;
+           wxExFindReplaceData::Get()->SetMatchCase(!on);}},
+         {{"i", "ai", "Auto Indent"}, [](bool on){wxConfigBase::Get()->Write(_("Auto indent"), on ? 2: 0);}},
+         {{"e", "re", "Regular Expression"}, [&](bool on){
+           if (on) 
+           {
+             ex->m_SearchFlags |= wxSTC_FIND_REGEXP;
 #if wxCHECK_VERSION(3,1,1)
-               m_SearchFlags |= wxSTC_FIND_CXX11REGEX;
+             ex->m_SearchFlags |= wxSTC_FIND_CXX11REGEX;
 #endif
-             }
-             else    
-             {
-               m_SearchFlags &= ~wxSTC_FIND_REGEXP;
+           }
+           else    
+           {
+             ex->m_SearchFlags &= ~wxSTC_FIND_REGEXP;
 #if wxCHECK_VERSION(3,1,1)
-               m_SearchFlags &= ~wxSTC_FIND_CXX11REGEX;
+             ex->m_SearchFlags &= ~wxSTC_FIND_CXX11REGEX;
 #endif
-             }
-             wxExFindReplaceData::Get()->SetUseRegEx(on);}},
-           {{"l", "el", "Edge Line"}, [&](bool on){
-             m_Command.STC()->SetEdgeMode(on ? wxSTC_EDGE_LINE: wxSTC_EDGE_NONE);     
-             wxConfigBase::Get()->Write(_("Edge line"), on ? wxSTC_EDGE_LINE: wxSTC_EDGE_NONE);}},
-           {{"m", "sm", "Show Mode"}, [&](bool on){
-             ((wxExStatusBar *)m_Frame->GetStatusBar())->ShowField("PaneMode", on);
-             wxConfigBase::Get()->Write(_("Show mode"), on);}},
-           {{"n", "nu", "show lineNUmbers"}, [&](bool on){
-             m_Command.STC()->ShowLineNumbers(on);
-             wxConfigBase::Get()->Write(_("Line numbers"), on);}},
-           {{"s", "ws", "show WhiteSpace"}, [&](bool on){
-             m_Command.STC()->SetViewEOL(on);
-             m_Command.STC()->SetViewWhiteSpace(on ? wxSTC_WS_VISIBLEALWAYS: wxSTC_WS_INVISIBLE);
-             wxConfigBase::Get()->Write(_("Whitespace"), on ? wxSTC_WS_VISIBLEALWAYS: wxSTC_WS_INVISIBLE);}},
-           {{"u", "ut", "Use Tabs"}, [&](bool on){
-             m_Command.STC()->SetUseTabs(on);
-             wxConfigBase::Get()->Write(_("Use tabs"), on);}},
-           {{"w", "mw", "Match Words"}, [&](bool on){
-             if (on) m_SearchFlags |= wxSTC_FIND_WHOLEWORD;
-             else    m_SearchFlags &= ~wxSTC_FIND_WHOLEWORD;
-             wxExFindReplaceData::Get()->SetMatchWord(on);}},
-           {{"W", "wl", "Wrap Line"}, [&](bool on){
-             m_Command.STC()->SetWrapMode(on ? wxSTC_WRAP_CHAR: wxSTC_WRAP_NONE);
-             wxConfigBase::Get()->Write(_("Wrap line"), on ? wxSTC_WRAP_CHAR: wxSTC_WRAP_NONE);}}},
-          {{{"c", "ec", "Edge Column"}, {CMD_LINE_INT, [&](const std::any& val) {
-             m_Command.STC()->SetEdgeColumn(std::any_cast<int>(val));
-             wxConfigBase::Get()->Write(_("Edge column"), std::any_cast<int>(val));}}},
-           {{"r", "rp", "reported lines"}, {CMD_LINE_INT, [&](const std::any& val) {
-             wxConfigBase::Get()->Write("Reported lines",  std::any_cast<int>(val));}}},
-           {{"S", "sw", "Shift Width"}, {CMD_LINE_INT, [&](const std::any& val) {
-             m_Command.STC()->SetIndent(std::any_cast<int>(val));
-             wxConfigBase::Get()->Write(_("Indent"), std::any_cast<int>(val));}}},
-           {{"t", "ts", "Tab Stop"}, {CMD_LINE_INT, [&](const std::any& val) {
-             m_Command.STC()->SetTabWidth(std::any_cast<int>(val));
-             wxConfigBase::Get()->Write(_("Tab width"), std::any_cast<int>(val));}}},
-           {{"y", "sy", "SYntax (lexer or 'off')"}, {CMD_LINE_STRING, [&](const std::any& val) {
-             if (std::any_cast<std::string>(val) != "off") 
-               m_Command.STC()->GetLexer().Set(std::any_cast<std::string>(val), true); // allow folding
-             else              
-               m_Command.STC()->GetLexer().Reset();}}}}).Parse(command.substr(0, 4) + text, toggle);
-      }
-      return true;}},
-    {":so", [&](const std::string& command) {
-      if (command.find(" ") == std::string::npos) return false;
-      wxExPath path(wxExFirstOf(command, " "));
-      if (path.IsRelative())
-      {
-        path.MakeAbsolute();
-      }
-      std::ifstream ifs(path.Path());
-      if (!ifs.is_open()) return false;
-      int i = 0;
-      for (std::string line; std::getline(ifs, line); )
+           }
+           wxExFindReplaceData::Get()->SetUseRegEx(on);}},
+         {{"l", "el", "Edge Line"}, [&](bool on){
+           ex->m_Command.STC()->SetEdgeMode(on ? wxSTC_EDGE_LINE: wxSTC_EDGE_NONE);     
+           wxConfigBase::Get()->Write(_("Edge line"), on ? wxSTC_EDGE_LINE: wxSTC_EDGE_NONE);}},
+         {{"m", "sm", "Show Mode"}, [&](bool on){
+           ((wxExStatusBar *)ex->m_Frame->GetStatusBar())->ShowField("PaneMode", on);
+           wxConfigBase::Get()->Write(_("Show mode"), on);}},
+         {{"n", "nu", "show lineNUmbers"}, [&](bool on){
+           ex->m_Command.STC()->ShowLineNumbers(on);
+           wxConfigBase::Get()->Write(_("Line numbers"), on);}},
+         {{"s", "ws", "show WhiteSpace"}, [&](bool on){
+           ex->m_Command.STC()->SetViewEOL(on);
+           ex->m_Command.STC()->SetViewWhiteSpace(on ? wxSTC_WS_VISIBLEALWAYS: wxSTC_WS_INVISIBLE);
+           wxConfigBase::Get()->Write(_("Whitespace"), on ? wxSTC_WS_VISIBLEALWAYS: wxSTC_WS_INVISIBLE);}},
+         {{"u", "ut", "Use Tabs"}, [&](bool on){
+           ex->m_Command.STC()->SetUseTabs(on);
+           wxConfigBase::Get()->Write(_("Use tabs"), on);}},
+         {{"w", "mw", "Match Words"}, [&](bool on){
+           if (on) ex->m_SearchFlags |= wxSTC_FIND_WHOLEWORD;
+           else    ex->m_SearchFlags &= ~wxSTC_FIND_WHOLEWORD;
+           wxExFindReplaceData::Get()->SetMatchWord(on);}},
+         {{"W", "wl", "Wrap Line"}, [&](bool on){
+           ex->m_Command.STC()->SetWrapMode(on ? wxSTC_WRAP_CHAR: wxSTC_WRAP_NONE);
+           wxConfigBase::Get()->Write(_("Wrap line"), on ? wxSTC_WRAP_CHAR: wxSTC_WRAP_NONE);}}},
+        {{{"c", "ec", "Edge Column"}, {CMD_LINE_INT, [&](const std::any& val) {
+           ex->m_Command.STC()->SetEdgeColumn(std::any_cast<int>(val));
+           wxConfigBase::Get()->Write(_("Edge column"), std::any_cast<int>(val));}}},
+         {{"r", "rp", "reported lines"}, {CMD_LINE_INT, [&](const std::any& val) {
+           wxConfigBase::Get()->Write("Reported lines",  std::any_cast<int>(val));}}},
+         {{"S", "sw", "Shift Width"}, {CMD_LINE_INT, [&](const std::any& val) {
+           ex->m_Command.STC()->SetIndent(std::any_cast<int>(val));
+           wxConfigBase::Get()->Write(_("Indent"), std::any_cast<int>(val));}}},
+         {{"t", "ts", "Tab Stop"}, {CMD_LINE_INT, [&](const std::any& val) {
+           ex->m_Command.STC()->SetTabWidth(std::any_cast<int>(val));
+           wxConfigBase::Get()->Write(_("Tab width"), std::any_cast<int>(val));}}},
+         {{"y", "sy", "SYntax (lexer or 'off')"}, {CMD_LINE_STRING, [&](const std::any& val) {
+           if (std::any_cast<std::string>(val) != "off") 
+             ex->m_Command.STC()->GetLexer().Set(std::any_cast<std::string>(val), true); // allow folding
+           else              
+             ex->m_Command.STC()->GetLexer().Reset();}}}}).Parse(command.substr(0, 4) + text, toggle);
+    }
+    return true;}},
+  {":so", [](wxExEx* ex, const std::string& command) {
+    if (command.find(" ") == std::string::npos) return false;
+    wxExPath path(wxExFirstOf(command, " "));
+    if (path.IsRelative())
+    {
+      path.MakeAbsolute();
+    }
+    std::ifstream ifs(path.Path());
+    if (!ifs.is_open()) return false;
+    int i = 0;
+    for (std::string line; std::getline(ifs, line); )
+    {
+      if (!line.empty())
       {
-        if (!line.empty())
+        if (line == command)
         {
-          if (line == command)
-          {
-            VLOG(9) << "recursive (line: " << i + 1 << ")";
-            return false;
-          }
-          else if (!Command(line))
-          {
-            VLOG(9) << "command error (line: " << i + 1 << ")";
-            return false;
-          }
+          VLOG(9) << "recursive (line: " << i + 1 << ")";
+          return false;
         }
-        i++;
-      }
-      return true;}},
-    {":syntax", [&](const std::string& command) {
-      if (wxString(command).EndsWith("on"))
-      {
-        wxExLexers::Get()->RestoreTheme();
-        m_Command.STC()->GetLexer().Set(m_Command.STC()->GetFileName().GetLexer().GetDisplayLexer(), true); // allow folding
-      }
-      else if (wxString(command).EndsWith("off"))
-      {
-        m_Command.STC()->GetLexer().Reset();
-        wxExLexers::Get()->SetThemeNone();
-      }
-      else
-      {
-        return false;
-      }
-      m_Frame->StatusText(wxExLexers::Get()->GetTheme(), "PaneTheme");
-      return true;}},
-    {":ta", [&](const std::string& command) {
-      m_CTags->Find(wxExFirstOf(command, " "));
-      return true;}},
-    {":una", [&](const std::string& command) {
-      if (wxExTokenizer tkz(command); tkz.CountTokens() >= 1)
-      {
-        tkz.GetNextToken(); // skip :una
-        m_Macros.SetAbbreviation(tkz.GetNextToken(), "");
-      }
-      return true;}},
-    {":unm", [&](const std::string& command) {
-      if (wxExTokenizer tkz(command); tkz.CountTokens() >= 1)
-      {
-        tkz.GetNextToken(); // skip :unm
-        switch (ParseCommandWithArg(command))
+        else if (!ex->Command(line))
         {
-          case wxExCommandArg::INT: m_Macros.SetKeyMap(tkz.GetNextToken(), ""); break; 
-          case wxExCommandArg::NONE: break;
-          case wxExCommandArg::OTHER: m_Macros.SetMap(tkz.GetNextToken(), ""); break;
+          VLOG(9) << "command error (line: " << i + 1 << ")";
+          return false;
         }
       }
-      return true;}},
-    {":ve", [&](const std::string& command) {ShowDialog("Version", 
-      wxExGetVersionInfo().GetVersionOnlyString().ToStdString()); return true;}},
-    {":x", [&](const std::string& command) {
-      if (command != ":x") return false;
-      POST_COMMAND( wxID_SAVE )
-      POST_CLOSE( wxEVT_CLOSE_WINDOW, true )
-      return true;}}}
+      i++;
+    }
+    return true;}},
+  {":syntax", [](wxExEx* ex, const std::string& command) {
+    if (wxString(command).EndsWith("on"))
+    {
+      wxExLexers::Get()->RestoreTheme();
+      ex->m_Command.STC()->GetLexer().Set(ex->m_Command.STC()->GetFileName().GetLexer().GetDisplayLexer(), true); // allow folding
+    }
+    else if (wxString(command).EndsWith("off"))
+    {
+      ex->m_Command.STC()->GetLexer().Reset();
+      wxExLexers::Get()->SetThemeNone();
+    }
+    else
+    {
+      return false;
+    }
+    ex->m_Frame->StatusText(wxExLexers::Get()->GetTheme(), "PaneTheme");
+    return true;}},
+  {":ta", [](wxExEx* ex, const std::string& command) {
+    ex->GetCTags()->Find(wxExFirstOf(command, " "));
+    return true;}},
+  {":una", [](wxExEx* ex, const std::string& command) {
+    if (wxExTokenizer tkz(command); tkz.CountTokens() >= 1)
+    {
+      tkz.GetNextToken(); // skip :una
+      m_Macros.SetAbbreviation(tkz.GetNextToken(), "");
+    }
+    return true;}},
+  {":unm", [](wxExEx* ex, const std::string& command) {
+    if (wxExTokenizer tkz(command); tkz.CountTokens() >= 1)
+    {
+      tkz.GetNextToken(); // skip :unm
+      switch (ParseCommandWithArg(command))
+      {
+        case wxExCommandArg::INT: m_Macros.SetKeyMap(tkz.GetNextToken(), ""); break; 
+        case wxExCommandArg::NONE: break;
+        case wxExCommandArg::OTHER: m_Macros.SetMap(tkz.GetNextToken(), ""); break;
+      }
+    }
+    return true;}},
+  {":ve", [](wxExEx* ex, const std::string& command) {ex->ShowDialog("Version", 
+    wxExGetVersionInfo().GetVersionOnlyString().ToStdString()); return true;}},
+  {":x", [](wxExEx* ex, const std::string& command) {
+    if (command != ":x") return false;
+    POST_COMMAND( wxID_SAVE )
+    POST_CLOSE( wxEVT_CLOSE_WINDOW, true )
+    return true;}};
+
+wxExEx::wxExEx(wxExSTC* stc)
+  : m_Command(wxExExCommand(stc))
+  , m_Frame(wxDynamicCast(wxTheApp->GetTopWindow(), wxExManagedFrame))
 {
   wxASSERT(m_Frame != nullptr);
   ResetSearchFlags();
@@ -322,6 +327,18 @@ wxExEx::~wxExEx()
 {
   delete m_CTags;
 }
+
+wxExCTags* wxExEx::GetCTags()
+{
+  // Most editors never use tags, so these are not
+  // looked up until first used.
+  if (m_CTags == nullptr)
+  {
+    m_CTags = new wxExCTags(this);
+  }
+
+  return m_CTags;
+}
   
 void wxExEx::AddText(const std::string& text)
 {
@@ -539,12 +556,24 @@ bool wxExEx::CommandAddress(const std::string& command)
   }
 }
 
-bool wxExEx::CommandHandle(const std::string& command) const
+bool wxExEx::CommandHandle(const std::string& command)
 {
-  const auto& it = std::find_if(m_Commands.begin(), m_Commands.end(), 
-    [command](auto const& e) {return e.first == command.substr(0, e.first.size());});
-  
-  return it != m_Commands.end() && it->second(command);
+  static const auto max_size = std::max_element(m_Commands.begin(), m_Commands.end(),
+    [](const auto& a, const auto& b) {return a.first.size() < b.first.size();})->first.size();
+
+  for (auto size = std::min(command.size(), max_size); size > 0; size--)
+  {
+    if (const auto it = std::lower_bound(m_Commands.begin(), m_Commands.end(),
+      command.substr(0, size), [](const auto& e, const std::string& name) {
+        return e.first < name;});
+      it != m_Commands.end() && it->first.size() == size && 
+      command.compare(0, size, it->first) == 0)
+    {
+      return it->second(this, command);
+    }
+  }
+
+  return false;
 }
 
 void wxExEx::Copy(const wxExEx* ex)
@@ -665,9 +694,11 @@ bool wxExEx::MarkerAdd(char marker, int line)
       // 0: non-char ex marker
       // 1: change marker
       // 2: breakpoint marker
-      // 3..: character markers (all markers in m_MarkerIdentifiers)
+      // 3..: character markers (all markers in m_MarkerIdentifiers),
+      //      except MARKER_GLOBAL
       const auto marker_offset = 3;
-      const auto marker_number = m_MarkerIdentifiers.size() + marker_offset;
+      auto marker_number = m_MarkerIdentifiers.size() + marker_offset;
+      if (marker_number >= MARKER_GLOBAL) marker_number++;
 
       m_Command.STC()->MarkerDefine(marker_number, 
         wxSTC_MARK_CHARACTER + marker, 
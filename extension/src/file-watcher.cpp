@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      file-watcher.cpp
+// Purpose:   Implementation of class wxExFileWatcher
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cerrno>
+#include <wx/app.h>
+#include <wx/extension/file-watcher.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+wxExFileWatcher* wxExFileWatcher::m_Self = nullptr;
+
+wxExFileWatcher::wxExFileWatcher()
+{
+#ifdef __linux__
+  if ((m_Descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) == -1)
+  {
+    return;
+  }
+
+  if (pipe(m_Pipe) == -1)
+  {
+    close(m_Descriptor);
+    m_Descriptor = -1;
+    return;
+  }
+
+  m_Thread = std::thread(&wxExFileWatcher::Run, this);
+#endif
+}
+
+wxExFileWatcher::~wxExFileWatcher()
+{
+#ifdef __linux__
+  if (m_Thread.joinable())
+  {
+    // Wake up the thread, it stops.
+    if (write(m_Pipe[1], "x", 1) == 1) 
+    {
+      m_Thread.join();
+    }
+    else
+    {
+      m_Thread.detach();
+    }
+  }
+
+  for (const auto fd : {m_Descriptor, m_Pipe[0], m_Pipe[1]})
+  {
+    if (fd != -1) close(fd);
+  }
+#endif
+}
+
+wxExFileWatcher* wxExFileWatcher::Get(bool createOnDemand)
+{
+  if (m_Self == nullptr && createOnDemand)
+  {
+    m_Self = new wxExFileWatcher();
+  }
+
+  return m_Self;
+}
+
+void wxExFileWatcher::Remove(wxExFileWatch* watch)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (auto it = m_Watches.find(watch->m_Descriptor); it != m_Watches.end())
+  {
+    auto& v = it->second;
+    v.erase(std::remove(v.begin(), v.end(), watch), v.end());
+
+    if (v.empty())
+    {
+#ifdef __linux__
+      inotify_rm_watch(m_Descriptor, watch->m_Descriptor);
+#endif
+      m_Watches.erase(it);
+    }
+  }
+}
+
+void wxExFileWatcher::Run()
+{
+#ifdef __linux__
+  // Buffer aligned as required for inotify_event.
+  alignas(inotify_event) char buffer[4096];
+  pollfd fds[] {{m_Descriptor, POLLIN, 0}, {m_Pipe[0], POLLIN, 0}};
+
+  while (poll(fds, 2, -1) != -1 || errno == EINTR)
+  {
+    if (fds[1].revents != 0) break;
+    if (fds[0].revents == 0) continue;
+
+    bool changed = false;
+
+    for (ssize_t size; (size = read(m_Descriptor, buffer, sizeof(buffer))) > 0; )
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+
+      for (char* p = buffer; p < buffer + size; )
+      {
+        const auto* event = (inotify_event*)p;
+        p += sizeof(inotify_event) + event->len;
+
+        if (const auto& it = m_Watches.find(event->wd); it != m_Watches.end())
+        {
+          for (auto* watch : it->second)
+          {
+            watch->m_Changed = true;
+
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+            {
+              watch->m_Lost = true;
+            }
+          }
+
+          // The kernel removed the watch.
+          if (event->mask & IN_IGNORED)
+          {
+            m_Watches.erase(it);
+          }
+
+          changed = true;
+        }
+      }
+    }
+
+    if (changed)
+    {
+      wxWakeUpIdle();
+    }
+  }
+#endif
+}
+
+wxExFileWatcher* wxExFileWatcher::Set(wxExFileWatcher* watcher)
+{
+  wxExFileWatcher* old = m_Self;
+  m_Self = watcher;
+  return old;
+}
+
+std::shared_ptr<wxExFileWatch> wxExFileWatcher::Watch(const std::string& fullpath)
+{
+#ifdef __linux__
+  if (!IsAvailable())
+  {
+    return nullptr;
+  }
+
+  const int wd = inotify_add_watch(m_Descriptor, fullpath.c_str(), 
+    IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_MOVE_SELF | IN_DELETE_SELF);
+
+  if (wd == -1)
+  {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto* watch = new wxExFileWatch(fullpath, wd);
+  m_Watches[wd].emplace_back(watch);
+
+  // The watcher might be deleted before the watch.
+  return std::shared_ptr<wxExFileWatch>(watch, [](wxExFileWatch* watch) {
+    if (auto* watcher = wxExFileWatcher::Get(false); watcher != nullptr)
+    {
+      watcher->Remove(watch);
+    }
+    delete watch;});
+#else
+  return nullptr;
+#endif
+}
@@ -9,8 +9,10 @@
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
 #endif
+#include <algorithm>
 #include <wx/config.h>
 #include <wx/extension/file.h>
+#include <wx/extension/file-watcher.h>
 
 wxExFile& wxExFile::operator=(const wxExFile& f)
 {
@@ -20,27 +22,76 @@ wxExFile& wxExFile::operator=(const wxExFile& f)
     m_OpenFile = f.m_OpenFile;
     m_Path = f.m_Path;
     m_Stat = f.m_Stat;
+    m_ContentsStat = f.m_ContentsStat;
     m_File = std::make_unique<wxFile>(m_Path.Path().string());
+    m_SyncLength = 0;
+    m_Watch.reset();
   }
 
   return *this;
 }
 
+std::uint32_t wxExFile::Checksum(wxFileOffset length)
+{
+  // FNV-1a of first and last block before length.
+  const wxFileOffset block = 4096;
+  char buffer[block];
+  std::uint32_t hash = 2166136261u;
+
+  for (const auto pos : {wxFileOffset(0), std::max(wxFileOffset(0), length - block)})
+  {
+    if (m_File->Seek(pos) == wxInvalidOffset) break;
+
+    if (const auto size = m_File->Read(buffer, std::min(block, length - pos));
+      size != wxInvalidOffset)
+    {
+      for (ssize_t i = 0; i < size; i++)
+      {
+        hash = (hash ^ (unsigned char)buffer[i]) * 16777619u;
+      }
+    }
+  }
+
+  m_File->Seek(0);
+
+  return hash;
+}
+
 bool wxExFile::CheckSync()
 {
+  // If the file is watched, no need to access it until it changed.
+  if (m_Watch != nullptr && !m_Watch->IsChanged())
+  {
+    return false;
+  }
+
   // config might be used without wxApp.
   if (auto* config = wxConfigBase::Get(false); m_File->IsOpened() ||
-      !m_Path.m_Stat.IsOk() ||
+      !m_Path.GetStat().IsOk() ||
       (config != nullptr && !config->ReadBool("AllowSync", true)))
   {
     return false;
   }
 
-  if (m_Path.m_Stat.Sync())
+  // A lost watch (file moved or removed) is replaced by a watch
+  // on the file that now has the path.
+  if (m_Watch == nullptr || m_Watch->IsLost())
+  {
+    m_Watch = wxExFileWatcher::Get()->Watch(m_Path.Path().string());
+  }
+
+  if (m_Watch != nullptr)
+  {
+    m_Watch->Reset();
+  }
+
+  if (m_Path.Sync())
   {
     bool sync_needed = false;
     
-    if (m_Path.m_Stat.st_mtime != m_Stat.st_mtime)
+    if (m_Path.GetStat().st_mtime != m_Stat.st_mtime ||
+        m_Path.GetStat().st_size != m_Stat.st_size ||
+        m_Path.GetStat().st_ino != m_Stat.st_ino)
     {
       // Do not check return value,
       // we sync anyhow, to force nex time no sync.
@@ -49,7 +100,7 @@ bool wxExFile::CheckSync()
       sync_needed = true;
     }
     
-    if (m_Path.m_Stat.IsReadOnly() != m_Stat.IsReadOnly())
+    if (m_Path.GetStat().IsReadOnly() != m_Stat.IsReadOnly())
     {
       sync_needed = true;
     }
@@ -106,19 +157,28 @@ bool wxExFile::FileSave(const wxExPath& file)
     return false;
   }
 
-  if (m_OpenFile && !Open(m_Path.Path().string(), wxFile::write))
+  // Decided once, so DoFileSave writes as the file was opened.
+  m_IsSavedInPlace = !save_as && CanSaveInPlace();
+
+  if (m_OpenFile && !Open(m_Path.Path().string(), 
+    m_IsSavedInPlace ? wxFile::read_write: wxFile::write))
   {
+    m_IsSavedInPlace = false;
     return false;
   }
 
   DoFileSave(save_as);
 
+  m_IsSavedInPlace = false;
+
   Close();
 
   ResetContentsChanged();
   
-  m_Path.m_Stat.Sync();
+  m_Path.Sync();
   m_Stat.Sync();
+  m_ContentsStat = m_Stat;
+  m_SyncLength = 0;
 
   return true;
 }
@@ -133,12 +193,34 @@ bool wxExFile::Get(bool synced)
     return false;
   }
 
+  // Appended if same file (not rotated), not truncated, 
+  // and the part read last time did not change.
+  m_IsAppended = synced && IsOpened() &&
+    m_SyncLength > 0 && 
+    m_Path.GetStat().st_ino == m_Stat.st_ino &&
+    Length() > m_SyncLength && 
+    Checksum(m_SyncLength) == m_SyncChecksum;
+
   if (!DoFileLoad(synced))
   {
+    m_IsAppended = false;
     Close();
     return false;
   }
 
+  m_IsAppended = false;
+  m_ContentsStat.Sync(m_Path.Path().string());
+
+  if (IsOpened())
+  {
+    m_SyncLength = m_File->Tell();
+    m_SyncChecksum = Checksum(m_SyncLength);
+  }
+  else
+  {
+    m_SyncLength = 0;
+  }
+
   Close();
   
   m_IsLoaded = true;
@@ -148,6 +230,17 @@ bool wxExFile::Get(bool synced)
   return true;
 }
 
+bool wxExFile::IsUnchangedOnDisk() const
+{
+  const wxExStat stat(m_Path.Path().string());
+
+  return 
+    stat.IsOk() && m_ContentsStat.IsOk() &&
+    stat.st_ino == m_ContentsStat.st_ino &&
+    stat.st_size == m_ContentsStat.st_size &&
+    stat.st_mtime == m_ContentsStat.st_mtime;
+}
+
 bool wxExFile::Open(const wxExPath& file, wxFile::OpenMode mode, int access)
 {
   return m_File->Open(file.Path().string(), mode, access);
@@ -157,8 +250,7 @@ const wxCharBuffer* wxExFile::Read(wxFileOffset seek_position)
 {
   wxASSERT(m_File->IsOpened());
   
-  if ((m_Buffer.get() != nullptr && seek_position > 0) || 
-      (m_Buffer.get() != nullptr && m_File->Tell() != seek_position))
+  if (m_File->Tell() != seek_position)
   {
     m_File->Seek(seek_position);
   }
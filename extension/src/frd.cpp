@@ -12,13 +12,68 @@
 #include <wx/config.h> 
 #include <wx/extension/frd.h>
 #include <wx/extension/ex-command.h>
+#include <wx/extension/regex-dfa.h>
 #include <wx/extension/util.h>
 
+/// The std::regex engine.
+class wxExRegExStd : public wxExRegExEngine
+{
+public:
+  wxExRegExStd(const std::string& regex, bool match_case)
+    : m_RegEx(regex, match_case ? 
+        std::regex::ECMAScript: std::regex::ECMAScript | std::regex::icase) {;};
+
+  int Matches(const std::string_view& text) const override {
+    std::cmatch m;
+    if (!std::regex_search(text.data(), text.data() + text.size(), m, m_RegEx)) return -1;
+    return m.position();};
+
+  int ReplaceAll(std::string& text, const std::string& replace) const override {
+    std::string output;
+    auto last = text.cbegin();
+    int count = 0;
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), m_RegEx);
+      it != std::sregex_iterator(); ++it)
+    {
+      output.append(it->prefix().first, it->prefix().second);
+      it->format(std::back_inserter(output), replace);
+      last = (*it)[0].second;
+      count++;
+    }
+    if (count > 0)
+    {
+      output.append(last, text.cend());
+      text.swap(output);
+    }
+    return count;};
+private:
+  const std::regex m_RegEx;
+};
+
+std::unique_ptr<wxExRegExEngine> wxExRegExEngine::Create(
+  const std::string& regex, bool match_case, wxExRegExEngineType type)
+{
+  if (type == REGEX_DFA)
+  {
+    try
+    {
+      return std::make_unique<wxExRegExDFA>(regex, match_case);
+    }
+    catch (std::regex_error& )
+    {
+      // Not supported (or invalid), let std::regex handle it.
+    }
+  }
+
+  return std::make_unique<wxExRegExStd>(regex, match_case);
+}
+
 wxExFindReplaceData* wxExFindReplaceData::m_Self = nullptr;
 std::string wxExFindReplaceData::m_TextFindWhat = _("Find what").ToStdString();
 std::string wxExFindReplaceData::m_TextMatchCase = _("Match case").ToStdString();
 std::string wxExFindReplaceData::m_TextMatchWholeWord = _("Match whole word").ToStdString();
 std::string wxExFindReplaceData::m_TextRegEx = _("Regular expression").ToStdString();
+std::string wxExFindReplaceData::m_TextRegExEngine = _("Regular expression engine").ToStdString();
 std::string wxExFindReplaceData::m_TextReplaceWith = _("Replace with").ToStdString();
 std::string wxExFindReplaceData::m_TextSearchDown = _("Search down").ToStdString();
 
@@ -33,6 +88,9 @@ wxExFindReplaceData::wxExFindReplaceData()
 
   SetFlags(flags);
 
+  m_RegExEngineType = (wxExRegExEngine::wxExRegExEngineType)
+    wxConfigBase::Get()->ReadLong(m_TextRegExEngine, m_RegExEngineType);
+
   // Start with this one, as it is used by SetFindString.
   SetUseRegEx(wxConfigBase::Get()->ReadBool(m_TextRegEx, m_UseRegEx));
   SetFindStrings(wxExListFromConfig(m_TextFindWhat));
@@ -44,6 +102,7 @@ wxExFindReplaceData::~wxExFindReplaceData()
   wxConfigBase::Get()->Write(m_TextMatchCase, MatchCase());
   wxConfigBase::Get()->Write(m_TextMatchWholeWord, MatchWord());
   wxConfigBase::Get()->Write(m_TextRegEx, m_UseRegEx);
+  wxConfigBase::Get()->Write(m_TextRegExEngine, (long)m_RegExEngineType);
   wxConfigBase::Get()->Write(m_TextSearchDown, SearchDown());
 }
 
@@ -57,30 +116,15 @@ wxExFindReplaceData* wxExFindReplaceData::Get(bool createOnDemand)
   return m_Self;
 }
 
-int wxExFindReplaceData::RegExMatches(const std::string& text) const
+int wxExFindReplaceData::RegExMatches(const std::string_view& text) const
 {
-  std::smatch m;
-
-  if (!std::regex_search(
-    text, 
-    m,
-    m_FindRegEx, std::regex_constants::format_default)) return -1;
-
-  return m.position();
+  return m_RegExEngine != nullptr ? m_RegExEngine->Matches(text): -1;
 }
   
 int wxExFindReplaceData::RegExReplaceAll(std::string& text) const
 {
-  const auto words_begin = std::sregex_iterator(text.begin(), text.end(), m_FindRegEx);
-  const auto words_end = std::sregex_iterator();  
-  const int result = std::distance(words_begin, words_end);
-  
-  text = std::regex_replace(text, 
-    m_FindRegEx, 
-    GetReplaceString(),
-    std::regex_constants::format_default);
-
-  return result;
+  return m_RegExEngine != nullptr ? 
+    m_RegExEngine->ReplaceAll(text, GetReplaceString()): 0;
 }
   
 wxExFindReplaceData* wxExFindReplaceData::Set(wxExFindReplaceData* frd)
@@ -129,6 +173,13 @@ void wxExFindReplaceData::SetMatchWord(bool value)
   }
 }
 
+void wxExFindReplaceData::SetRegExEngine(
+  wxExRegExEngine::wxExRegExEngineType type)
+{
+  m_RegExEngineType = type;
+  SetUseRegEx(m_UseRegEx);
+}
+
 void wxExFindReplaceData::SetReplaceString(const std::string& value)
 {
   m_ReplaceStrings.Set(value);
@@ -152,10 +203,8 @@ void wxExFindReplaceData::SetUseRegEx(bool value)
   
   try 
   {
-    std::regex::flag_type flags = std::regex::ECMAScript;
-    if (!MatchCase()) flags |= std::regex::icase;
-  
-    m_FindRegEx = std::regex(GetFindString(), flags);
+    m_RegExEngine = wxExRegExEngine::Create(
+      GetFindString(), MatchCase(), m_RegExEngineType);
     m_UseRegEx = true;
   }
   catch (std::regex_error& e) 
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      glob.cpp
+// Purpose:   Implementation of wxExGlob class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <wx/extension/glob.h>
+
+wxExGlob::wxExGlob(const std::string& pattern)
+  : m_Pattern(pattern)
+{
+  for (size_t start = 0; start < pattern.size(); )
+  {
+    auto end = pattern.find(';', start);
+    if (end == std::string::npos) end = pattern.size();
+
+    if (const auto part(pattern.substr(start, end - start)); !part.empty())
+    {
+      const auto wildcard = part.find_first_of("*?");
+      const auto last = part.find_last_of("*?");
+
+      if (part == "*")
+        m_Parts.push_back({GLOB_ANY, std::string()});
+      else if (wildcard == std::string::npos)
+        m_Parts.push_back({GLOB_EXACT, part});
+      else if (wildcard == 0 && last == 0 && part[0] == '*')
+        m_Parts.push_back({GLOB_SUFFIX, part.substr(1)});
+      else if (wildcard == part.size() - 1 && part.back() == '*')
+        m_Parts.push_back({GLOB_PREFIX, part.substr(0, part.size() - 1)});
+      else
+        m_Parts.push_back({GLOB_WILDCARD, part});
+    }
+
+    start = end + 1;
+  }
+}
+
+std::shared_ptr<const wxExGlob> wxExGlob::Get(const std::string& pattern)
+{
+  // Most recently used is at the front.
+  const size_t max_size = 64;
+  static std::list<std::shared_ptr<const wxExGlob>> cache;
+  static std::unordered_map<std::string, 
+    std::list<std::shared_ptr<const wxExGlob>>::iterator> index;
+  static std::mutex mutex;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (const auto& it = index.find(pattern); it != index.end())
+  {
+    cache.splice(cache.begin(), cache, it->second);
+    return cache.front();
+  }
+
+  cache.emplace_front(std::make_shared<const wxExGlob>(pattern));
+  index[pattern] = cache.begin();
+
+  if (cache.size() > max_size)
+  {
+    index.erase(cache.back()->GetPattern());
+    cache.pop_back();
+  }
+
+  return cache.front();
+}
+
+bool wxExGlob::Matches(const std::string_view& fullname) const
+{
+  for (const auto& it : m_Parts)
+  {
+    switch (it.m_Type)
+    {
+      case GLOB_ANY: 
+        return true;
+
+      case GLOB_EXACT: 
+        if (fullname == it.m_Text) return true;
+        break;
+
+      case GLOB_PREFIX: 
+        if (fullname.compare(0, it.m_Text.size(), it.m_Text) == 0) return true;
+        break;
+
+      case GLOB_SUFFIX: 
+        if (fullname.size() >= it.m_Text.size() &&
+            fullname.compare(
+              fullname.size() - it.m_Text.size(), 
+              it.m_Text.size(), it.m_Text) == 0) return true;
+        break;
+
+      case GLOB_WILDCARD: 
+        if (MatchWildcard(it.m_Text, fullname)) return true;
+        break;
+    }
+  }
+
+  return false;
+}
+
+bool wxExGlob::MatchWildcard(
+  const std::string_view& pattern, const std::string_view& text)
+{
+  // Iterative matching, backtracking to the last * only.
+  size_t p = 0, t = 0;
+  size_t star = std::string_view::npos, mark = 0;
+
+  while (t < text.size())
+  {
+    if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t]))
+    {
+      p++;
+      t++;
+    }
+    else if (p < pattern.size() && pattern[p] == '*')
+    {
+      star = p++;
+      mark = t;
+    }
+    else if (star != std::string_view::npos)
+    {
+      p = star + 1;
+      t = ++mark;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  while (p < pattern.size() && pattern[p] == '*') p++;
+
+  return p == pattern.size();
+}
@@ -0,0 +1,373 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      hex-buffer.cpp
+// Purpose:   Implementation of class wxExHexBuffer
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cctype>
+#include <wx/extension/hex-buffer.h>
+
+namespace
+{
+  // Adds the patch bytes to the change.
+  void Add(wxExHexBuffer::wxExHexChange& change,
+    size_t offset, size_t removed, size_t inserted)
+  {
+    const auto end = std::max(
+      change.m_Length > 0 ? change.m_Offset + change.m_Length: 0,
+      offset + std::max(removed, inserted));
+
+    change.m_Offset = (change.m_Length > 0 ?
+      std::min(change.m_Offset, offset): offset);
+    change.m_Length = std::max<size_t>(end - change.m_Offset, 1);
+    change.m_Resized = change.m_Resized || removed != inserted;
+  }
+
+  // Number of bytes copied at once while searching.
+  const size_t SEARCH_CHUNK = 1 << 20;
+
+  bool Equal(char a, char b, bool match_case)
+  {
+    return match_case ? a == b:
+      std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
+  }
+}
+
+void wxExHexBuffer::Append(const std::string_view& text)
+{
+  if (text.empty()) return;
+
+  const wxExHexPiece piece{true, m_Added.size(), text.size()};
+
+  m_Added.append(text.data(), text.size());
+  m_Pieces.emplace_back(piece);
+
+  Update(m_Pieces.size() - 1);
+
+  // The bytes appended are already saved.
+  if (m_SavedOffsets.back() != std::string::npos)
+  {
+    m_SavedPieces.emplace_back(piece);
+    m_SavedOffsets.emplace_back(m_SavedOffsets.back() + text.size());
+  }
+}
+
+void wxExHexBuffer::Assign(std::string text)
+{
+  m_Original = std::move(text);
+  m_Added.clear();
+  m_Pieces.clear();
+  m_Journal.clear();
+  m_Done = 0;
+  m_Editing = false;
+
+  if (!m_Original.empty())
+  {
+    m_Pieces.push_back({false, 0, m_Original.size()});
+  }
+
+  Update();
+  SetSavePoint();
+}
+
+void wxExHexBuffer::ClearSavePoint()
+{
+  m_SavedPieces.clear();
+  m_SavedOffsets = {std::string::npos};
+  m_SavedDone = std::string::npos;
+}
+
+size_t wxExHexBuffer::Copy(size_t offset, size_t count, char* buffer) const
+{
+  if (offset >= GetSize()) return 0;
+
+  count = std::min(count, GetSize() - offset);
+
+  size_t copied = 0;
+
+  for (auto i = Find(offset); copied < count; i++)
+  {
+    const auto& piece(m_Pieces[i]);
+    const auto skip = offset + copied - m_Offsets[i];
+    const auto size = std::min(piece.m_Length - skip, count - copied);
+
+    std::copy_n(
+      (piece.m_Added ? m_Added: m_Original).data() + piece.m_Start + skip,
+      size,
+      buffer + copied);
+
+    copied += size;
+  }
+
+  return copied;
+}
+
+bool wxExHexBuffer::Erase(size_t offset, size_t count)
+{
+  if (offset >= GetSize()) return false;
+
+  count = std::min(count, GetSize() - offset);
+
+  Record({offset, Patch(offset, count, {}), {}});
+
+  return true;
+}
+
+size_t wxExHexBuffer::Find(size_t offset) const
+{
+  // The last piece starting at or before offset.
+  return std::upper_bound(m_Offsets.begin(), m_Offsets.end() - 1, offset) -
+    m_Offsets.begin() - 1;
+}
+
+const std::string wxExHexBuffer::Get(size_t offset, size_t count) const
+{
+  if (offset >= GetSize()) return std::string();
+
+  std::string text(std::min(count, GetSize() - offset), 0);
+  Copy(offset, text.size(), text.data());
+
+  return text;
+}
+
+const std::vector<std::pair<size_t, size_t>> wxExHexBuffer::GetChanged() const
+{
+  std::vector<std::pair<size_t, size_t>> changed;
+
+  if (IsResized()) return changed;
+
+  // Walk along the pieces now and at the save point, a byte
+  // is unchanged if it refers to the same source byte.
+  for (size_t i = 0, j = 0, pos = 0; pos < GetSize(); )
+  {
+    const auto end = std::min(m_Offsets[i + 1], m_SavedOffsets[j + 1]);
+    const auto& now(m_Pieces[i]);
+    const auto& saved(m_SavedPieces[j]);
+
+    if (now.m_Added != saved.m_Added ||
+        now.m_Start + pos - m_Offsets[i] != saved.m_Start + pos - m_SavedOffsets[j])
+    {
+      if (!changed.empty() &&
+           changed.back().first + changed.back().second == pos)
+      {
+        changed.back().second += end - pos;
+      }
+      else
+      {
+        changed.push_back({pos, end - pos});
+      }
+    }
+
+    pos = end;
+
+    if (m_Offsets[i + 1] == end) i++;
+    if (m_SavedOffsets[j + 1] == end) j++;
+  }
+
+  return changed;
+}
+
+bool wxExHexBuffer::Insert(size_t offset, const std::string_view& text)
+{
+  if (offset > GetSize()) return false;
+  if (text.empty()) return true;
+
+  const wxExHexPiece piece{true, m_Added.size(), text.size()};
+
+  m_Added.append(text.data(), text.size());
+
+  Record({offset, Patch(offset, 0, {piece}), {piece}});
+
+  return true;
+}
+
+size_t wxExHexBuffer::Length(const std::vector<wxExHexPiece>& pieces)
+{
+  size_t length = 0;
+
+  for (const auto& piece : pieces)
+  {
+    length += piece.m_Length;
+  }
+
+  return length;
+}
+
+std::vector<wxExHexBuffer::wxExHexPiece> wxExHexBuffer::Patch(
+  size_t offset, size_t count, const std::vector<wxExHexPiece>& insert)
+{
+  const auto first = Split(offset);
+  const auto last = Split(offset + count);
+
+  std::vector<wxExHexPiece> removed(
+    m_Pieces.begin() + first, m_Pieces.begin() + last);
+
+  m_Pieces.erase(m_Pieces.begin() + first, m_Pieces.begin() + last);
+  m_Pieces.insert(m_Pieces.begin() + first, insert.begin(), insert.end());
+
+  // The offset of the first piece removed is the offset of the first inserted.
+  Update(first);
+
+  return removed;
+}
+
+const wxExHexBuffer::wxExHexChange wxExHexBuffer::Redo()
+{
+  wxExHexChange change;
+
+  if (!CanRedo()) return change;
+
+  m_Editing = false;
+
+  for (const auto& patch : m_Journal[m_Done++])
+  {
+    Patch(patch.m_Offset, Length(patch.m_Removed), patch.m_Inserted);
+    Add(change,
+      patch.m_Offset, Length(patch.m_Removed), Length(patch.m_Inserted));
+  }
+
+  return change;
+}
+
+void wxExHexBuffer::Record(wxExHexPatch patch)
+{
+  // Edits undone cannot be redone anymore.
+  if (m_Done < m_Journal.size())
+  {
+    m_Journal.resize(m_Done);
+
+    if (m_SavedDone != std::string::npos && m_SavedDone > m_Done)
+    {
+      m_SavedDone = std::string::npos;
+    }
+  }
+
+  if (m_Editing && m_EditStarted)
+  {
+    m_Journal.back().emplace_back(std::move(patch));
+  }
+  else
+  {
+    m_Journal.push_back({std::move(patch)});
+    m_Done = m_Journal.size();
+    m_EditStarted = m_Editing;
+  }
+}
+
+bool wxExHexBuffer::Replace(size_t offset, char c)
+{
+  if (offset >= GetSize()) return false;
+
+  const wxExHexPiece piece{true, m_Added.size(), 1};
+
+  m_Added += c;
+
+  Record({offset, Patch(offset, 1, {piece}), {piece}});
+
+  return true;
+}
+
+size_t wxExHexBuffer::Search(
+  const std::string_view& text, size_t offset, bool match_case) const
+{
+  if (text.empty()) return std::string::npos;
+
+  // The chunks overlap, so text on a chunk boundary is found.
+  const auto chunk = std::max(SEARCH_CHUNK, 2 * text.size());
+  std::string bytes(chunk, 0);
+
+  for (; offset + text.size() <= GetSize(); offset += chunk - text.size() + 1)
+  {
+    const auto end = bytes.begin() + Copy(offset, chunk, bytes.data());
+
+    if (const auto it = std::search(bytes.begin(), end, text.begin(), text.end(), 
+      [&](char a, char b) {return Equal(a, b, match_case);}); it != end)
+    {
+      return offset + (it - bytes.begin());
+    }
+  }
+
+  return std::string::npos;
+}
+
+size_t wxExHexBuffer::SearchLast(
+  const std::string_view& text, bool match_case) const
+{
+  if (text.empty() || text.size() > GetSize()) return std::string::npos;
+
+  const auto chunk = std::max(SEARCH_CHUNK, 2 * text.size());
+  std::string bytes(chunk, 0);
+
+  for (auto end = GetSize(); ; end = end - chunk + text.size() - 1)
+  {
+    const auto offset = (end > chunk ? end - chunk: 0);
+    const auto last = bytes.begin() + Copy(offset, end - offset, bytes.data());
+
+    if (const auto it = std::find_end(bytes.begin(), last, text.begin(), text.end(), 
+      [&](char a, char b) {return Equal(a, b, match_case);}); it != last)
+    {
+      return offset + (it - bytes.begin());
+    }
+
+    if (offset == 0) return std::string::npos;
+  }
+}
+
+void wxExHexBuffer::SetSavePoint()
+{
+  m_SavedPieces = m_Pieces;
+  m_SavedOffsets = m_Offsets;
+  m_SavedDone = m_Done;
+}
+
+size_t wxExHexBuffer::Split(size_t offset)
+{
+  if (offset >= GetSize()) return m_Pieces.size();
+
+  const auto i = Find(offset);
+
+  if (m_Offsets[i] == offset) return i;
+
+  const auto skip = offset - m_Offsets[i];
+  auto& piece(m_Pieces[i]);
+  const wxExHexPiece second{piece.m_Added, piece.m_Start + skip, piece.m_Length - skip};
+
+  piece.m_Length = skip;
+
+  m_Pieces.insert(m_Pieces.begin() + i + 1, second);
+  m_Offsets.insert(m_Offsets.begin() + i + 1, offset);
+
+  return i + 1;
+}
+
+const wxExHexBuffer::wxExHexChange wxExHexBuffer::Undo()
+{
+  wxExHexChange change;
+
+  if (!CanUndo()) return change;
+
+  m_Editing = false;
+
+  const auto& patches(m_Journal[--m_Done]);
+
+  for (auto it = patches.rbegin(); it != patches.rend(); ++it)
+  {
+    Patch(it->m_Offset, Length(it->m_Inserted), it->m_Removed);
+    Add(change,
+      it->m_Offset, Length(it->m_Inserted), Length(it->m_Removed));
+  }
+
+  return change;
+}
+
+void wxExHexBuffer::Update(size_t piece)
+{
+  m_Offsets.resize(m_Pieces.size() + 1);
+
+  for (auto i = piece; i < m_Pieces.size(); i++)
+  {
+    m_Offsets[i + 1] = m_Offsets[i] + m_Pieces[i].m_Length;
+  }
+}
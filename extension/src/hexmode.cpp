@@ -5,7 +5,9 @@
 // Copyright: (c) 2018 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <array>
 #include <regex>
+#include <vector>
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
@@ -35,33 +37,27 @@ int GetHexNumberFromUser(
     -1: std::any_cast<int>(dlg.GetItemValue(message));
 }
 
-const std::string MakeLine(wxExSTC* stc, const std::string& buffer, 
-  wxFileOffset offset, wxFileOffset bytesPerLine, wxFileOffset eachHexField)
+// The hex field of each byte.
+const std::array<char, 256 * 3>& HexTable()
 {
-  std::string field_hex, field_ascii;
-  
-  auto count = buffer.size() - offset;
-  count = (bytesPerLine < count ? bytesPerLine : count);
-
-  for (wxFileOffset byte = 0; byte < count; byte++)
-  {
-    const unsigned char c = buffer[offset + byte];
-
-    char buff[4];
-    sprintf(buff, "%02X ", c);
-    field_hex += buff;
-    field_ascii += Printable(c, stc);
-  }
+  static const auto table = [] {
+    const char* digits = "0123456789ABCDEF";
+    std::array<char, 256 * 3> table;
+    for (int c = 0; c < 256; c++)
+    {
+      table[c * 3] = digits[c >> 4];
+      table[c * 3 + 1] = digits[c & 0x0f];
+      table[c * 3 + 2] = ' ';
+    }
+    return table;}();
 
-  const auto field_spaces = std::string(
-    (bytesPerLine - count)* eachHexField,
-    ' ');
-      
-  return field_hex + field_spaces + field_ascii +
-    (buffer.size() - offset > bytesPerLine ?
-       stc->GetEOL(): std::string());
+  return table;
 }
 
+// Number of lines rendered more than needed, so scrolling
+// does not render lines each time.
+const int RENDER_AHEAD = 4096;
+
 // If bytesPerLine is changed, update Convert.
 wxExHexMode::wxExHexMode(wxExSTC* stc, wxFileOffset bytesPerLine)
   : m_STC(stc)
@@ -80,8 +76,15 @@ void wxExHexMode::Activate()
   m_STC->SetViewWhiteSpace(wxSTC_WS_INVISIBLE);
   m_STC->BeginUndoAction();
   
-  wxCharBuffer buffer(m_STC->GetTextRaw());
-  SetText(std::string(buffer.data(), buffer.length()));
+  const wxCharBuffer buffer(m_STC->GetTextRaw());
+  m_Buffer.Assign(std::string(buffer.data(), buffer.length()));
+  
+  if (m_STC->GetModify())
+  {
+    m_Buffer.ClearSavePoint();
+  }
+  
+  Refresh();
   
   wxExLexers::Get()->Apply(m_STC);
 }
@@ -90,25 +93,33 @@ void wxExHexMode::AppendText(const std::string& buffer)
 {
   if (!m_Active) return;
 
-  m_Buffer += buffer;
-  m_BufferOriginal = m_Buffer;
+  // If all was rendered, the text appended is rendered as well.
+  const bool rendered = (m_Rendered == m_Buffer.GetSize());
 
-  std::string text;
+  m_Buffer.Append(buffer);
 
-  text.reserve(
-    // offset:
-    (1 + 1) * buffer.size() / m_BytesPerLine + 
-    // hex field:
-    m_EachHexField * buffer.size() + 
-    // ascii field:
-    buffer.size());
+  RenderLines(rendered ? m_Rendered / m_BytesPerLine: 0);
+}
 
-  for (wxFileOffset offset = 0; offset < buffer.size(); offset += m_BytesPerLine)
+void wxExHexMode::Changed(
+  size_t offset, size_t length, bool resized, bool render)
+{
+  if (m_Changed.m_Length == 0)
   {
-    text += MakeLine(m_STC, buffer, offset, m_BytesPerLine, m_EachHexField);
+    m_Changed = {offset, std::max<size_t>(length, 1), resized};
+  }
+  else
+  {
+    const auto end = std::max(m_Changed.m_Offset + m_Changed.m_Length, offset + length);
+    m_Changed.m_Offset = std::min(m_Changed.m_Offset, offset);
+    m_Changed.m_Length = std::max<size_t>(end - m_Changed.m_Offset, 1);
+    m_Changed.m_Resized = m_Changed.m_Resized || resized;
   }
 
-  m_STC->AppendTextRaw(text.data(), text.size());
+  if (render)
+  {
+    Render();
+  }
 }
 
 void wxExHexMode::ControlCharDialog(const std::string& caption)
@@ -155,7 +166,11 @@ void wxExHexMode::Deactivate()
   m_STC->SetViewEOL(wxConfigBase::Get()->ReadBool(_("End of line"), false));
   m_STC->SetViewWhiteSpace(wxConfigBase::Get()->ReadLong(_("Whitespace visible"), wxSTC_WS_INVISIBLE));
   m_STC->ClearDocument(false);
-  m_STC->AppendTextRaw(m_Buffer.data(), m_Buffer.size());
+  m_Rendered = 0;
+  m_Changed = wxExHexBuffer::wxExHexChange();
+  
+  const auto text(m_Buffer.Get());
+  m_STC->AppendTextRaw(text.data(), text.size());
   m_STC->BraceHighlight(wxSTC_INVALID_POSITION, wxSTC_INVALID_POSITION);
 }
 
@@ -175,12 +190,12 @@ bool wxExHexMode::GotoDialog()
 {
   long val;
   if ((val = wxGetNumberFromUser(
-    _("Input") + wxString::Format(" 0 - %d:", m_Buffer.size() - 1),
+    _("Input") + wxString::Format(" 0 - %d:", m_Buffer.GetSize() - 1),
     wxEmptyString,
     _("Enter Byte Offset"),
     m_Goto, // initial value
     0,
-    m_Buffer.size() - 1,
+    m_Buffer.GetSize() - 1,
     m_STC)) < 0)
   {
     return false;
@@ -228,6 +243,228 @@ bool wxExHexMode::Insert(const std::string& text, int pos)
     wxExHexModeLine(this, pos).Insert(text);
 }
   
+void wxExHexMode::Redo()
+{
+  if (!m_Active) return;
+
+  const auto change(m_Buffer.Redo());
+
+  if (change.m_Length > 0)
+  {
+    Changed(change.m_Offset, change.m_Length, change.m_Resized, true);
+  }
+}
+
+void wxExHexMode::Refresh()
+{
+  if (!m_Active) return;
+
+  // Render at least the lines that were rendered, so the position is kept.
+  const int lines = m_Rendered / m_BytesPerLine;
+  
+  m_STC->SelectNone();
+  m_STC->PositionSave();
+  m_STC->ClearDocument(false);
+  m_Rendered = 0;
+  m_Changed = wxExHexBuffer::wxExHexChange();
+  
+  RenderLines(std::max(lines, m_STC->GetFirstVisibleLine() + m_STC->LinesOnScreen()));
+
+  m_STC->PositionRestore();
+}
+
+void wxExHexMode::Render()
+{
+  if (!m_Active || m_Changed.m_Length == 0) return;
+
+  const auto change(m_Changed);
+  m_Changed = wxExHexBuffer::wxExHexChange();
+
+  // Lines not yet rendered are rendered from the buffer anyhow,
+  // bytes inserted just after the last rendered byte are rendered here.
+  if (change.m_Offset > m_Rendered || 
+     (change.m_Offset == m_Rendered && !change.m_Resized)) return;
+
+  const auto first = change.m_Offset / m_BytesPerLine;
+  
+  m_STC->SelectNone();
+  m_STC->PositionSave();
+
+  if (change.m_Resized)
+  {
+    // All bytes after the change moved, render these again, 
+    // at least the lines that were rendered.
+    const int lines = m_Rendered / m_BytesPerLine;
+    const auto pos = (first > 0 ? m_STC->GetLineEndPosition(first - 1): 0);
+    
+    m_STC->DeleteRange(pos, m_STC->GetTextLength() - pos);
+    m_Rendered = first * m_BytesPerLine;
+    
+    RenderLines(std::max(lines, m_STC->GetFirstVisibleLine() + m_STC->LinesOnScreen()));
+  }
+  else
+  {
+    // Only the lines containing the change are rendered again.
+    const auto to = std::min<size_t>(m_Rendered, 
+      ((change.m_Offset + change.m_Length - 1) / m_BytesPerLine + 1) * m_BytesPerLine);
+    
+    m_STC->wxStyledTextCtrl::Replace(
+      m_STC->PositionFromLine(first),
+      to == m_Rendered ? m_STC->GetTextLength(): m_STC->PositionFromLine(to / m_BytesPerLine),
+      MakeLines(first * m_BytesPerLine, to));
+  }
+  
+  m_STC->PositionRestore();
+}
+
+void wxExHexMode::RenderChanges()
+{
+  m_Buffer.EndEdit();
+  
+  Render();
+}
+
+bool wxExHexMode::RenderFind(const std::string& text, bool forward)
+{
+  const auto size = m_Buffer.GetSize();
+
+  if (!m_Active || text.empty() || m_Rendered >= size) return false;
+
+  const auto flags = m_STC->GetSearchFlags();
+
+  if (flags & wxSTC_FIND_REGEXP)
+  {
+    RenderAll();
+    return true;
+  }
+
+  std::vector<std::string> finds{text};
+
+  if (std::regex_match(text, std::regex("([0-9A-Fa-f]{2} ?)+")))
+  {
+    std::string bytes;
+
+    for (size_t i = 0; i < text.size(); i += (text[i + 2] == ' ' ? 3: 2))
+    {
+      bytes += (char)std::stoi(text.substr(i, 2), nullptr, 16);
+    }
+
+    finds.emplace_back(bytes);
+  }
+
+  // The end of the occurrence to render.
+  auto end = std::string::npos;
+
+  for (const auto& find : finds)
+  {
+    // Occurrences ending in the lines rendered are on the stc already.
+    const auto pos = (forward ? 
+      m_Buffer.Search(find, 
+        m_Rendered >= find.size() ? m_Rendered - find.size() + 1: 0,
+        flags & wxSTC_FIND_MATCHCASE):
+      m_Buffer.SearchLast(find, flags & wxSTC_FIND_MATCHCASE));
+
+    if (pos != std::string::npos && pos + find.size() > m_Rendered)
+    {
+      end = (end == std::string::npos ? pos + find.size():
+        forward ? std::min(end, pos + find.size()): std::max(end, pos + find.size()));
+    }
+  }
+
+  if (end == std::string::npos) return false;
+
+  RenderLines((end - 1) / m_BytesPerLine);
+
+  return true;
+}
+
+void wxExHexMode::RenderLines(int line)
+{
+  const size_t size = m_Buffer.GetSize();
+
+  if (!m_Active || 
+      line < 0 ||
+      m_Rendered >= size || 
+      ((size_t)line + 1) * m_BytesPerLine <= m_Rendered)
+  {
+    return;
+  }
+
+  const size_t end = std::min<size_t>(size, 
+    ((size_t)line + 1 + RENDER_AHEAD) * m_BytesPerLine);
+  
+  // Rendering is not an edit.
+  const bool modified = m_STC->GetModify();
+  const bool readonly = m_STC->GetReadOnly();
+  
+  m_STC->SetReadOnly(false);
+  m_STC->SetUndoCollection(false);
+
+  if (const size_t partial = m_Rendered % m_BytesPerLine; partial > 0)
+  {
+    // The last line is not complete, render it again.
+    const auto pos = m_STC->PositionFromLine(m_Rendered / m_BytesPerLine);
+    m_STC->DeleteRange(pos, m_STC->GetTextLength() - pos);
+    m_Rendered -= partial;
+  }
+  else if (m_Rendered > 0 && 
+    m_STC->GetLineCount() == (int)(m_Rendered / m_BytesPerLine))
+  {
+    // The last line was the last one, and has no eol yet.
+    m_STC->AppendTextRaw(m_STC->GetEOL().c_str());
+  }
+
+  const auto text(MakeLines(m_Rendered, end));
+
+  m_STC->AppendTextRaw(text.data(), text.size());
+  m_Rendered = end;
+
+  m_STC->SetUndoCollection(true);
+  m_STC->SetReadOnly(readonly);
+
+  if (!modified)
+  {
+    m_STC->SetSavePoint();
+  }
+}
+
+const std::string wxExHexMode::MakeLines(size_t from, size_t to)
+{
+  const auto& hex(HexTable());
+  const auto eol(m_STC->GetEOL());
+
+  std::array<char, 256> printable;
+  for (int c = 0; c < 256; c++) printable[c] = Printable(c, m_STC);
+
+  std::string text, bytes(m_BytesPerLine, 0);
+  text.reserve(((to - from) / m_BytesPerLine + 1) * 
+    (m_BytesPerLine * (m_EachHexField + 1) + eol.size()));
+
+  for (size_t offset = from; offset < to; offset += m_BytesPerLine)
+  {
+    const auto count = m_Buffer.Copy(offset, m_BytesPerLine, bytes.data());
+
+    for (size_t i = 0; i < count; i++)
+    {
+      text.append(&hex[(unsigned char)bytes[i] * 3], m_EachHexField);
+    }
+
+    text.append((m_BytesPerLine - count) * m_EachHexField, ' ');
+
+    for (size_t i = 0; i < count; i++)
+    {
+      text += printable[(unsigned char)bytes[i]];
+    }
+
+    if (offset + m_BytesPerLine < m_Buffer.GetSize())
+    {
+      text += eol;
+    }
+  }
+
+  return text;
+}
+
 bool wxExHexMode::Replace(char c, int pos)
 {
   return pos == -1 ? 
@@ -246,6 +483,9 @@ bool wxExHexMode::ReplaceTarget(const std::string& replacement, bool settext)
     return false;
   }
 
+  // All replacements are undone at once.
+  m_Buffer.BeginEdit();
+  
   // If we have:
   // 30 31 32 33 34 35
   // RT: 31 32 -> 39
@@ -283,6 +523,11 @@ bool wxExHexMode::ReplaceTarget(const std::string& replacement, bool settext)
 
   m_STC->SetTargetEnd(m_STC->GetTargetStart() + replacement.size() * m_EachHexField);
   
+  if (settext)
+  {
+    RenderChanges();
+  }
+  
   return true;
 }
   
@@ -316,23 +561,29 @@ void wxExHexMode::SetText(const std::string text)
 {
   if (!m_Active) return;
 
-  m_Buffer.clear();
-  m_BufferOriginal.clear();
-
-  m_STC->SelectNone();
-  m_STC->PositionSave();
-  m_STC->ClearDocument(false);
+  m_Buffer.Assign(text);
+  m_Buffer.ClearSavePoint();
   
-  AppendText(text);
-
-  m_STC->PositionRestore();
+  Refresh();
 }
   
 void wxExHexMode::Undo()
 {
   if (m_Active)
   {
-    m_Buffer = m_BufferOriginal;
+    const auto change(m_Buffer.Undo());
+
+    if (change.m_Length > 0)
+    {
+      Changed(change.m_Offset, change.m_Length, change.m_Resized, true);
+
+      if (!m_Buffer.IsModified())
+      {
+        m_STC->SetSavePoint();
+      }
+    }
+
+    return;
   }
   
   // For hex mode the first min_size bytes should be hex fields (or space).
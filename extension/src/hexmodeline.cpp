@@ -60,10 +60,12 @@ wxExHexModeLine::wxExHexModeLine(wxExHexMode* hex,
       m_LineNo++;
     }
 
+    m_Hex->RenderLines(m_LineNo);
     m_Line = m_Hex->GetSTC()->GetLine(m_LineNo);
   }
   else
   {
+    m_Hex->RenderLines(pos_or_offset >> 4);
     m_Hex->GetSTC()->GotoLine(pos_or_offset >> 4);
     m_Hex->GetSTC()->SelectNone();
     m_ColumnNo = (pos_or_offset & 0x0f);
@@ -78,14 +80,10 @@ bool wxExHexModeLine::Delete(int count, bool settext)
   
   if (IsReadOnly() || 
     index == wxSTC_INVALID_POSITION || 
-    (size_t)index >= m_Hex->m_Buffer.length()) return false;
+    (size_t)index >= m_Hex->m_Buffer.GetSize()) return false;
 
-  m_Hex->m_Buffer.erase(index, count);
-  
-  if (settext)
-  {
-    m_Hex->SetText(m_Hex->m_Buffer);
-  }
+  m_Hex->m_Buffer.Erase(index, count);
+  m_Hex->Changed(index, count, true, settext);
   
   return true;
 }
@@ -151,8 +149,8 @@ bool wxExHexModeLine::Insert(const std::string& text)
   
   if (m_ColumnNo >= m_StartAsciiField)
   {
-    m_Hex->m_Buffer.insert(index, text);
-    m_Hex->SetText(m_Hex->m_Buffer);
+    m_Hex->m_Buffer.Insert(index, text);
+    m_Hex->Changed(index, text.size(), true, true);
 
     if (m_ColumnNo + text.size() >= m_Hex->m_BytesPerLine + m_StartAsciiField)
     {
@@ -174,8 +172,9 @@ bool wxExHexModeLine::Insert(const std::string& text)
     if (text.size() != 2 || 
        (!isxdigit(text[0]) && !isxdigit(text[1]))) return false;
 
-    m_Hex->m_Buffer.insert(index, 1, std::stoi(text.substr(0, 2), nullptr, 16));
-    m_Hex->SetText(m_Hex->m_Buffer);
+    m_Hex->m_Buffer.Insert(index, 
+      std::string(1, std::stoi(text.substr(0, 2), nullptr, 16)));
+    m_Hex->Changed(index, 1, true, true);
   }
 
   return true;
@@ -240,7 +239,7 @@ bool wxExHexModeLine::Replace(char c)
     return false;
   }
 
-  m_Hex->m_Buffer[index] = c;
+  m_Hex->m_Buffer.Replace(index, c);
   
   return true;
 }
@@ -251,12 +250,8 @@ void wxExHexModeLine::Replace(const std::string& hex, bool settext)
   
   if (IsReadOnly() || index == wxSTC_INVALID_POSITION) return;
   
-  m_Hex->m_Buffer[index] = std::stoi(hex, nullptr, 16);
-
-  if (settext)
-  {
-    m_Hex->SetText(m_Hex->m_Buffer);
-  }
+  m_Hex->m_Buffer.Replace(index, std::stoi(hex, nullptr, 16));
+  m_Hex->Changed(index, 1, false, settext);
 }
   
 void wxExHexModeLine::ReplaceHex(int value)
@@ -278,7 +273,7 @@ void wxExHexModeLine::ReplaceHex(int value)
   m_Hex->GetSTC()->wxStyledTextCtrl::Replace(
     pos + OtherField(), pos + OtherField() + 1, Printable(value, m_Hex->GetSTC()));
       
-  m_Hex->m_Buffer[index] = value;
+  m_Hex->m_Buffer.Replace(index, value);
 }
 
 void wxExHexModeLine::SetPos(const wxKeyEvent& event)
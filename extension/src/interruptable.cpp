@@ -11,8 +11,8 @@
 #endif
 #include <wx/extension/interruptable.h>
 
-bool wxExInterruptable::m_Cancelled = false;
-bool wxExInterruptable::m_Running = false;
+std::atomic_bool wxExInterruptable::m_Cancelled {false};
+std::atomic_bool wxExInterruptable::m_Running {false};
 
 bool wxExInterruptable::Cancel()
 {
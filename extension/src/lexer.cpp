@@ -6,6 +6,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <numeric>
 #include <pugixml.hpp>
@@ -26,23 +27,7 @@ wxExLexer& wxExLexer::operator=(const wxExLexer& l)
 {
   if (this != &l)
   {
-    m_CommentBegin = l.m_CommentBegin;
-    m_CommentBegin2 = l.m_CommentBegin2;
-    m_CommentEnd = l.m_CommentEnd;
-    m_CommentEnd2 = l.m_CommentEnd2;
-    m_DisplayLexer = l.m_DisplayLexer;
-    m_EdgeColumns = l.m_EdgeColumns;
-    m_EdgeMode = l.m_EdgeMode;
-    m_Extensions = l.m_Extensions;
-    m_IsOk = l.m_IsOk;
-    m_Keywords = l.m_Keywords;
-    m_KeywordsSet = l.m_KeywordsSet;
-    m_Language = l.m_Language;
-    m_LineSize = l.m_LineSize;
-    m_Previewable = l.m_Previewable;
-    m_Properties = l.m_Properties;
-    m_ScintillaLexer = l.m_ScintillaLexer;
-    m_Styles = l.m_Styles;
+    m_Definition = l.m_Definition;
     
     if (m_STC != nullptr && l.m_STC != nullptr)
     {
@@ -53,6 +38,31 @@ wxExLexer& wxExLexer::operator=(const wxExLexer& l)
   return *this;
 }
   
+wxExLexer::wxExLexerDefinition& wxExLexer::Edit()
+{
+  if (m_Definition.use_count() > 1)
+  {
+    m_Definition = std::make_shared<wxExLexerDefinition>(*m_Definition);
+  }
+
+  // The definition is always created non const, and is not shared.
+  auto& d(const_cast<wxExLexerDefinition&>(*m_Definition));
+
+  // Each edit gets a new version, never used by any other definition.
+  static std::atomic<size_t> version {0};
+  d.m_Version = ++version;
+
+  return d;
+}
+
+const std::shared_ptr<const wxExLexer::wxExLexerDefinition>& 
+  wxExLexer::EmptyDefinition()
+{
+  static const std::shared_ptr<const wxExLexerDefinition> definition(
+    std::make_shared<wxExLexerDefinition>());
+  return definition;
+}
+
 // Adds the specified keywords to the keywords map and the keywords set.
 // The text might contain the keyword set after a ':'.
 // Returns false if specified set is illegal or value is empty.
@@ -63,6 +73,8 @@ bool wxExLexer::AddKeywords(const std::string& value, int setno)
     return false;
   }
   
+  auto& d(Edit());
+  
   std::set<std::string> keywords_set;
 
   for (wxExTokenizer tkz(value, "\r\n "); tkz.HasMoreTokens(); )
@@ -86,7 +98,7 @@ bool wxExLexer::AddKeywords(const std::string& value, int setno)
         {
           if (!keywords_set.empty())
           {
-            m_KeywordsSet.insert({setno, keywords_set});
+            d.m_KeywordsSet.insert({setno, keywords_set});
             keywords_set.clear();
           }
 
@@ -105,12 +117,12 @@ bool wxExLexer::AddKeywords(const std::string& value, int setno)
     }
 
     keywords_set.insert(keyword);
-    m_Keywords.insert(keyword);
+    d.m_Keywords.insert(keyword);
   }
 
-  if (const auto& it = m_KeywordsSet.find(setno); it == m_KeywordsSet.end())
+  if (const auto& it = d.m_KeywordsSet.find(setno); it == d.m_KeywordsSet.end())
   {
-    m_KeywordsSet.insert({setno, keywords_set});
+    d.m_KeywordsSet.insert({setno, keywords_set});
   }
   else
   {
@@ -126,7 +138,7 @@ bool wxExLexer::Apply() const
 
   m_STC->ClearDocumentStyle();
 
-  for (const auto& it : m_Properties)
+  for (const auto& it : m_Definition->m_Properties)
   {
     it.ApplyReset(m_STC);
   }
@@ -141,15 +153,15 @@ bool wxExLexer::Apply() const
 
   if (wxExLexers::Get()->GetThemeOk())
   {
-    for (const auto& k : m_KeywordsSet)
+    for (const auto& k : m_Definition->m_KeywordsSet)
     {
       m_STC->SetKeyWords(k.first, wxExGetStringSet(k.second));
     }
 
     wxExLexers::Get()->Apply(m_STC);
 
-    for (const auto& p : m_Properties) p.Apply(m_STC);
-    for (const auto& s : m_Styles) s.Apply(m_STC);
+    for (const auto& p : m_Definition->m_Properties) p.Apply(m_STC);
+    for (const auto& s : m_Definition->m_Styles) s.Apply(m_STC);
   }
 
   // And finally colour the entire document.
@@ -163,6 +175,8 @@ bool wxExLexer::Apply() const
 
 void wxExLexer::AutoMatch(const std::string& lexer)
 {
+  auto& d(Edit());
+
   if (const auto& l(wxExLexers::Get()->FindByName(lexer));
     l.GetScintillaLexer().empty())
   {
@@ -172,7 +186,7 @@ void wxExLexer::AutoMatch(const std::string& lexer)
       if (const auto& macro = wxExLexers::Get()->GetThemeMacros().find(it.first);
         macro != wxExLexers::Get()->GetThemeMacros().end())
       {
-        m_Styles.emplace_back(it.second, macro->second);
+        d.m_Styles.emplace_back(it.second, macro->second);
       }
       else
       {
@@ -180,7 +194,7 @@ void wxExLexer::AutoMatch(const std::string& lexer)
         if (const auto& style = std::find_if(wxExLexers::Get()->GetThemeMacros().begin(), wxExLexers::Get()->GetThemeMacros().end(), 
           [&](auto const& e) {return it.first.find(e.first) != std::string::npos;});
           style != wxExLexers::Get()->GetThemeMacros().end())
-          m_Styles.emplace_back(it.second, style->second);
+          d.m_Styles.emplace_back(it.second, style->second);
       }
     }
   }
@@ -188,29 +202,31 @@ void wxExLexer::AutoMatch(const std::string& lexer)
   {
     // Copy styles and properties, and not keywords,
     // so your derived display lexer can have it's own keywords.
-    m_Styles = l.m_Styles;
-    m_Properties = l.m_Properties;
+    d.m_Styles = l.m_Definition->m_Styles;
+    d.m_Properties = l.m_Definition->m_Properties;
     
-    m_CommentBegin = l.m_CommentBegin;
-    m_CommentBegin2 = l.m_CommentBegin2;
-    m_CommentEnd = l.m_CommentEnd;
-    m_CommentEnd2 = l.m_CommentEnd2;
+    d.m_CommentBegin = l.m_Definition->m_CommentBegin;
+    d.m_CommentBegin2 = l.m_Definition->m_CommentBegin2;
+    d.m_CommentEnd = l.m_Definition->m_CommentEnd;
+    d.m_CommentEnd2 = l.m_Definition->m_CommentEnd2;
   }
 }
 
 const std::string wxExLexer::CommentComplete(const std::string& comment) const
 {
-  if (m_CommentEnd.empty()) return std::string();
+  const auto& d(*m_Definition);
+
+  if (d.m_CommentEnd.empty()) return std::string();
   
   // Fill out rest of comment with spaces, and comment end string.
-  if (const int n = m_LineSize - comment.size() - m_CommentEnd.size(); n <= 0) 
+  if (const int n = d.m_LineSize - comment.size() - d.m_CommentEnd.size(); n <= 0) 
   {
     return std::string();
   }
   else
   {
     const auto blanks = std::string(n, ' ');
-    return blanks + m_CommentEnd;
+    return blanks + d.m_CommentEnd;
   }
 }
 
@@ -255,12 +271,12 @@ const std::string wxExLexer::GetKeywordsString(
 {
   if (keyword_set == -1)
   {
-    return wxExGetStringSet(m_Keywords, min_size, prefix);
+    return wxExGetStringSet(m_Definition->m_Keywords, min_size, prefix);
   }
   else
   {
-    if (const auto& it = m_KeywordsSet.find(keyword_set);
-      it != m_KeywordsSet.end())
+    if (const auto& it = m_Definition->m_KeywordsSet.find(keyword_set);
+      it != m_Definition->m_KeywordsSet.end())
     {
       return wxExGetStringSet(it->second, min_size, prefix);
     }
@@ -271,14 +287,14 @@ const std::string wxExLexer::GetKeywordsString(
 
 bool wxExLexer::IsKeyword(const std::string& word) const
 {
-  return m_Keywords.find(word) != m_Keywords.end();
+  return m_Definition->m_Keywords.find(word) != m_Definition->m_Keywords.end();
 }
 
 bool wxExLexer::KeywordStartsWith(const std::string& word) const
 {
-  const auto& it = m_Keywords.lower_bound(word);
+  const auto& it = m_Definition->m_Keywords.lower_bound(word);
   return 
-    it != m_Keywords.end() &&
+    it != m_Definition->m_Keywords.end() &&
     it->find(word) == 0;
 }
 
@@ -314,7 +330,9 @@ const std::string wxExLexer::MakeSingleLineComment(
   bool fill_out_with_space,
   bool fill_out) const
 {
-  if (m_CommentBegin.empty() && m_CommentEnd.empty())
+  const auto& d(*m_Definition);
+
+  if (d.m_CommentBegin.empty() && d.m_CommentEnd.empty())
   {
     return std::string(text);
   }
@@ -322,7 +340,7 @@ const std::string wxExLexer::MakeSingleLineComment(
   // First set the fill_out_character.
   char fill_out_character;
 
-  if (fill_out_with_space || m_ScintillaLexer == "hypertext")
+  if (fill_out_with_space || d.m_ScintillaLexer == "hypertext")
   {
     fill_out_character = ' ';
   }
@@ -330,18 +348,18 @@ const std::string wxExLexer::MakeSingleLineComment(
   {
     if (text.empty())
     {
-      if (m_CommentBegin == m_CommentEnd)
+      if (d.m_CommentBegin == d.m_CommentEnd)
            fill_out_character = '-';
-      else fill_out_character = m_CommentBegin[m_CommentBegin.size() - 1];
+      else fill_out_character = d.m_CommentBegin[d.m_CommentBegin.size() - 1];
     }
     else   fill_out_character = ' ';
   }
 
-  std::string out = m_CommentBegin + fill_out_character + std::string(text);
+  std::string out = d.m_CommentBegin + fill_out_character + std::string(text);
 
   // Fill out characters (prevent filling out spaces)
   if (fill_out && 
-      (fill_out_character != ' ' || !m_CommentEnd.empty()))
+      (fill_out_character != ' ' || !d.m_CommentEnd.empty()))
   {
     if (const auto fill_chars = UsableCharactersPerLine() - text.size(); fill_chars > 0)
     {
@@ -349,32 +367,15 @@ const std::string wxExLexer::MakeSingleLineComment(
     }
   }
 
-  if (!m_CommentEnd.empty()) out += fill_out_character + m_CommentEnd;
+  if (!d.m_CommentEnd.empty()) out += fill_out_character + d.m_CommentEnd;
 
   return out;
 }
 
 void wxExLexer::Reset()
 {
-  m_CommentBegin.clear();
-  m_CommentBegin2.clear();
-  m_CommentEnd.clear();
-  m_CommentEnd2.clear();
-  m_DisplayLexer.clear();
-  m_EdgeColumns.clear();
-  m_Extensions.clear();
-  m_Keywords.clear();
-  m_KeywordsSet.clear();
-  m_Language.clear();
-  m_Properties.clear();
-  m_ScintillaLexer.clear();
-  m_Styles.clear();
-
-  m_IsOk = false;
-  m_Previewable = false;
-
-  m_EdgeMode = wxExEdgeMode::ABSENT;
-  
+  m_Definition = EmptyDefinition();
+
   if (m_STC != nullptr)
   {
     ((wxStyledTextCtrl *)m_STC)->SetLexer(wxSTC_LEX_NULL);
@@ -386,30 +387,32 @@ void wxExLexer::Reset()
 
 void wxExLexer::Set(const pugi::xml_node* node)
 {
-  m_ScintillaLexer = node->attribute("name").value();
-  m_IsOk = !m_ScintillaLexer.empty();
+  auto& d(Edit());
+
+  d.m_ScintillaLexer = node->attribute("name").value();
+  d.m_IsOk = !d.m_ScintillaLexer.empty();
 
-  if (!m_IsOk)
+  if (!d.m_IsOk)
   {
     wxExLog("missing lexer") << *node;
   }
   else
   {
-    m_DisplayLexer = (!node->attribute("display").empty() ?
+    d.m_DisplayLexer = (!node->attribute("display").empty() ?
       node->attribute("display").value():
-      m_ScintillaLexer);
-    m_Extensions = node->attribute("extensions").value();
-    m_Language = node->attribute("language").value();
-    m_Previewable = !node->attribute("preview").empty();
+      d.m_ScintillaLexer);
+    d.m_Extensions = node->attribute("extensions").value();
+    d.m_Language = node->attribute("language").value();
+    d.m_Previewable = !node->attribute("preview").empty();
 
     if (const std::string em(node->attribute("edgemode").value()); !em.empty())
     {
       if (em == "none")
-        m_EdgeMode = wxExEdgeMode::NONE;
+        d.m_EdgeMode = wxExEdgeMode::NONE;
       else if (em == "line")
-        m_EdgeMode = wxExEdgeMode::LINE;
+        d.m_EdgeMode = wxExEdgeMode::LINE;
       else if (em == "background")
-        m_EdgeMode = wxExEdgeMode::BACKGROUND;
+        d.m_EdgeMode = wxExEdgeMode::BACKGROUND;
       else
         wxExLog("unsupported edge mode") << em << *node;
     }
@@ -419,7 +422,7 @@ void wxExLexer::Set(const pugi::xml_node* node)
     {
       try
       {
-        m_EdgeColumns = wxExTokenizer(ec).Tokenize();
+        d.m_EdgeColumns = wxExTokenizer(ec).Tokenize();
       }
       catch (std::exception& e)
       {
@@ -429,21 +432,21 @@ void wxExLexer::Set(const pugi::xml_node* node)
  
     AutoMatch((!node->attribute("macro").empty() ?
       node->attribute("macro").value():
-      m_ScintillaLexer));
+      d.m_ScintillaLexer));
 
-    if (m_ScintillaLexer == "hypertext")
+    if (d.m_ScintillaLexer == "hypertext")
     {
       // As our lexers.xml files cannot use xml comments,
       // add them here.
-      m_CommentBegin = "<!--";
-      m_CommentEnd = "-->";
+      d.m_CommentBegin = "<!--";
+      d.m_CommentEnd = "-->";
     }
 
     for (const auto& child: node->children())
     {
       if (strcmp(child.name(), "styles") == 0)
       {
-        wxExNodeStyles(&child, m_ScintillaLexer, m_Styles);
+        wxExNodeStyles(&child, d.m_ScintillaLexer, d.m_Styles);
       }
       else if (strcmp(child.name(), "keywords") == 0)
       {
@@ -482,19 +485,19 @@ void wxExLexer::Set(const pugi::xml_node* node)
       }
       else if (strcmp(child.name(), "properties") == 0)
       {
-        if (!m_Properties.empty())
+        if (!d.m_Properties.empty())
         {
           wxExLog("properties already available") << child;
         }
 
-        wxExNodeProperties(&child, m_Properties);
+        wxExNodeProperties(&child, d.m_Properties);
       }
       else if (strcmp(child.name(), "comments") == 0)
       {
-        m_CommentBegin = child.attribute("begin1").value();
-        m_CommentEnd = child.attribute("end1").value();
-        m_CommentBegin2 = child.attribute("begin2").value();
-        m_CommentEnd2 = child.attribute("end2").value();
+        d.m_CommentBegin = child.attribute("begin1").value();
+        d.m_CommentEnd = child.attribute("end1").value();
+        d.m_CommentBegin2 = child.attribute("begin2").value();
+        d.m_CommentEnd2 = child.attribute("end2").value();
       }
     }
   }
@@ -510,7 +513,7 @@ bool wxExLexer::Set(const std::string& lexer, bool fold)
     VLOG(9) << "lexer is not known: " << lexer;
   }
   
-  return m_IsOk;
+  return m_Definition->m_IsOk;
 }
 
 bool wxExLexer::Set(const wxExLexer& lexer, bool fold)
@@ -518,9 +521,9 @@ bool wxExLexer::Set(const wxExLexer& lexer, bool fold)
   (*this) = (lexer.GetScintillaLexer().empty() && m_STC != nullptr ?
      wxExLexers::Get()->FindByText(m_STC->GetLine(0).ToStdString()): lexer);
 
-  if (m_STC == nullptr) return m_IsOk;
+  if (m_STC == nullptr) return m_Definition->m_IsOk;
 
-  m_STC->SetLexerLanguage(m_ScintillaLexer);
+  m_STC->SetLexerLanguage(m_Definition->m_ScintillaLexer);
 
   const bool ok = (((wxStyledTextCtrl *)m_STC)->GetLexer()) != wxSTC_LEX_NULL;
 
@@ -529,7 +532,7 @@ bool wxExLexer::Set(const wxExLexer& lexer, bool fold)
   // Set edges only if lexer is set.
   if (ok)
   {
-    switch (m_EdgeMode)
+    switch (m_Definition->m_EdgeMode)
     {
       case wxExEdgeMode::ABSENT: break;
         
@@ -539,7 +542,7 @@ bool wxExLexer::Set(const wxExLexer& lexer, bool fold)
         
       case wxExEdgeMode::LINE:
 #if wxCHECK_VERSION(3,1,1)
-        m_STC->SetEdgeMode(m_EdgeColumns.size() <= 1 ? 
+        m_STC->SetEdgeMode(m_Definition->m_EdgeColumns.size() <= 1 ? 
           wxSTC_EDGE_LINE: wxSTC_EDGE_MULTILINE); 
 #else
         m_STC->SetEdgeMode(wxSTC_EDGE_LINE);
@@ -551,17 +554,17 @@ bool wxExLexer::Set(const wxExLexer& lexer, bool fold)
         break;
     }
         
-    switch (m_EdgeColumns.size())
+    switch (m_Definition->m_EdgeColumns.size())
     {
       case 0: break;
 
       case 1:
-        m_STC->SetEdgeColumn(m_EdgeColumns.front());
+        m_STC->SetEdgeColumn(m_Definition->m_EdgeColumns.front());
         break;
 
 #if wxCHECK_VERSION(3,1,1)
       default:
-        for (const auto& c : m_EdgeColumns)
+        for (const auto& c : m_Definition->m_EdgeColumns)
         {
           m_STC->MultiEdgeAddLine(c, m_STC->GetEdgeColour());
         }
@@ -576,22 +579,26 @@ bool wxExLexer::Set(const wxExLexer& lexer, bool fold)
     m_STC->Fold();
   }
 
-  return m_ScintillaLexer.empty() || ok;
+  return m_Definition->m_ScintillaLexer.empty() || ok;
 }
 
 void wxExLexer::SetProperty(const std::string& name, const std::string& value)
 {
-  if (const auto& it = std::find_if(m_Properties.begin(), m_Properties.end(), 
+  auto& d(Edit());
+
+  if (const auto& it = std::find_if(d.m_Properties.begin(), d.m_Properties.end(), 
     [name](auto const& e) {return e.GetName() == name;});
-    it != m_Properties.end()) it->Set(value);
-  else m_Properties.emplace_back(name, value);
+    it != d.m_Properties.end()) it->Set(value);
+  else d.m_Properties.emplace_back(name, value);
 }
 
 size_t wxExLexer::UsableCharactersPerLine() const
 {
+  const auto& d(*m_Definition);
+
   // We adjust this here for
   // the space the beginning and end of the comment characters occupy.
-  return m_LineSize
-    - ((m_CommentBegin.size() != 0) ? m_CommentBegin.size() + 1 : 0)
-    - ((m_CommentEnd.size() != 0) ? m_CommentEnd.size() + 1 : 0);
+  return d.m_LineSize
+    - ((d.m_CommentBegin.size() != 0) ? d.m_CommentBegin.size() + 1 : 0)
+    - ((d.m_CommentEnd.size() != 0) ? d.m_CommentEnd.size() + 1 : 0);
 }
@@ -14,11 +14,12 @@
 #include <numeric>
 #include <regex>
 #include <wx/config.h>
+#include <wx/extension/glob.h>
 #include <wx/extension/lexers.h>
 #include <wx/extension/log.h>
 #include <wx/extension/stc.h>
 #include <wx/extension/tokenizer.h>
-#include <wx/extension/util.h> // for wxExMatchesOneOf
+#include <wx/extension/util.h>
 
 // Constructor for lexers from specified filename.
 // This must be an existing xml file containing all lexers.
@@ -112,10 +113,36 @@ void wxExLexers::ApplyMarginTextStyle(wxExSTC* stc, int line) const
 
 const wxExLexer wxExLexers::FindByFileName(const std::string& fullname) const
 {
-  const auto& it = std::find_if(m_Lexers.begin(), m_Lexers.end(), 
-    [fullname](auto const& e) {return !e.GetExtensions().empty() && 
-       wxExMatchesOneOf(fullname, e.GetExtensions());});
-  return it != m_Lexers.end() ? *it: wxExLexer();
+  // The first lexer that matches is used, so find the lowest index.
+  auto index = m_Lexers.size();
+
+  if (const auto& it = m_IndexFileNames.find(fullname); 
+    it != m_IndexFileNames.end())
+  {
+    index = it->second;
+  }
+
+  if (const auto pos = fullname.rfind('.'); pos != std::string::npos)
+  {
+    if (const auto& it = m_IndexExtensions.find(fullname.substr(pos)); 
+      it != m_IndexExtensions.end() && it->second < index)
+    {
+      index = it->second;
+    }
+  }
+
+  for (const auto& it : m_IndexWildcards)
+  {
+    if (it.first >= index) break;
+
+    if (it.second.Matches(fullname))
+    {
+      index = it.first;
+      break;
+    }
+  }
+
+  return index < m_Lexers.size() ? m_Lexers[index]: wxExLexer();
 }
 
 const wxExLexer wxExLexers::FindByName(const std::string& name) const
@@ -129,12 +156,12 @@ const wxExLexer wxExLexers::FindByText(const std::string& text) const
 {
   try
   {
-    const std::string filtered(std::regex_replace(text, 
-      std::regex("[ \t\n\v\f\r]+$"), "", std::regex_constants::format_sed));
+    const std::string filtered(text.substr(0, 
+      text.find_last_not_of(" \t\n\v\f\r") + 1));
 
     for (const auto& t : m_Texts) 
     {
-      if (std::regex_search(filtered, std::regex(t.second)))
+      if (std::regex_search(filtered, t.second))
         return FindByName(t.first);
     }
   }
@@ -202,6 +229,9 @@ bool wxExLexers::LoadDocument()
   m_Markers.clear();
   m_Styles.clear();
   m_Texts.clear();
+  m_IndexExtensions.clear();
+  m_IndexFileNames.clear();
+  m_IndexWildcards.clear();
   m_ThemeColours[m_NoTheme] = m_DefaultColours;
   m_ThemeMacros[m_NoTheme] = std::map<std::string, std::string>{};  
 
@@ -217,6 +247,8 @@ bool wxExLexers::LoadDocument()
     }
   }
 
+  Index();
+
   // Check config, but do not create one.
   if (auto* config = wxConfigBase::Get(false); config != nullptr)
   {
@@ -254,6 +286,38 @@ bool wxExLexers::LoadDocument()
   return true;
 }
 
+void wxExLexers::Index()
+{
+  for (size_t i = 0; i < m_Lexers.size(); i++)
+  {
+    std::string wildcards;
+
+    for (wxExTokenizer tkz(m_Lexers[i].GetExtensions(), ";"); tkz.HasMoreTokens(); )
+    {
+      // If a key is already present, the first lexer is kept.
+      if (const auto pattern(tkz.GetNextToken()); !wxExGlob::IsWildcard(pattern))
+      {
+        m_IndexFileNames.insert({pattern, i});
+      }
+      else if (
+        pattern.size() > 2 && pattern.find("*.") == 0 &&
+        pattern.find_first_of("*?.", 2) == std::string::npos)
+      {
+        m_IndexExtensions.insert({pattern.substr(1), i});
+      }
+      else
+      {
+        wildcards += (wildcards.empty() ? "": ";") + pattern;
+      }
+    }
+
+    if (!wildcards.empty())
+    {
+      m_IndexWildcards.emplace_back(i, wxExGlob(wildcards));
+    }
+  }
+}
+
 void wxExLexers::ParseNodeFolding(const pugi::xml_node& node)
 {
   wxExTokenizer fields(node.text().get(), ",");
@@ -318,7 +382,14 @@ void wxExLexers::ParseNodeGlobal(const pugi::xml_node& node)
     }
     else if (strcmp(child.name(), "text") == 0)
     {
-      m_Texts.push_back({child.attribute("no").value(), child.text().get()});
+      try
+      {
+        m_Texts.push_back({child.attribute("no").value(), std::regex(child.text().get())});
+      }
+      catch (std::regex_error& e)
+      {
+        wxExLog(e) << "text:" << child.text().get();
+      }
     }
   }
 }
@@ -30,7 +30,7 @@ wxExListItem::wxExListItem(
   , m_FileSpec(lv->GetItemText(itemnumber, _("Type")))
 {
   SetId(itemnumber);
-  m_IsReadOnly = (m_ListView->GetItemData(GetId()) > 0);
+  m_IsReadOnly = m_ListView->IsItemReadOnly(GetId());
 }
 
 wxExListItem::wxExListItem(
@@ -45,7 +45,7 @@ wxExListItem::wxExListItem(
   SetId(-1);
 }
 
-void wxExListItem::Insert(long index)
+void wxExListItem::Insert(long index, bool statusbar)
 {
   SetId(index == -1 ? m_ListView->GetItemCount(): index);
   
@@ -70,13 +70,24 @@ void wxExListItem::Insert(long index)
     SetText(filename);
   }
 
-  ((wxListView* )m_ListView)->InsertItem(*this);
+  if (m_ListView->IsVirtual())
+  {
+    m_ListView->GetStore()->Insert(GetId());
+    m_ListView->SetItemCount(m_ListView->GetStore()->GetRows());
+  }
+  else
+  {
+    ((wxListView* )m_ListView)->InsertItem(*this);
+  }
   
-  wxExFrame::UpdateStatusBar(m_ListView);
+  if (statusbar)
+  {
+    wxExFrame::UpdateStatusBar(m_ListView);
+  }
 
   Update();
 
-  if (col > 0)
+  if (col > 0 || m_ListView->IsVirtual())
   {
     m_ListView->SetItem(GetId(), col, filename);
   }
@@ -92,15 +103,18 @@ void wxExListItem::SetItem(const std::string& col_name, const std::string& text)
 
 void wxExListItem::SetReadOnly(bool readonly)
 {
-  SetTextColour(readonly ? 
-    wxConfigBase::Get()->ReadObject(_("Readonly colour"), *wxRED):
-    wxConfigBase::Get()->ReadObject(_("Foreground colour"), *wxBLACK));
+  if (!m_ListView->IsVirtual())
+  {
+    SetTextColour(readonly ? 
+      wxConfigBase::Get()->ReadObject(_("Readonly colour"), *wxLIGHT_GREY):
+      wxConfigBase::Get()->ReadObject(_("Foreground colour"), *wxBLACK));
 
-  ((wxListView* )m_ListView)->SetItem(*this);
+    ((wxListView* )m_ListView)->SetItem(*this);
+  }
 
   // Using GetTextColour did not work, so keep state in boolean.
   m_IsReadOnly = readonly;
-  m_ListView->SetItemData(GetId(), m_IsReadOnly);
+  m_ListView->SetItemReadOnly(GetId(), m_IsReadOnly);
 }
 
 void wxExListItem::Update()
@@ -109,7 +123,14 @@ void wxExListItem::Update()
     m_ListView->GetData().Image() == IMAGE_FILE_ICON && 
     m_Path.GetStat().IsOk() ? wxExGetIconID(m_Path): -1);
 
-  ((wxListView *)m_ListView)->SetItem(*this);
+  if (m_ListView->IsVirtual())
+  {
+    m_ListView->GetStore()->SetImage(GetId(), GetImage());
+  }
+  else
+  {
+    ((wxListView *)m_ListView)->SetItem(*this);
+  }
 
   SetReadOnly(m_Path.GetStat().IsReadOnly());
 
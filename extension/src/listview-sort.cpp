@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      listview-sort.cpp
+// Purpose:   Implementation of wxExListViewSortKeys class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <thread>
+#include <wx/extension/listview-sort.h>
+
+namespace
+{
+  // Lists smaller than this are sorted by the calling thread only.
+  const size_t min_parallel_size = 100000;
+}
+
+void wxExListViewSortKeys::Add(const std::string& key)
+{
+  m_Strings.emplace_back(key);
+
+  if (!m_MatchCase)
+  {
+    for (auto& c : m_Strings.back()) c = std::toupper((unsigned char)c);
+  }
+}
+
+const std::vector<long> wxExListViewSortKeys::Sort(bool ascending) const
+{
+  std::vector<long> order(GetSize());
+  std::iota(order.begin(), order.end(), 0);
+
+  if      (!m_Ints.empty()) Sort(order, m_Ints, ascending);
+  else if (!m_Floats.empty()) Sort(order, m_Floats, ascending);
+  else if (!m_Strings.empty()) Sort(order, m_Strings, ascending);
+
+  return order;
+}
+
+template <typename T> void wxExListViewSortKeys::Sort(
+  std::vector<long>& order, const std::vector<T>& keys, bool ascending) const
+{
+  const auto compare = [&](long x, long y) {
+    return ascending ? keys[x] < keys[y]: keys[y] < keys[x];};
+
+  const size_t threads = std::min(
+    (size_t)std::thread::hardware_concurrency(), order.size() / min_parallel_size);
+
+  if (threads <= 1)
+  {
+    std::stable_sort(order.begin(), order.end(), compare);
+    return;
+  }
+
+  // Sort each part using its own thread, then merge adjacent parts, 
+  // both keep equal items in order, so the result is stable.
+  std::vector<size_t> bounds;
+
+  for (size_t i = 0; i <= threads; i++)
+  {
+    bounds.emplace_back(order.size() * i / threads);
+  }
+
+  std::vector<std::thread> workers;
+
+  for (size_t i = 0; i < threads; i++)
+  {
+    workers.emplace_back([&, i] {
+      std::stable_sort(
+        order.begin() + bounds[i], order.begin() + bounds[i + 1], compare);});
+  }
+
+  for (auto& t : workers) t.join();
+
+  for (size_t step = 1; step < threads; step *= 2)
+  {
+    for (size_t i = 0; i + step < threads; i += 2 * step)
+    {
+      std::inplace_merge(
+        order.begin() + bounds[i], 
+        order.begin() + bounds[i + step], 
+        order.begin() + bounds[std::min(i + 2 * step, threads)], 
+        compare);
+    }
+  }
+}
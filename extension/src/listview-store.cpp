@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      listview-store.cpp
+// Purpose:   Implementation of wxExListViewStore class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <wx/extension/listview-store.h>
+
+namespace
+{
+  // A text cell keeps the arena offset and the length,
+  // texts longer than this are truncated.
+  const uint64_t max_text_length = 0xFFFFFF;
+
+  // Returns true if text is the result of std::to_string on an integer
+  // that fits in a cell.
+  bool IsCanonical(const std::string& text)
+  {
+    const size_t start = (!text.empty() && text[0] == '-' ? 1: 0);
+
+    if (text.size() == start || text.size() - start > 18 ||
+       (text[start] == '0' && text.size() > start + 1) ||
+       (text == "-0"))
+    {
+      return false;
+    }
+
+    return std::all_of(text.begin() + start, text.end(),
+      [](char c) {return c >= '0' && c <= '9';});
+  }
+}
+
+void wxExListViewStore::AddColumn(wxExStoreType type)
+{
+  m_Columns.push_back({type, std::vector<uint64_t>(m_Data.size(), 0)});
+}
+
+long wxExListViewStore::AddRow()
+{
+  return Insert(GetRows());
+}
+
+void wxExListViewStore::Clear()
+{
+  for (auto& col : m_Columns)
+  {
+    col.m_Cells.clear();
+  }
+
+  m_Data.clear();
+  m_Images.clear();
+  m_Arena.clear();
+  m_Strings.resize(1);
+  m_StringIds = {{std::string_view(), 0}};
+}
+
+long wxExListViewStore::CopyRow(long row)
+{
+  for (auto& col : m_Columns)
+  {
+    col.m_Cells.push_back(col.m_Cells[row]);
+  }
+
+  m_Data.push_back(m_Data[row]);
+  m_Images.push_back(m_Images[row]);
+
+  return GetRows() - 1;
+}
+
+void wxExListViewStore::Delete(long row)
+{
+  for (auto& col : m_Columns)
+  {
+    col.m_Cells.erase(col.m_Cells.begin() + row);
+  }
+
+  m_Data.erase(m_Data.begin() + row);
+  m_Images.erase(m_Images.begin() + row);
+}
+
+const std::string wxExListViewStore::Get(long row, int col) const
+{
+  const auto& column(m_Columns[col]);
+  const auto cell = column.m_Cells[row];
+
+  if (column.m_Type == STORE_INT)
+  {
+    return cell == 0 ? std::string(): std::to_string((int64_t)cell >> 1);
+  }
+
+  return std::string(View(cell, column.m_Type));
+}
+
+long wxExListViewStore::Insert(long row)
+{
+  for (auto& col : m_Columns)
+  {
+    col.m_Cells.insert(col.m_Cells.begin() + row, 0);
+  }
+
+  m_Data.insert(m_Data.begin() + row, 0);
+  m_Images.insert(m_Images.begin() + row, -1);
+
+  return row;
+}
+
+uint64_t wxExListViewStore::Intern(const std::string& text)
+{
+  if (const auto& it = m_StringIds.find(text); it != m_StringIds.end())
+  {
+    return it->second;
+  }
+
+  m_Strings.emplace_back(text);
+  m_StringIds.insert({m_Strings.back(), m_Strings.size() - 1});
+
+  return m_Strings.size() - 1;
+}
+
+void wxExListViewStore::Permute(const std::vector<long>& order)
+{
+  std::vector<uint64_t> cells(order.size());
+
+  for (auto& col : m_Columns)
+  {
+    for (size_t i = 0; i < order.size(); i++)
+    {
+      cells[i] = col.m_Cells[order[i]];
+    }
+
+    col.m_Cells.swap(cells);
+  }
+
+  std::vector<long> data(order.size());
+  std::vector<int> images(order.size());
+
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    data[i] = m_Data[order[i]];
+    images[i] = m_Images[order[i]];
+  }
+
+  m_Data.swap(data);
+  m_Images.swap(images);
+}
+
+void wxExListViewStore::Set(long row, int col, const std::string& text)
+{
+  auto& column(m_Columns[col]);
+
+  if (column.m_Type == STORE_INT && !text.empty() && !IsCanonical(text))
+  {
+    for (auto& cell : column.m_Cells)
+    {
+      cell = (cell == 0 ? 0: Intern(std::to_string((int64_t)cell >> 1)));
+    }
+
+    column.m_Type = STORE_STRING;
+  }
+
+  if (text.empty())
+  {
+    column.m_Cells[row] = 0;
+    return;
+  }
+
+  switch (column.m_Type)
+  {
+    case STORE_INT:
+      column.m_Cells[row] = ((uint64_t)std::stoll(text) << 1) | 1;
+      break;
+
+    case STORE_STRING:
+      column.m_Cells[row] = Intern(text);
+      break;
+
+    case STORE_TEXT:
+      {
+      const auto length = std::min((uint64_t)text.size(), max_text_length);
+      column.m_Cells[row] = ((uint64_t)m_Arena.size() << 24) | length;
+      m_Arena.append(text, 0, length);
+      }
+      break;
+  }
+}
+
+const std::string_view wxExListViewStore::View(
+  uint64_t cell, wxExStoreType type) const
+{
+  if (type == STORE_STRING)
+  {
+    return m_Strings[cell];
+  }
+
+  return std::string_view(m_Arena).substr(cell >> 24, cell & max_text_length);
+}
@@ -5,7 +5,7 @@
 // Copyright: (c) 2018 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <cctype>
+#include <limits>
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
@@ -26,8 +26,10 @@
 #include <wx/extension/lexer.h>
 #include <wx/extension/log.h>
 #include <wx/extension/listitem.h>
+#include <wx/extension/listview-sort.h>
 #include <wx/extension/menu.h>
 #include <wx/extension/printing.h>
+#include <wx/extension/searcher.h>
 #include <wx/extension/tokenizer.h>
 #include <wx/extension/util.h>
 #include <easylogging++.h>
@@ -62,18 +64,6 @@ bool GetTime(const std::string& text, time_t& t)
   return true;
 }
 
-std::string IgnoreCase(const std::string& text)
-{
-  std::string output(text);
-
-  if (!wxExFindReplaceData::Get()->MatchCase())
-  {
-    for (auto & c : output) c = std::toupper(c);
-  }
-
-  return output;
-}
-
 #if wxUSE_DRAG_AND_DROP
 // FileDropTarget is already used by wxExFrame.
 class DropTarget : public wxFileDropTarget
@@ -190,13 +180,16 @@ wxExListView::wxExListView(const wxExListViewData& data)
       data.Window().Id(), 
       data.Window().Pos(), 
       data.Window().Size(), 
-      data.Window().Style() == DATA_NUMBER_NOT_SET ? wxLC_REPORT: data.Window().Style(), 
+      data.Window().Style() == DATA_NUMBER_NOT_SET ? 
+        wxLC_REPORT | (data.Type() == LIST_FIND ? wxLC_VIRTUAL: 0): 
+        data.Window().Style(), 
       data.Control().Validator() != nullptr ? *data.Control().Validator(): wxDefaultValidator, 
       data.Window().Name())
   , m_ImageHeight(16) // not used if IMAGE_FILE_ICON is used, then 16 is fixed
   , m_ImageWidth(16)
   , m_Data(this, wxExListViewData(data).Image(data.Type() == LIST_NONE ? 
       data.Image(): IMAGE_FILE_ICON))
+  , m_Store(HasFlag(wxLC_VIRTUAL) ? std::make_unique<wxExListViewStore>(): nullptr)
 {
   ConfigGet();
 
@@ -310,6 +303,20 @@ wxExListView::wxExListView(const wxExListViewData& data)
     }});
 #endif
 
+  // The control sends these for each delete, also when called through
+  // a wxListCtrl pointer, so the store always follows the control.
+  Bind(wxEVT_LIST_DELETE_ALL_ITEMS, [=](wxListEvent& event) {
+    event.Skip();
+    if (IsVirtual()) m_Store->Clear();});
+
+  Bind(wxEVT_LIST_DELETE_ITEM, [=](wxListEvent& event) {
+    event.Skip();
+    if (IsVirtual() &&
+        event.GetIndex() >= 0 && event.GetIndex() < m_Store->GetRows())
+    {
+      m_Store->Delete(event.GetIndex());
+    }});
+
   Bind(wxEVT_LIST_ITEM_ACTIVATED, [=] (wxListEvent& event) {
     ItemActivated(event.GetIndex());});
   
@@ -456,6 +463,14 @@ bool wxExListView::AppendColumns(const std::vector <wxExColumn>& cols)
 
     mycol.SetColumn(GetColumnCount() - 1);
     m_Columns.emplace_back(mycol);
+
+    if (IsVirtual())
+    {
+      m_Store->AddColumn(
+        mycol.GetType() == wxExColumn::COL_INT ? wxExListViewStore::STORE_INT:
+        mycol.GetText() == _("Line") ? wxExListViewStore::STORE_TEXT:
+          wxExListViewStore::STORE_STRING);
+    }
       
     Bind(wxEVT_MENU,  [=](wxCommandEvent& event) {
       SortColumn(event.GetId() - ID_COL_FIRST, SORT_TOGGLE);},
@@ -487,7 +502,7 @@ const std::string wxExListView::BuildPage()
 
     for (auto col = 0; col < GetColumnCount(); col++)
     {
-      text << "<td>" << wxListView::GetItemText(i, col) << "\n";
+      text << "<td>" << GetCellText(i, col) << "\n";
     }
   }
 
@@ -592,6 +607,9 @@ void wxExListView::ConfigGet()
   SetSingleStyle(wxLC_NO_HEADER, !cfg->ReadBool(_("Header"), false));
   SetSingleStyle(wxLC_SINGLE_SEL, cfg->ReadBool(_("Single selection"), false));
   
+  m_ReadOnlyAttr.SetTextColour(
+    cfg->ReadObject(_("Readonly colour"), *wxLIGHT_GREY));
+
   ItemsUpdate();
 }
   
@@ -643,8 +661,7 @@ bool wxExListView::FindNext(const std::string& text, bool find_next)
     return false;
   }
 
-  std::string text_use = IgnoreCase(text);
-
+  const wxExSearcher searcher(text, wxExFindReplaceData::Get()->MatchCase());
   const auto firstselected = GetFirstSelected();
   static bool recursive = false;
   static long start_item;
@@ -668,22 +685,21 @@ bool wxExListView::FindNext(const std::string& text, bool find_next)
     index != end_item && match == -1;
     (find_next ? index++: index--))
   {
-    std::string text;
-
     for (int col = 0; col < GetColumnCount() && match == -1; col++)
     {
-      text = IgnoreCase(std::string(wxListView::GetItemText(index, col)));
+      const std::string text(GetCellText(index, col));
 
       if (wxExFindReplaceData::Get()->MatchWord())
       {
-        if (text == text_use)
+        if (text.size() == searcher.GetFindString().size() && 
+            searcher.Find(text) == 0)
         {
           match = index;
         }
       }
       else
       {
-        if (text.find(text_use) != std::string::npos)
+        if (searcher.Find(text) != std::string::npos)
         {
           match = index;
         }
@@ -742,16 +758,29 @@ unsigned int wxExListView::GetArtID(const wxArtID& artid)
   }
 }
 
+const std::string wxExListView::GetCellText(long item_number, int col) const
+{
+  if (!IsVirtual())
+  {
+    return wxListView::GetItemText(item_number, col).ToStdString();
+  }
+
+  return 
+    item_number < 0 || item_number >= m_Store->GetRows() || 
+    col < 0 || col >= m_Store->GetColumns() ? 
+      std::string(): m_Store->Get(item_number, col);
+}
+
 const std::string wxExListView::GetItemText(
   long item_number, const std::string& col_name) const 
 {
   if (col_name.empty())
   {
-    return wxListView::GetItemText(item_number);
+    return GetCellText(item_number, 0);
   }
   
   const int col = FindColumn(col_name);
-  return col < 0 ? std::string(): wxListView::GetItemText(item_number, col).ToStdString();
+  return col < 0 ? std::string(): GetCellText(item_number, col);
 }
 
 bool wxExListView::InsertItem(const std::vector < std::string > & item)
@@ -778,7 +807,13 @@ bool wxExListView::InsertItem(const std::vector < std::string > & item)
         case wxExColumn::COL_STRING: break;
       }
 
-      if (no == 0)
+      if (no == 0 && IsVirtual())
+      {
+        index = m_Store->AddRow();
+        SetItemCount(m_Store->GetRows());
+        if (!SetItem(index, no, col)) return false;
+      }
+      else if (no == 0)
       {
         if (index = wxListView::InsertItem(GetItemCount(), col); index == -1) return false;
       }
@@ -940,7 +975,7 @@ const std::string wxExListView::ItemToText(long item_number) const
   {
     for (auto i = 0; i < GetItemCount(); i++)
     {
-      text += wxListView::GetItemText(i) + "\n";
+      text += GetCellText(i, 0) + "\n";
     }
     
     return text;
@@ -963,13 +998,13 @@ const std::string wxExListView::ItemToText(long item_number) const
       }
 
     case LIST_FOLDER:
-      return wxListView::GetItemText(item_number);
+      return GetCellText(item_number, 0);
       break;
     
     default:
       for (int col = 0; col < GetColumnCount(); col++)
       {
-        text += wxListView::GetItemText(item_number, col);
+        text += GetCellText(item_number, col);
 
         if (col < GetColumnCount() - 1)
         {
@@ -983,7 +1018,13 @@ const std::string wxExListView::ItemToText(long item_number) const
 
 void wxExListView::ItemsUpdate()
 {
-  if (m_Data.Type() != LIST_NONE)
+  // A virtual list retrieves its items when shown,
+  // updating all items would defeat that.
+  if (IsVirtual())
+  {
+    Refresh();
+  }
+  else if (m_Data.Type() != LIST_NONE)
   {
     for (auto i = 0; i < GetItemCount(); i++)
     {
@@ -992,6 +1033,22 @@ void wxExListView::ItemsUpdate()
   }
 }
 
+wxListItemAttr* wxExListView::OnGetItemAttr(long item_number) const
+{
+  return m_Store->GetData(item_number) > 0 ? 
+    const_cast<wxListItemAttr*>(&m_ReadOnlyAttr): nullptr;
+}
+
+int wxExListView::OnGetItemImage(long item_number) const
+{
+  return m_Store->GetImage(item_number);
+}
+
+wxString wxExListView::OnGetItemText(long item_number, long col) const
+{
+  return m_Store->Get(item_number, col);
+}
+
 void wxExListView::Print()
 {
 #if wxUSE_HTML & wxUSE_PRINTING_ARCHITECTURE
@@ -1008,63 +1065,23 @@ void wxExListView::PrintPreview()
 #endif
 }
 
-template <typename T> int Compare(T x, T y)
+// The item data is set to the sorted position of the item.
+int wxCALLBACK CompareFunctionCB(wxIntPtr item1, wxIntPtr item2, wxIntPtr sortData)
 {
-  if (x > y) return 1;
-  else if (x < y) return -1;
-  else return 0;
+  return item1 < item2 ? -1: (item1 > item2 ? 1: 0);
 }
 
-std::vector<std::string>* pitems;
-
-int wxCALLBACK CompareFunctionCB(wxIntPtr item1, wxIntPtr item2, wxIntPtr sortData)
+bool wxExListView::SetImage(long item_number, int image)
 {
-  const bool ascending = (sortData > 0);
-  const auto& str1 = (*pitems)[item1];
-  const auto& str2 = (*pitems)[item2];
-
-  switch (const auto type = 
-    (wxExColumn::wxExColumnType)std::abs(sortData); type) 
+  if (!IsVirtual())
   {
-    case wxExColumn::COL_DATE:
-      if (!str1.empty() && !str2.empty())
-      {
-        time_t tm1, tm2;
-        if (!GetTime(str1, tm1) ||
-            !GetTime(str2, tm2)) return false;
-        if (ascending) return Compare((unsigned long)tm1, (unsigned long)tm2);
-        else           return Compare((unsigned long)tm2, (unsigned long)tm1);
-      }
-    break;
-
-    case wxExColumn::COL_FLOAT:
-      if (ascending) return Compare(std::stof(str1), std::stof(str2));
-      else           return Compare(std::stof(str2), std::stof(str1));
-    break;
-
-    case wxExColumn::COL_INT:
-      if (ascending) return Compare(std::stoi(str1), std::stoi(str2));
-      else           return Compare(std::stoi(str2), std::stoi(str1));
-    break;
-
-    case wxExColumn::COL_STRING:
-      if (!wxExFindReplaceData::Get()->MatchCase())
-      {
-        if (ascending) return IgnoreCase(str1).compare(IgnoreCase(str2));
-        else           return IgnoreCase(str2).compare(IgnoreCase(str1));
-      }
-      else
-      {
-        if (ascending) return str1.compare(str2);
-        else           return str2.compare(str1);
-      }
-    break;
-
-    default:
-      wxFAIL;
+    return wxListView::SetItemImage(item_number, image);
   }
 
-  return 0;
+  m_Store->SetImage(item_number, image);
+  RefreshItem(item_number);
+
+  return true;
 }
 
 bool wxExListView::SetItem(
@@ -1084,6 +1101,13 @@ bool wxExListView::SetItem(
       case wxExColumn::COL_STRING: break;
     }
 
+    if (IsVirtual())
+    {
+      m_Store->Set(index, column, text);
+      RefreshItem(index);
+      return true;
+    }
+
     return wxListView::SetItem(index, column, text, imageId);
   }
   catch (std::exception& e)
@@ -1093,6 +1117,19 @@ bool wxExListView::SetItem(
   }
 }
 
+void wxExListView::SetItemReadOnly(long item_number, bool readonly)
+{
+  if (!IsVirtual())
+  {
+    SetItemData(item_number, readonly);
+  }
+  else
+  {
+    m_Store->SetData(item_number, readonly);
+    RefreshItem(item_number);
+  }
+}
+
 bool wxExListView::SortColumn(int column_no, wxExSortType sort_method)
 {
   if (column_no == -1 || column_no >= (int)m_Columns.size())
@@ -1108,22 +1145,51 @@ bool wxExListView::SortColumn(int column_no, wxExSortType sort_method)
   
   sorted_col.SetIsSortedAscending(sort_method);
 
-  std::vector<std::string> items;
-  pitems = &items;
-
-  for (int i = 0; i < GetItemCount(); i++)
+  try
   {
-    items.emplace_back(wxListView::GetItemText(i, column_no));
-    SetItemData(i, i);
-  }
+    // Parse each item once, instead of on each compare.
+    wxExListViewSortKeys keys(wxExFindReplaceData::Get()->MatchCase());
 
-  const wxIntPtr sortdata =
-    (sorted_col.GetIsSortedAscending() ?
-       sorted_col.GetType(): (0 - sorted_col.GetType()));
+    for (long i = 0; i < GetItemCount(); i++)
+    {
+      const auto text(GetCellText(i, column_no));
 
-  try
-  {
-    SortItems(CompareFunctionCB, sortdata);
+      switch (sorted_col.GetType())
+      {
+        case wxExColumn::COL_DATE:
+          if (time_t tm; !text.empty() && GetTime(text, tm)) 
+            keys.Add((int64_t)tm);
+          else 
+            keys.Add(std::numeric_limits<int64_t>::min());
+          break;
+        case wxExColumn::COL_FLOAT: keys.Add(std::stod(text)); break;
+        case wxExColumn::COL_INT: keys.Add((int64_t)std::stoll(text)); break;
+        case wxExColumn::COL_STRING: keys.Add(text); break;
+        default: wxFAIL;
+      }
+    }
+
+    const auto order(keys.Sort(sorted_col.GetIsSortedAscending()));
+
+    if (IsVirtual())
+    {
+      // Selection is kept by the control on position, not on item.
+      for (auto i = GetFirstSelected(); i != -1; i = GetNextSelected(i))
+      {
+        Select(i, false);
+      }
+
+      m_Store->Permute(order);
+    }
+    else
+    {
+      for (size_t i = 0; i < order.size(); i++)
+      {
+        SetItemData(order[i], i);
+      }
+
+      SortItems(CompareFunctionCB, 0);
+    }
 
     m_SortedColumnNo = column_no;
 
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      mapped-file.cpp
+// Purpose:   Implementation of wxExMappedFile class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <iterator>
+#include <wx/platform.h>
+#include <wx/extension/mapped-file.h>
+#ifdef __UNIX__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+void wxExMappedFile::Close()
+{
+#ifdef __UNIX__
+  if (m_Mapped)
+  {
+    munmap((void*)m_Data, m_Size);
+  }
+#endif
+
+  m_Buffer.clear();
+  m_Buffer.shrink_to_fit();
+  m_Data = nullptr;
+  m_Size = 0;
+  m_Mapped = false;
+  m_Opened = false;
+}
+
+bool wxExMappedFile::Open(const std::string& fullpath)
+{
+  Close();
+
+  if (fullpath.empty())
+  {
+    return false;
+  }
+
+#ifdef __UNIX__
+  const int fd = open(fullpath.c_str(), O_RDONLY);
+
+  if (fd == -1)
+  {
+    return false;
+  }
+
+  if (struct stat st; fstat(fd, &st) == -1 || !S_ISREG(st.st_mode))
+  {
+    close(fd);
+    return false;
+  }
+  else if (st.st_size == 0)
+  {
+    // Nothing to map.
+    m_Opened = true;
+  }
+  else if (void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    data != MAP_FAILED)
+  {
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+    m_Data = (const char*)data;
+    m_Size = st.st_size;
+    m_Mapped = true;
+    m_Opened = true;
+  }
+
+  close(fd);
+
+  return m_Opened || Read(fullpath);
+#else
+  return Read(fullpath);
+#endif
+}
+
+bool wxExMappedFile::Read(const std::string& fullpath)
+{
+  std::ifstream ifs(fullpath, std::ios::binary);
+
+  if (!ifs.is_open())
+  {
+    return false;
+  }
+
+  m_Buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  m_Data = m_Buffer.data();
+  m_Size = m_Buffer.size();
+  m_Opened = true;
+
+  return true;
+}
@@ -21,7 +21,6 @@ const std::string SubstituteTilde(const std::string& text)
 
 wxExPath::wxExPath(const std::experimental::filesystem::path& p)
   : m_path(p)
-  , m_Stat(p.string()) 
   , m_Lexer(wxExLexers::Get(false) != nullptr ? 
       wxExLexers::Get(false)->FindByFileName(p.filename().string()):
       std::string())
@@ -32,6 +31,14 @@ wxExPath::wxExPath(const std::experimental::filesystem::path& p)
   }
 }
 
+wxExPath::wxExPath(
+  const std::experimental::filesystem::path& p, const wxExStat& stat)
+  : wxExPath(p)
+{
+  m_Stat = stat;
+  m_StatSynced = true;
+}
+
 wxExPath::wxExPath(const std::string& path, const std::string& name)
   : wxExPath(std::experimental::filesystem::path(SubstituteTilde(path)).
       append(name).string())
@@ -49,8 +56,15 @@ wxExPath::wxExPath(const char* path)
 }
 
 wxExPath::wxExPath(const wxExPath& r)
-  : wxExPath(r.Path()) 
+  : m_path(r.m_path)
+  , m_Lexer(r.m_Lexer)
+  , m_Stat(r.m_Stat)
+  , m_StatSynced(r.m_StatSynced)
 {
+  if (m_path.empty())
+  {
+    m_path_original = Current();
+  }
 }
 
 wxExPath::wxExPath(const std::vector<std::string> v)
@@ -77,6 +91,7 @@ wxExPath& wxExPath::operator=(const wxExPath& r)
     m_path = r.Path();
     m_Lexer = r.m_Lexer;
     m_Stat = r.m_Stat;
+    m_StatSynced = r.m_StatSynced;
   }
   
   return *this;
@@ -85,6 +100,7 @@ wxExPath& wxExPath::operator=(const wxExPath& r)
 wxExPath& wxExPath::Append(const wxExPath& path)
 {
   m_path /= std::experimental::filesystem::path(path.Path());
+  m_StatSynced = false;
 
   return *this;
 }
@@ -98,6 +114,7 @@ bool wxExPath::Canonical(const std::string& wd)
   }
 
   m_path = std::experimental::filesystem::canonical(m_path, wd);
+  m_StatSynced = false;
 
   return true;
 }
@@ -117,6 +134,17 @@ void wxExPath::Current(const std::string& path)
   }
 }
 
+const wxExStat& wxExPath::GetStat() const
+{
+  if (!m_StatSynced)
+  {
+    m_Stat.Sync(m_path.string());
+    m_StatSynced = true;
+  }
+
+  return m_Stat;
+}
+
 const std::vector<wxExPath> wxExPath::GetPaths() const
 {
   std::vector<wxExPath> v;
@@ -140,6 +168,8 @@ wxExPath& wxExPath::MakeAbsolute(const wxExPath& base)
     m_path.clear();
   }
 
+  m_StatSynced = false;
+
   return *this;
 }
 
@@ -172,9 +202,17 @@ bool wxExPath::OpenMIME() const
   }
 }
 
+bool wxExPath::Sync()
+{
+  m_StatSynced = true;
+
+  return m_Stat.Sync(m_path.string());
+}
+
 wxExPath& wxExPath::ReplaceFileName(const std::string& filename)
 {
   m_path.replace_filename(filename);
+  m_StatSynced = false;
 
   return *this;
 }
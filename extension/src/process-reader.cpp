@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      process-reader.cpp
+// Purpose:   Implementation of class wxExProcessReader
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <wx/stream.h>
+#include <wx/extension/process-reader.h>
+
+// The state shared by the reader and its threads,
+// the threads might outlive the reader.
+struct wxExProcessReaderState
+{
+  std::condition_variable m_Condition;
+  std::mutex m_Mutex;
+  std::function<void()> m_Notify;
+  std::string m_Output;
+  int m_Running {0};
+};
+
+namespace
+{
+  const size_t BLOCK_SIZE = 65536;
+
+  void Collect(
+    wxExProcessReaderState& state, const char* data, size_t size)
+  {
+    std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+    const bool notify = state.m_Output.empty();
+
+    state.m_Output.append(data, size);
+    state.m_Condition.notify_all();
+
+    if (notify && state.m_Notify != nullptr)
+    {
+      state.m_Notify();
+    }
+  }
+
+  void Run(
+    std::shared_ptr<wxExProcessReaderState> state,
+    std::unique_ptr<wxInputStream> stream)
+  {
+    std::string block(BLOCK_SIZE, 0), line;
+
+    while (true)
+    {
+      // Read returns as soon as the pipe has no more data.
+      const auto size = stream->Read(block.data(), block.size()).LastRead();
+
+      if (size == 0) break;
+
+      // If the block is full, more data follows, keep the last partial
+      // line, so lines of different streams are not mixed.
+      if (const auto eol = block.rfind('\n', size - 1);
+        size == block.size() && eol != std::string::npos)
+      {
+        line.append(block.data(), eol + 1);
+        Collect(*state, line.data(), line.size());
+        line.assign(block.data() + eol + 1, size - eol - 1);
+      }
+      else
+      {
+        line.append(block.data(), size);
+        Collect(*state, line.data(), line.size());
+        line.clear();
+      }
+    }
+
+    if (!line.empty())
+    {
+      Collect(*state, line.data(), line.size());
+    }
+
+    std::lock_guard<std::mutex> lock(state->m_Mutex);
+    state->m_Running--;
+    state->m_Condition.notify_all();
+  }
+}
+
+wxExProcessReader::wxExProcessReader(
+  const std::vector<wxInputStream*>& streams, std::function<void()> notify)
+  : m_State(std::make_shared<wxExProcessReaderState>())
+{
+  m_State->m_Notify = notify;
+
+  for (auto* stream : streams)
+  {
+    if (stream == nullptr) continue;
+
+    {
+      std::lock_guard<std::mutex> lock(m_State->m_Mutex);
+      m_State->m_Running++;
+    }
+
+    // A thread blocks on its stream until the process writes or ends,
+    // so it cannot be joined.
+    std::thread(Run, m_State, std::unique_ptr<wxInputStream>(stream)).detach();
+  }
+}
+
+wxExProcessReader::~wxExProcessReader()
+{
+  std::lock_guard<std::mutex> lock(m_State->m_Mutex);
+  m_State->m_Notify = nullptr;
+}
+
+const std::string wxExProcessReader::Get()
+{
+  std::string output;
+
+  std::lock_guard<std::mutex> lock(m_State->m_Mutex);
+  output.swap(m_State->m_Output);
+
+  return output;
+}
+
+bool wxExProcessReader::IsEnded() const
+{
+  std::lock_guard<std::mutex> lock(m_State->m_Mutex);
+  return m_State->m_Running == 0 && m_State->m_Output.empty();
+}
+
+bool wxExProcessReader::Wait(std::chrono::milliseconds ms)
+{
+  std::unique_lock<std::mutex> lock(m_State->m_Mutex);
+
+  return m_State->m_Condition.wait_for(lock, ms, [&] {
+    return !m_State->m_Output.empty() || m_State->m_Running == 0;}) &&
+    !m_State->m_Output.empty();
+}
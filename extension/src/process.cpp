@@ -13,35 +13,17 @@
 #endif
 #include <wx/config.h>
 #include <wx/process.h>
-#include <wx/timer.h>
-#include <wx/txtstrm.h> // for wxTextInputStream
+#include <wx/txtstrm.h> // for wxTextOutputStream
 #include <wx/extension/process.h>
 #include <wx/extension/debug.h>
 #include <wx/extension/itemdlg.h>
 #include <wx/extension/log.h>
 #include <wx/extension/managedframe.h>
+#include <wx/extension/process-reader.h>
 #include <wx/extension/shell.h>
 #include <wx/extension/util.h> // for wxExConfigFirstOf
 #include <easylogging++.h>
 
-#define GET_STREAM(SCOPE)                         \
-{                                                 \
-  if (Is##SCOPE##Available())                     \
-  {                                               \
-    wxTextInputStream tis(*Get##SCOPE##Stream()); \
-                                                  \
-    while (Is##SCOPE##Available())                \
-    {                                             \
-      const char c = tis.GetChar();               \
-                                                  \
-      if (c != 0)                                 \
-      {                                           \
-        text += c;                                \
-      }                                           \
-    }                                             \
-  }                                               \
-};                                                \
-
 class wxExProcessImp : public wxProcess
 {
 public:
@@ -49,9 +31,7 @@ public:
     : wxProcess(wxPROCESS_REDIRECT) 
     , m_Debug(debug)
     , m_Frame(frame)
-    , m_Shell(shell)
-    , m_Timer(std::make_unique<wxTimer>(this)) {
-    Bind(wxEVT_TIMER, [=](wxTimerEvent& event) {Read();});};
+    , m_Shell(shell) {;};
   virtual ~wxExProcessImp() {;};
 
   bool Execute(const std::string& command, const std::string& path);
@@ -67,7 +47,6 @@ private:
     {
       m_pids.erase(it);
     }
-    m_Timer->Stop();
     m_Frame->GetDebug()->GetBreakpoints().clear();
     Read();};
   
@@ -75,7 +54,7 @@ private:
   std::string m_Command, m_StdIn;
   wxExManagedFrame* m_Frame;
   wxExShell* m_Shell;
-  std::unique_ptr<wxTimer> m_Timer;
+  std::unique_ptr<wxExProcessReader> m_Reader;
   wxCriticalSection m_Critical;
   static inline std::vector<int> m_pids;
 };
@@ -315,8 +294,14 @@ bool wxExProcessImp::Execute(
   
   m_pids.push_back(GetPid());
   
+  // The reader takes the output streams, and reads these on its own threads,
+  // as soon as output is available it is read on the main thread.
+  m_Reader = std::make_unique<wxExProcessReader>(
+    std::vector<wxInputStream*>{GetInputStream(), GetErrorStream()},
+    [=] {CallAfter(&wxExProcessImp::Read);});
+  SetPipeStreams(nullptr, GetOutputStream(), nullptr);
+  
   ShowProcess(m_Frame, true);
-  m_Timer->Start(100); // milliseconds
   m_Shell->SetFocus();
   
   return true;
@@ -391,13 +376,11 @@ void wxExProcessImp::Read()
 {
   wxCriticalSectionLocker lock(m_Critical);
   
-  std::string text;
-  GET_STREAM(Input);
-  GET_STREAM(Error);
-  
-  if (!text.empty())
+  if (m_Reader == nullptr) return;
+
+  if (const auto text(m_Reader->Get()); !text.empty())
   {
-    m_Shell->AppendText(
+    m_Shell->AppendOutput(
       // prevent echo of last input
       !m_StdIn.empty() && text.find(m_StdIn) == 0 ?
         text.substr(m_StdIn.length()):
@@ -418,15 +401,13 @@ void wxExProcessImp::Read()
 
 bool wxExProcessImp::Write(const std::string& text)
 {
-  m_Timer->Stop();
-  
   if (m_Command.find("cmd") == 0 ||
       m_Command.find("powershell") == 0)
   {
     m_Shell->DocumentEnd();
   }
     
-  // Write text to process and restart timer.
+  // Write text to process, and show the output that follows at once.
   if (wxOutputStream* os = GetOutputStream(); os != nullptr)
   {
     HandleCommand(text);
@@ -440,9 +421,13 @@ bool wxExProcessImp::Write(const std::string& text)
       std::string(): std::string("\n"));
     wxTextOutputStream(*os).WriteString(text + el);
     m_StdIn = text;
-    wxMilliSleep(10);
+    
+    if (m_Reader != nullptr)
+    {
+      m_Reader->Wait(std::chrono::milliseconds(10));
+    }
+    
     Read();
-    m_Timer->Start();
   }
 
   return true;
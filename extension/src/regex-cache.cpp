@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      regex-cache.cpp
+// Purpose:   Implementation of wxExRegexCache class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <wx/extension/regex-cache.h>
+
+namespace
+{
+  // Most recently used is at the front.
+  struct wxExRegexCacheItem
+  {
+    std::string m_Key;
+    std::shared_ptr<const std::regex> m_Regex;
+  };
+
+  std::list<wxExRegexCacheItem> cache;
+  std::unordered_map<std::string, std::list<wxExRegexCacheItem>::iterator> cache_index;
+  std::mutex cache_mutex;
+  std::atomic<size_t> cache_hits {0}, cache_misses {0};
+}
+
+std::shared_ptr<const std::regex> wxExRegexCache::Get(
+  const std::string& regex, std::regex::flag_type flags)
+{
+  const std::string key(std::to_string(flags) + ":" + regex);
+
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    if (const auto& it = cache_index.find(key); it != cache_index.end())
+    {
+      cache_hits++;
+      cache.splice(cache.begin(), cache, it->second);
+      return cache.front().m_Regex;
+    }
+  }
+
+  // Compile without holding the lock, an invalid pattern throws here.
+  auto compiled = std::make_shared<const std::regex>(regex, flags);
+
+  cache_misses++;
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+
+  if (const auto& it = cache_index.find(key); it != cache_index.end())
+  {
+    return it->second->m_Regex;
+  }
+
+  cache.push_front({key, compiled});
+  cache_index[key] = cache.begin();
+
+  if (cache.size() > GetMaxSize())
+  {
+    cache_index.erase(cache.back().m_Key);
+    cache.pop_back();
+  }
+
+  return compiled;
+}
+
+size_t wxExRegexCache::GetHits()
+{
+  return cache_hits;
+}
+
+size_t wxExRegexCache::GetMisses()
+{
+  return cache_misses;
+}
+
+size_t wxExRegexCache::GetSize()
+{
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  return cache.size();
+}
+
+void wxExRegexCache::Reset()
+{
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  cache.clear();
+  cache_index.clear();
+  cache_hits = 0;
+  cache_misses = 0;
+}
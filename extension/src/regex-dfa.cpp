@@ -0,0 +1,800 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      regex-dfa.cpp
+// Purpose:   Implementation of wxExRegExDFA class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <bitset>
+#include <map>
+#include <queue>
+#include <regex>
+#include <vector>
+#include <wx/extension/regex-dfa.h>
+
+namespace
+{
+  enum wxExRegExNodeType
+  {
+    NODE_CHAR,
+    NODE_EPSILON,
+    NODE_BEGIN,
+    NODE_END,
+    NODE_MATCH,
+  };
+
+  // A node of the nondeterministic automaton.
+  struct wxExRegExNode
+  {
+    wxExRegExNodeType m_Type;
+    std::bitset<256> m_Set;
+    int m_Out {-1}, m_Out1 {-1};
+  };
+
+  struct wxExRegExFragment
+  {
+    int m_Start, m_End;
+  };
+
+  const size_t max_nodes = 10000;
+  const size_t max_states = 4096;
+
+  [[noreturn]] void Error(std::regex_constants::error_type type)
+  {
+    throw std::regex_error(type);
+  }
+
+  void Fold(std::bitset<256>& set)
+  {
+    for (int c = 'a'; c <= 'z'; c++)
+    {
+      if (set[c] || set[c - 'a' + 'A']) 
+      {
+        set.set(c);
+        set.set(c - 'a' + 'A');
+      }
+    }
+  }
+
+  // Parses a regular expression into a nondeterministic automaton
+  // (Thompson construction).
+  class wxExRegExParser
+  {
+  public:
+    wxExRegExParser(const std::string& regex, bool match_case,
+      std::vector<wxExRegExNode>& nodes)
+      : m_RegEx(regex)
+      , m_MatchCase(match_case)
+      , m_Nodes(nodes) {;};
+
+    // Returns the start node.
+    int Parse() {
+      const auto f = Alternative();
+      if (m_Pos < m_RegEx.size()) Error(std::regex_constants::error_paren);
+      m_Nodes[f.m_End].m_Out = Add(NODE_MATCH);
+      return f.m_Start;};
+  private:
+    int Add(wxExRegExNodeType type, const std::bitset<256>& set = {}) {
+      if (m_Nodes.size() >= max_nodes) Error(std::regex_constants::error_complexity);
+      m_Nodes.push_back({type, set});
+      return m_Nodes.size() - 1;};
+
+    wxExRegExFragment Alternative();
+    wxExRegExFragment Atom();
+    wxExRegExFragment Char(const std::bitset<256>& set, bool fold = true);
+    std::bitset<256> Class();
+    wxExRegExFragment Concat();
+    void Concat(wxExRegExFragment& f, const wxExRegExFragment& g) {
+      m_Nodes[f.m_End].m_Out = g.m_Start;
+      f.m_End = g.m_End;};
+    bool Escape(bool in_class, std::bitset<256>& set);
+    bool More() const {return m_Pos < m_RegEx.size();};
+    bool Nullable(const wxExRegExFragment& f) const;
+    char Peek(size_t offset = 0) const {
+      return m_Pos + offset < m_RegEx.size() ? m_RegEx[m_Pos + offset]: 0;};
+    wxExRegExFragment Repeat();
+    
+    const std::string& m_RegEx;
+    const bool m_MatchCase;
+    std::vector<wxExRegExNode>& m_Nodes;
+    size_t m_Pos {0};
+  };
+
+  wxExRegExFragment wxExRegExParser::Alternative()
+  {
+    auto f = Concat();
+
+    while (Peek() == '|')
+    {
+      m_Pos++;
+      const auto g = Concat();
+      const int start = Add(NODE_EPSILON);
+      const int end = Add(NODE_EPSILON);
+      m_Nodes[start].m_Out = f.m_Start;
+      m_Nodes[start].m_Out1 = g.m_Start;
+      m_Nodes[f.m_End].m_Out = end;
+      m_Nodes[g.m_End].m_Out = end;
+      f = {start, end};
+    }
+
+    return f;
+  }
+
+  wxExRegExFragment wxExRegExParser::Atom()
+  {
+    std::bitset<256> set;
+
+    switch (const char c = m_RegEx[m_Pos++]; c)
+    {
+      case '(':
+        if (Peek() == '?')
+        {
+          // Only non capturing groups, no lookahead.
+          if (Peek(1) != ':') Error(std::regex_constants::error_complexity);
+          m_Pos += 2;
+        }
+        {
+          const auto f = Alternative();
+          if (Peek() != ')') Error(std::regex_constants::error_paren);
+          m_Pos++;
+          return f;
+        }
+
+      case '[': return Char(Class(), false);
+
+      case '.': 
+        set.set().reset('\n').reset('\r'); 
+        return Char(set);
+
+      case '^': 
+      case '$': 
+        {
+        const int start = Add(c == '^' ? NODE_BEGIN: NODE_END);
+        const int end = Add(NODE_EPSILON);
+        m_Nodes[start].m_Out = end;
+        return {start, end};
+        }
+
+      case '\\': 
+        Escape(false, set);
+        return Char(set);
+
+      case '*': 
+      case '+': 
+      case '?': Error(std::regex_constants::error_badrepeat);
+      case '{': Error(std::regex_constants::error_badbrace);
+
+      default: 
+        set.set((unsigned char)c);
+        return Char(set);
+    }
+
+    return {};
+  }
+
+  wxExRegExFragment wxExRegExParser::Char(const std::bitset<256>& set, bool fold)
+  {
+    auto use(set);
+    if (!m_MatchCase && fold) Fold(use);
+    const int start = Add(NODE_CHAR, use);
+    const int end = Add(NODE_EPSILON);
+    m_Nodes[start].m_Out = end;
+    return {start, end};
+  }
+
+  std::bitset<256> wxExRegExParser::Class()
+  {
+    std::bitset<256> set;
+    const bool negate = (Peek() == '^');
+    if (negate) m_Pos++;
+
+    for (;;)
+    {
+      if (!More()) Error(std::regex_constants::error_brack);
+
+      if (Peek() == ']')
+      {
+        m_Pos++;
+        break;
+      }
+
+      if (Peek() == '[' && (Peek(1) == ':' || Peek(1) == '=' || Peek(1) == '.'))
+      {
+        Error(std::regex_constants::error_complexity);
+      }
+
+      std::bitset<256> lo;
+      const bool single = (Peek() == '\\' ? (m_Pos++, Escape(true, lo)): 
+        (lo.set((unsigned char)m_RegEx[m_Pos++]), true));
+
+      if (single && Peek() == '-' && Peek(1) != ']' && Peek(1) != 0)
+      {
+        m_Pos++;
+        std::bitset<256> hi;
+        if (!(Peek() == '\\' ? (m_Pos++, Escape(true, hi)): 
+          (hi.set((unsigned char)m_RegEx[m_Pos++]), true)))
+        {
+          Error(std::regex_constants::error_range);
+        }
+
+        int first = 0, last = 0;
+        while (!lo[first]) first++;
+        while (!hi[last]) last++;
+        if (last < first) Error(std::regex_constants::error_range);
+        for (int c = first; c <= last; c++) set.set(c);
+      }
+      else
+      {
+        set |= lo;
+      }
+    }
+
+    if (!m_MatchCase) Fold(set);
+
+    return negate ? ~set: set;
+  }
+
+  wxExRegExFragment wxExRegExParser::Concat()
+  {
+    const int e = Add(NODE_EPSILON);
+    wxExRegExFragment f{e, e};
+
+    while (More() && Peek() != '|' && Peek() != ')')
+    {
+      Concat(f, Repeat());
+    }
+
+    return f;
+  }
+
+  // Returns true if a single character is added to set.
+  bool wxExRegExParser::Escape(bool in_class, std::bitset<256>& set)
+  {
+    if (!More()) Error(std::regex_constants::error_escape);
+
+    const char c = m_RegEx[m_Pos++];
+
+    switch (c)
+    {
+      case 'd': 
+      case 'D': 
+        for (int i = '0'; i <= '9'; i++) set.set(i);
+        if (c == 'D') set.flip();
+        return false;
+
+      case 'w': 
+      case 'W': 
+        for (int i = 0; i < 256; i++) if (isalnum(i) && i < 128) set.set(i);
+        set.set('_');
+        if (c == 'W') set.flip();
+        return false;
+
+      case 's':
+      case 'S':
+        for (const char s : {' ', '\t', '\n', '\r', '\f', '\v'}) set.set(s);
+        if (c == 'S') set.flip();
+        return false;
+
+      case 'b': 
+        if (!in_class) Error(std::regex_constants::error_complexity);
+        set.set('\b');
+        return true;
+
+      case 'f': set.set('\f'); return true;
+      case 'n': set.set('\n'); return true;
+      case 'r': set.set('\r'); return true;
+      case 't': set.set('\t'); return true;
+      case 'v': set.set('\v'); return true;
+      case '0': set.set(0); return true;
+
+      case 'x':
+        if (m_Pos + 2 <= m_RegEx.size() && 
+            isxdigit(m_RegEx[m_Pos]) && isxdigit(m_RegEx[m_Pos + 1]))
+        {
+          set.set(std::stoi(m_RegEx.substr(m_Pos, 2), nullptr, 16));
+          m_Pos += 2;
+          return true;
+        }
+        Error(std::regex_constants::error_escape);
+
+      default:
+        // Backreferences, word boundaries, unicode and control escapes.
+        if (isalnum(c)) Error(std::regex_constants::error_complexity);
+        set.set((unsigned char)c);
+        return true;
+    }
+  }
+
+  // Returns true if the fragment matches without consuming a character.
+  bool wxExRegExParser::Nullable(const wxExRegExFragment& f) const
+  {
+    std::vector<bool> visited(m_Nodes.size());
+    std::vector<int> todo{f.m_Start};
+
+    while (!todo.empty())
+    {
+      const int n = todo.back();
+      todo.pop_back();
+
+      if (n < 0 || visited[n]) continue;
+      if (n == f.m_End) return true;
+      visited[n] = true;
+
+      if (m_Nodes[n].m_Type != NODE_CHAR)
+      {
+        todo.push_back(m_Nodes[n].m_Out);
+        todo.push_back(m_Nodes[n].m_Out1);
+      }
+    }
+
+    return false;
+  }
+
+  wxExRegExFragment wxExRegExParser::Repeat()
+  {
+    const size_t begin = m_Pos;
+    const auto atom = Atom();
+    int min = 0, max = -1; // -1 is infinite
+
+    switch (Peek())
+    {
+      case '*': m_Pos++; break;
+      case '+': m_Pos++; min = 1; break;
+      case '?': m_Pos++; max = 1; break;
+
+      case '{':
+        {
+        const auto number = [&]() {
+          int value = -1;
+          while (isdigit(Peek()))
+          {
+            value = std::max(value, 0) * 10 + (m_RegEx[m_Pos++] - '0');
+            if (value > 1000) Error(std::regex_constants::error_badbrace);
+          }
+          return value;};
+
+        m_Pos++;
+        min = number();
+        max = min;
+
+        if (Peek() == ',')
+        {
+          m_Pos++;
+          max = number();
+        }
+
+        if (min == -1 || Peek() != '}' || (max != -1 && max < min))
+        {
+          Error(std::regex_constants::error_badbrace);
+        }
+
+        m_Pos++;
+        }
+        break;
+
+      default: return atom;
+    }
+
+    // Lazy quantifiers cannot be done by a DFA.
+    if (Peek() == '?') Error(std::regex_constants::error_complexity);
+    if (Peek() == '*' || Peek() == '+' || Peek() == '{')
+    {
+      Error(std::regex_constants::error_badrepeat);
+    }
+
+    // Repeating an atom that matches empty is handled by std::regex,
+    // ECMAScript stops an iteration that matches empty.
+    if (max != 1 && Nullable(atom)) Error(std::regex_constants::error_complexity);
+
+    const size_t end = m_Pos;
+    bool first = true;
+
+    // Parses the atom again for each copy needed.
+    const auto next = [&]() {
+      if (first)
+      {
+        first = false;
+        return atom;
+      }
+      m_Pos = begin;
+      const auto f = Atom();
+      m_Pos = end;
+      return f;};
+
+    const int e = Add(NODE_EPSILON);
+    wxExRegExFragment f{e, e};
+
+    for (int i = 0; i < min; i++)
+    {
+      Concat(f, next());
+    }
+
+    for (int i = min; max == -1 ? i == min: i < max; i++)
+    {
+      const auto g = next();
+      const int start = Add(NODE_EPSILON);
+      const int end = Add(NODE_EPSILON);
+      m_Nodes[start].m_Out = g.m_Start;
+      m_Nodes[start].m_Out1 = end;
+      m_Nodes[g.m_End].m_Out = (max == -1 ? start: end);
+      Concat(f, {start, end});
+    }
+
+    return f;
+  }
+
+  // Appends the char, end and match nodes reachable from node 
+  // without consuming a character to result, in order of priority,
+  // as ECMAScript tries them (first alternative, greedy repeat first).
+  void Closure(
+    const std::vector<wxExRegExNode>& nodes, 
+    int node,
+    bool begin, 
+    bool end,
+    std::vector<bool>& visited,
+    std::vector<int>& result)
+  {
+    std::vector<int> todo{node};
+
+    while (!todo.empty())
+    {
+      const int n = todo.back();
+      todo.pop_back();
+
+      if (n < 0 || visited[n]) continue;
+      visited[n] = true;
+
+      switch (const auto& node = nodes[n]; node.m_Type)
+      {
+        case NODE_EPSILON:
+          todo.push_back(node.m_Out1);
+          todo.push_back(node.m_Out);
+          break;
+
+        case NODE_BEGIN:
+          if (begin) todo.push_back(node.m_Out);
+          break;
+
+        case NODE_END:
+          if (end) todo.push_back(node.m_Out);
+          else result.push_back(n);
+          break;
+
+        default: result.push_back(n);
+      }
+    }
+  }
+
+  // Returns the closure of the nodes, in order of priority.
+  std::vector<int> Closure(
+    const std::vector<wxExRegExNode>& nodes, 
+    const std::vector<int>& from, 
+    bool begin, 
+    bool end)
+  {
+    std::vector<bool> visited(nodes.size());
+    std::vector<int> result;
+
+    for (const auto n : from)
+    {
+      Closure(nodes, n, begin, end, visited, result);
+    }
+
+    return result;
+  }
+
+  bool Contains(
+    const std::vector<wxExRegExNode>& nodes, 
+    const std::vector<int>& v, 
+    wxExRegExNodeType type)
+  {
+    return std::any_of(v.begin(), v.end(), [&](int n) {
+      return nodes[n].m_Type == type;});
+  }
+}
+
+wxExRegExDFA::wxExRegExDFA(const std::string& regex, bool match_case)
+  : m_Pattern(regex)
+  , m_MatchCase(match_case)
+{
+  std::vector<wxExRegExNode> nodes;
+  const int start = wxExRegExParser(regex, match_case, nodes).Parse();
+
+  // Empty matches are handled by std::regex, these differ in
+  // ECMAScript for replacing (a non empty match is tried at the same 
+  // position after an empty match).
+  if (Contains(nodes, Closure(nodes, {start}, true, true), NODE_MATCH))
+  {
+    Error(std::regex_constants::error_complexity);
+  }
+
+  // Bytes that are in the same char nodes share a class.
+  std::map<std::vector<bool>, unsigned char> classes;
+  m_Classes.resize(256);
+
+  for (int c = 0; c < 256; c++)
+  {
+    std::vector<bool> signature;
+
+    for (const auto& node : nodes)
+    {
+      if (node.m_Type == NODE_CHAR) signature.push_back(node.m_Set[c]);
+    }
+
+    const auto it = classes.emplace(signature, classes.size()).first;
+    m_Classes[c] = it->second;
+  }
+
+  m_NoClasses = classes.size();
+
+  std::vector<unsigned char> representative(m_NoClasses);
+  for (int c = 255; c >= 0; c--) representative[m_Classes[c]] = c;
+
+  // The forward automaton, used to find the end of the leftmost-first 
+  // match. A state is a list of nodes in order of priority, 
+  // preceded by -1 as long as a match can still start at a later 
+  // position (lowest priority). Nodes after a match node are removed, 
+  // these have lower priority than the match.
+  std::map<std::vector<int>, int> index;
+  std::vector<std::vector<int>> states;
+  std::queue<int> todo;
+
+  const auto add = [&](const std::vector<int>& from, bool search, bool begin) {
+    auto key(Closure(nodes, from, begin, false));
+
+    if (search)
+    {
+      std::vector<bool> visited(nodes.size());
+      for (const auto n : key) visited[n] = true;
+      Closure(nodes, start, begin, false, visited, key);
+    }
+
+    if (const auto it = std::find_if(key.begin(), key.end(), [&](int n) {
+      return nodes[n].m_Type == NODE_MATCH;}); it != key.end())
+    {
+      key.erase(it + 1, key.end());
+      search = false;
+    }
+
+    if (search) key.insert(key.begin(), -1);
+    if (const auto it = index.find(key); it != index.end()) return it->second;
+    if (states.size() >= max_states) Error(std::regex_constants::error_complexity);
+    index[key] = states.size();
+    states.push_back(key);
+    todo.push(states.size() - 1);
+    return (int)states.size() - 1;};
+
+  m_SearchBegin = add({}, true, true);
+  m_Search = add({}, true, false);
+  m_Dead = add({}, false, false);
+
+  while (!todo.empty())
+  {
+    const int state = todo.front();
+    todo.pop();
+
+    const std::vector<int> key(states[state]);
+    const bool search = (!key.empty() && key[0] == -1);
+    const std::vector<int> active(key.begin() + (search ? 1: 0), key.end());
+
+    m_Accept.resize(states.size());
+    m_AcceptEnd.resize(states.size());
+    m_Next.resize(states.size() * m_NoClasses);
+
+    m_Accept[state] = Contains(nodes, active, NODE_MATCH);
+    m_AcceptEnd[state] = Contains(nodes, Closure(nodes, active, false, true), NODE_MATCH);
+
+    for (size_t c = 0; c < m_NoClasses; c++)
+    {
+      std::vector<int> next;
+
+      for (const auto n : active)
+      {
+        if (nodes[n].m_Type == NODE_CHAR && nodes[n].m_Set[representative[c]])
+        {
+          next.push_back(nodes[n].m_Out);
+        }
+      }
+
+      const int to = add(next, search, false);
+      m_Next.resize(states.size() * m_NoClasses);
+      m_Next[state * m_NoClasses + c] = to;
+    }
+  }
+
+  m_Accept.resize(states.size());
+  m_AcceptEnd.resize(states.size());
+
+  // The reverse automaton, used to find the start of a match from 
+  // its end. A state is the set of char nodes that can consume the 
+  // character before the current position, and lead to a match at 
+  // the end. The first states are for the end itself, 
+  // being the end of the text or not.
+  std::vector<std::vector<int>> reach(nodes.size());
+  std::vector<bool> match(nodes.size()), match_end(nodes.size());
+
+  for (size_t n = 0; n < nodes.size(); n++)
+  {
+    if (nodes[n].m_Type == NODE_CHAR)
+    {
+      reach[n] = Closure(nodes, {nodes[n].m_Out}, false, false);
+      match[n] = Contains(nodes, reach[n], NODE_MATCH);
+      match_end[n] = Contains(nodes, 
+        Closure(nodes, {nodes[n].m_Out}, false, true), NODE_MATCH);
+      std::sort(reach[n].begin(), reach[n].end());
+    }
+  }
+
+  auto start_mid(Closure(nodes, {start}, false, false));
+  auto start_begin(Closure(nodes, {start}, true, false));
+  std::sort(start_mid.begin(), start_mid.end());
+  std::sort(start_begin.begin(), start_begin.end());
+
+  index.clear();
+  states.clear();
+
+  const auto add_reverse = [&](const std::vector<int>& key) {
+    if (const auto it = index.find(key); it != index.end()) return it->second;
+    if (states.size() >= max_states) Error(std::regex_constants::error_complexity);
+    index[key] = states.size();
+    states.push_back(key);
+    todo.push(states.size() - 1);
+    return (int)states.size() - 1;};
+
+  const auto intersects = [](const std::vector<int>& a, const std::vector<int>& b) {
+    for (auto i = a.begin(), j = b.begin(); i != a.end() && j != b.end(); )
+    {
+      if (*i == *j) return true;
+      *i < *j ? ++i: ++j;
+    }
+    return false;};
+
+  m_ReverseEnd = add_reverse({-1});
+  m_ReverseMid = add_reverse({-2});
+  m_ReverseDead = add_reverse({});
+
+  while (!todo.empty())
+  {
+    const int state = todo.front();
+    todo.pop();
+
+    const std::vector<int> key(states[state]);
+
+    m_ReverseAccept.resize(states.size());
+    m_ReverseAcceptBegin.resize(states.size());
+
+    // The start of the regex is not at an end, as empty matches
+    // are not handled.
+    if (!key.empty() && key[0] >= 0)
+    {
+      m_ReverseAccept[state] = intersects(start_mid, key);
+      m_ReverseAcceptBegin[state] = intersects(start_begin, key);
+    }
+
+    for (size_t c = 0; c < m_NoClasses; c++)
+    {
+      std::vector<int> next;
+
+      for (size_t n = 0; n < nodes.size(); n++)
+      {
+        if (nodes[n].m_Type == NODE_CHAR && nodes[n].m_Set[representative[c]] &&
+          (key == std::vector<int>{-1} ? match_end[n]:
+           key == std::vector<int>{-2} ? match[n]: 
+           intersects(reach[n], key)))
+        {
+          next.push_back(n);
+        }
+      }
+
+      const int to = add_reverse(next);
+      m_ReverseNext.resize(states.size() * m_NoClasses);
+      m_ReverseNext[state * m_NoClasses + c] = to;
+    }
+  }
+
+  m_ReverseAccept.resize(states.size());
+  m_ReverseAcceptBegin.resize(states.size());
+}
+
+std::pair<size_t, size_t> wxExRegExDFA::Find(
+  const std::string_view& text, size_t pos) const
+{
+  if (pos > text.size()) return {std::string::npos, 0};
+
+  // Find the end of the leftmost-first match in one pass, 
+  // the automaton is dead as soon as no thread can do better.
+  int s = (pos == 0 ? m_SearchBegin: m_Search);
+  size_t end = std::string::npos, i = pos;
+
+  for (; i < text.size() && s != m_Dead; i++)
+  {
+    s = m_Next[s * m_NoClasses + m_Classes[(unsigned char)text[i]]];
+    if (m_Accept[s]) end = i + 1;
+  }
+
+  if (i == text.size() && m_AcceptEnd[s])
+  {
+    end = text.size();
+  }
+
+  if (end == std::string::npos) return {std::string::npos, 0};
+
+  // Find the start, going back from the end, the leftmost 
+  // start that can match until the end is the start of the match.
+  s = (end == text.size() ? m_ReverseEnd: m_ReverseMid);
+  size_t start = end;
+
+  for (i = end; i > pos; i--)
+  {
+    s = m_ReverseNext[s * m_NoClasses + m_Classes[(unsigned char)text[i - 1]]];
+    if (s == m_ReverseDead) break;
+    if ((i - 1 == 0 ? m_ReverseAcceptBegin: m_ReverseAccept)[s]) start = i - 1;
+  }
+
+  return {start, end - start};
+}
+
+int wxExRegExDFA::Matches(const std::string_view& text) const
+{
+  const auto pos = Find(text).first;
+  return pos == std::string::npos ? -1: pos;
+}
+
+int wxExRegExDFA::ReplaceAll(std::string& text, const std::string& replace) const
+{
+  for (size_t i = 0; i + 1 < replace.size(); i++)
+  {
+    if (replace[i] == '$' && isdigit(replace[i + 1]))
+    {
+      // Submatches are not kept by the automaton.
+      std::call_once(m_RegExCreated, [this] {
+        m_RegEx = wxExRegExEngine::Create(
+          m_Pattern, m_MatchCase, wxExRegExEngine::REGEX_STD);});
+
+      return m_RegEx->ReplaceAll(text, replace);
+    }
+  }
+
+  std::string output;
+  size_t prev = 0;
+  int count = 0;
+
+  for (;;)
+  {
+    const auto [start, length] = Find(text, prev);
+
+    if (start == std::string::npos) break;
+
+    output.append(text, prev, start - prev);
+
+    for (size_t i = 0; i < replace.size(); i++)
+    {
+      if (replace[i] != '$' || i + 1 == replace.size())
+      {
+        output += replace[i];
+        continue;
+      }
+
+      switch (replace[++i])
+      {
+        case '$': output += '$'; break;
+        case '&': output.append(text, start, length); break;
+        case '`': output.append(text, 0, start); break;
+        case '\'': output.append(text, start + length, std::string::npos); break;
+        default: output += '$'; output += replace[i];
+      }
+    }
+
+    count++;
+    prev = start + length;
+  }
+
+  if (count > 0)
+  {
+    output.append(text, prev, std::string::npos);
+    text.swap(output);
+  }
+
+  return count;
+}
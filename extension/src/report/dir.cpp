@@ -5,26 +5,150 @@
 // Copyright: (c) 2017 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
 #endif
 #include <wx/config.h>
+#include <wx/thread.h>
 #include <wx/extension/listitem.h>
 #include <wx/extension/report/dir.h>
 #include <wx/extension/report/stream.h>
 
+/// Bounded queue of streams, filled by the directory enumeration,
+/// and emptied by the workers.
+class wxExDirToolQueue
+{
+public:
+  wxExDirToolQueue(size_t max) : m_Max(max) {;};
+
+  /// Closes the queue, Pop returns false as soon as it is empty.
+  void Close() {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Closed = true;
+    m_NotEmpty.notify_all();};
+
+  /// Pops a stream, waits while the queue is empty and not closed.
+  bool Pop(std::unique_ptr<wxExStreamToListView>& stream) {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_NotEmpty.wait(lock, [&] {return !m_Queue.empty() || m_Closed;});
+    if (m_Queue.empty()) return false;
+    stream = std::move(m_Queue.front());
+    m_Queue.pop_front();
+    m_NotFull.notify_one();
+    return true;};
+
+  /// Pushes a stream, waits while the queue is full.
+  void Push(std::unique_ptr<wxExStreamToListView> stream) {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_NotFull.wait(lock, [&] {return m_Queue.size() < m_Max;});
+    m_Queue.emplace_back(std::move(stream));
+    m_NotEmpty.notify_one();};
+private:
+  const size_t m_Max;
+  bool m_Closed {false};
+  std::deque<std::unique_ptr<wxExStreamToListView>> m_Queue;
+  std::mutex m_Mutex;
+  std::condition_variable m_NotEmpty, m_NotFull;
+};
+
+namespace
+{
+  int Workers(const wxExTool& tool)
+  {
+    // Keyword reporting activates a listview, and replace with a maximum
+    // might ask to continue, these run on the calling thread.
+    if (!tool.IsFindType() || 
+      (tool.GetId() == ID_TOOL_REPLACE &&
+       wxConfigBase::Get()->ReadLong(_("Max replacements"), -1) != -1))
+    {
+      return 0;
+    }
+
+    const int threads = std::thread::hardware_concurrency();
+
+    return threads > 1 ? threads: 0;
+  }
+}
+
 wxExDirTool::wxExDirTool(const wxExTool& tool,
   const wxExPath& fullpath, const std::string& filespec, int flags)
   : wxExDir(fullpath, filespec, flags)
   , m_Statistics()
   , m_Tool(tool)
+  , m_Threads(Workers(tool))
 {
 }
 
+// The queue is only complete here.
+wxExDirTool::~wxExDirTool() = default;
+
+void wxExDirTool::FindFilesBegin()
+{
+  if (m_Threads == 0) return;
+
+  m_Queue = std::make_unique<wxExDirToolQueue>(m_Threads * 16);
+  m_WorkerStatistics.resize(m_Threads);
+
+  for (int i = 0; i < m_Threads; i++)
+  {
+    m_Workers.emplace_back([=] {RunWorker(m_WorkerStatistics[i]);});
+  }
+}
+
+void wxExDirTool::Drain(bool all)
+{
+  // The sink is drained by its own timer if FindFiles 
+  // is not invoked from the main thread.
+  if (auto* sink = wxExStreamToListView::GetSink(); 
+    sink != nullptr && wxIsMainThread())
+  {
+    sink->Drain(all);
+  }
+}
+
+void wxExDirTool::FindFilesEnd()
+{
+  if (m_Queue != nullptr)
+  {
+    m_Queue->Close();
+
+    for (auto& it : m_Workers)
+    {
+      it.join();
+    }
+
+    for (const auto& it : m_WorkerStatistics)
+    {
+      m_Statistics += it;
+    }
+
+    m_Workers.clear();
+    m_WorkerStatistics.clear();
+    m_Queue.reset();
+  }
+
+  Drain(true);
+}
+
 bool wxExDirTool::OnFile(const wxExPath& file)
 {
+  if (m_Queue != nullptr)
+  {
+    auto stream = std::make_unique<wxExStreamToListView>(file, m_Tool);
+    stream->DeferMatches();
+    m_Queue->Push(std::move(stream));
+
+    Drain();
+
+    return !Cancelled();
+  }
+
   wxExStreamToListView report(file, m_Tool);
+  report.DeferMatches();
 
   bool ret = report.RunTool();
   m_Statistics += report.GetStatistics();
@@ -35,9 +159,28 @@ bool wxExDirTool::OnFile(const wxExPath& file)
     return false;
   }
 
+  Drain();
+
   return true;
 }
 
+void wxExDirTool::RunWorker(wxExStreamStatistics& stats)
+{
+  // Keep popping after a cancel, so the enumeration is never blocked.
+  for (std::unique_ptr<wxExStreamToListView> stream; m_Queue->Pop(stream); )
+  {
+    if (Cancelled()) continue;
+
+    const bool ret = stream->RunTool();
+    stats += stream->GetStatistics();
+
+    if (!ret)
+    {
+      Cancel();
+    }
+  }
+}
+
 wxExDirWithListView::wxExDirWithListView(wxExListView* listview,
   const wxExPath& fullpath, const std::string& filespec, int flags)
   : wxExDir(fullpath, filespec, flags)
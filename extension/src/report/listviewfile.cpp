@@ -12,6 +12,7 @@
 #endif
 #include <pugixml.hpp>
 #include <wx/config.h>
+#include <wx/extension/ctags-indexer.h>
 #include <wx/extension/frame.h>
 #include <wx/extension/itemdlg.h>
 #include <wx/extension/listitem.h>
@@ -173,10 +174,12 @@ bool wxExListViewFile::DoFileLoad(bool synced)
     if (const std::string value = child.text().get(); strcmp(child.name(), "file") == 0)
     {
       wxExListItem(this, value).Insert();
+      wxExCTagsIndexer::Get()->Add(value);
     }
     else if (strcmp(child.name(), "folder") == 0)
     {
       wxExListItem(this, value, child.attribute("extensions").value()).Insert();
+      wxExCTagsIndexer::Get()->Add(value, child.attribute("extensions").value());
     }
 
     if (wxExInterruptable::Cancelled()) break;
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      sink.cpp
+// Purpose:   Implementation of class 'wxExResultSink'
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+#include <wx/extension/frame.h>
+#include <wx/extension/listitem.h>
+#include <wx/extension/listview.h>
+#include <wx/extension/report/sink.h>
+
+namespace
+{
+  const auto batch_interval = std::chrono::milliseconds(100);
+
+  // Appends a copy of a native item, including text colour and data.
+  long CopyItem(wxExListView* lv, long item_number)
+  {
+    wxListView* native = lv;
+
+    wxListItem info;
+    info.SetId(item_number);
+    info.SetMask(wxLIST_MASK_TEXT | wxLIST_MASK_IMAGE);
+    native->GetItem(info);
+    info.SetId(lv->GetItemCount());
+
+    const auto row = native->InsertItem(info);
+
+    native->SetItemTextColour(row, native->GetItemTextColour(item_number));
+    lv->SetItemReadOnly(row, lv->IsItemReadOnly(item_number));
+
+    for (int col = 1; col < lv->GetColumnCount(); col++)
+    {
+      lv->SetItem(row, col, native->GetItemText(item_number, col).ToStdString());
+    }
+
+    return row;
+  }
+}
+
+wxExResultSink::wxExResultSink(wxExListView* listview)
+  : m_ListView(listview)
+  , m_Timer(std::make_unique<wxTimer>(this))
+{
+  Bind(wxEVT_TIMER, [=](wxTimerEvent& event) {
+    Drain();
+    if (!IsEmpty())
+    {
+      m_Timer->StartOnce(batch_interval.count());
+    }});
+}
+
+wxExResultSink::~wxExResultSink()
+{
+  for (auto* node = m_Head.exchange(nullptr); node != nullptr; )
+  {
+    auto* next = node->m_Next;
+    delete node;
+    node = next;
+  }
+}
+
+size_t wxExResultSink::Drain(bool all)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  if (!all && start - m_LastBatch < batch_interval)
+  {
+    return 0;
+  }
+
+  // Take all pushed nodes, the most recent one is on top,
+  // so reverse them to report in push order.
+  std::vector<wxExResultNode*> pushed;
+
+  for (auto* node = m_Head.exchange(nullptr, std::memory_order_acquire);
+    node != nullptr; node = node->m_Next)
+  {
+    pushed.emplace_back(node);
+  }
+
+  for (auto it = pushed.rbegin(); it != pushed.rend(); ++it)
+  {
+    m_Pending.emplace_back(*it);
+  }
+
+  if (m_Pending.empty())
+  {
+    return 0;
+  }
+
+  size_t reported = 0;
+
+  m_ListView->Freeze();
+
+  while (!m_Pending.empty() &&
+    (all || std::chrono::steady_clock::now() - start < batch_interval))
+  {
+    reported += Report(*m_Pending.front());
+    m_Pending.pop_front();
+  }
+
+  if (auto* store = m_ListView->GetStore(); store != nullptr)
+  {
+    m_ListView->SetItemCount(store->GetRows());
+    m_ListView->Refresh();
+  }
+
+  m_ListView->Thaw();
+
+  wxExFrame::UpdateStatusBar(m_ListView);
+
+  m_LastBatch = std::chrono::steady_clock::now();
+
+  return reported;
+}
+
+void wxExResultSink::Push(
+  const wxExPath& path, const std::string& match, wxExResultLines&& lines)
+{
+  auto* node = new wxExResultNode{path, match, std::move(lines), nullptr};
+
+  node->m_Next = m_Head.load(std::memory_order_relaxed);
+
+  while (!m_Head.compare_exchange_weak(node->m_Next, node,
+    std::memory_order_release, std::memory_order_relaxed))
+  {
+  }
+
+  // The timer can only be used from the main thread.
+  if (node->m_Next == nullptr)
+  {
+    CallAfter([=] {
+      if (!m_Timer->IsRunning())
+      {
+        m_Timer->StartOnce(batch_interval.count());
+      }});
+  }
+}
+
+size_t wxExResultSink::Report(const wxExResultNode& node)
+{
+  if (node.m_Lines.empty()) return 0;
+
+  // All matches are from the same file, so the file columns
+  // are set once, and the item is copied for the other matches.
+  wxExListItem item(m_ListView, node.m_Path);
+  item.Insert(-1, false);
+
+  auto* store = m_ListView->GetStore();
+
+  const int col_line_no = m_ListView->FindColumn(_("Line No").ToStdString());
+  const int col_line = m_ListView->FindColumn(_("Line").ToStdString());
+  const int col_match = m_ListView->FindColumn(_("Match").ToStdString());
+
+  const auto set = [&](long row, int col, const std::string& text) {
+    if (col == -1) return;
+    if (store != nullptr) store->Set(row, col, text);
+    else m_ListView->SetItem(row, col, text);};
+
+  for (size_t i = 0; i < node.m_Lines.size(); i++)
+  {
+    const auto row = (i == 0 ? item.GetId():
+      store != nullptr ? store->CopyRow(item.GetId()): CopyItem(m_ListView, item.GetId()));
+
+    set(row, col_line_no, std::to_string(node.m_Lines[i].first + 1));
+    set(row, col_line, node.m_Lines[i].second);
+    set(row, col_match, node.m_Match);
+  }
+
+  return node.m_Lines.size();
+}
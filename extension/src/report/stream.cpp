@@ -21,11 +21,13 @@
 
 wxExListView* wxExStreamToListView::m_Report = nullptr;
 wxExFrameWithHistory* wxExStreamToListView::m_Frame = nullptr;
+wxExResultSink* wxExStreamToListView::m_Sink = nullptr;
 
 wxExStreamToListView::wxExStreamToListView(
   const wxExPath& filename,
   const wxExTool& tool)
   : wxExStream(filename, tool)
+  , m_ContextSize(wxConfigBase::Get()->ReadLong(_("Context size"), 10))
 {
 }
 
@@ -242,10 +244,10 @@ bool wxExStreamToListView::Process(std::string& line, size_t line_no)
 
 bool wxExStreamToListView::ProcessBegin()
 {
-  m_ContextSize = wxConfigBase::Get()->ReadLong(_("Context size"), 10);
-
   if (GetTool().GetId() != ID_TOOL_REPORT_KEYWORD)
   {
+    // Retrieve the stat once, each list item copies it.
+    GetFileName().GetStat();
     return wxExStream::ProcessBegin();
   }
   else
@@ -265,7 +267,23 @@ bool wxExStreamToListView::ProcessBegin()
 
 void wxExStreamToListView::ProcessEnd()
 {
-  if (GetTool().GetId() == ID_TOOL_REPORT_KEYWORD)
+  if (GetTool().GetId() == ID_TOOL_REPORT_FIND)
+  {
+    if (!m_Matches.empty())
+    {
+      m_Sink->Push(
+        GetFileName(), 
+        wxExFindReplaceData::Get()->GetFindString(), 
+        std::move(m_Matches));
+      m_Matches.clear();
+    }
+
+    if (!m_DeferMatches)
+    {
+      m_Sink->Drain(true);
+    }
+  }
+  else if (GetTool().GetId() == ID_TOOL_REPORT_KEYWORD)
   {
     if (!GetFileName().GetLexer().GetKeywordsString().empty())
     {
@@ -305,14 +323,9 @@ void wxExStreamToListView::ProcessEnd()
 void wxExStreamToListView::ProcessMatch(
   const std::string& line, size_t line_no, int pos)
 {
-  wxASSERT(m_Report != nullptr);
-
-  wxExListItem item(m_Report, GetFileName());
-  item.Insert();
+  wxASSERT(m_Sink != nullptr);
 
-  item.SetItem(_("Line No").ToStdString(), std::to_string(line_no + 1));
-  item.SetItem(_("Line").ToStdString(), Context(line, pos));
-  item.SetItem(_("Match").ToStdString(), wxExFindReplaceData::Get()->GetFindString());
+  m_Matches.emplace_back(line_no, Context(line, pos));
 }
 
 bool wxExStreamToListView::SetupTool(
@@ -340,5 +353,36 @@ bool wxExStreamToListView::SetupTool(
     m_Report = report;
   }
 
+  if (m_Report != nullptr && 
+     (m_Sink == nullptr || m_Sink->GetListView() != m_Report))
+  {
+    if (m_Sink != nullptr)
+    {
+      m_Sink->Drain(true);
+      delete m_Sink;
+    }
+
+    m_Sink = new wxExResultSink(m_Report);
+
+    // The sink (and its timer) should not outlive its listview, 
+    // when the listview is destroyed (e.g. its page is closed, 
+    // or at exit) results not yet reported are deleted with the sink.
+    m_Report->Bind(wxEVT_DESTROY, [listview = m_Report](wxWindowDestroyEvent& event) {
+      if (event.GetEventObject() == listview)
+      {
+        if (m_Sink != nullptr && m_Sink->GetListView() == listview)
+        {
+          delete m_Sink;
+          m_Sink = nullptr;
+        }
+
+        if (m_Report == listview)
+        {
+          m_Report = nullptr;
+        }
+      }
+      event.Skip();});
+  }
+
   return true;
 }
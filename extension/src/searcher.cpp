@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      searcher.cpp
+// Purpose:   Implementation of wxExSearcher class
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <wx/extension/searcher.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EX_SEARCHER_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EX_SEARCHER_AVX2
+#include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+  char ToLower(char c) {return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A'): c;}
+  char ToUpper(char c) {return (c >= 'a' && c <= 'z') ? c - ('a' - 'A'): c;}
+
+  int TrailingZeros(unsigned int mask)
+  {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+  }
+}
+
+wxExSearcher::wxExSearcher(
+  const std::string& find, bool match_case, wxExSearcherKernel kernel)
+  : m_Find(find)
+  , m_FindUpper(find)
+  , m_MatchCase(match_case)
+  , m_Kernel(kernel)
+{
+  for (auto& c : m_FindUpper) c = ToUpper(c);
+
+  if (m_Kernel == KERNEL_DEFAULT)
+  {
+    m_Kernel = 
+      IsSupported(KERNEL_AVX2) ? KERNEL_AVX2: 
+      IsSupported(KERNEL_SSE2) ? KERNEL_SSE2: KERNEL_SCALAR;
+  }
+  else if (!IsSupported(m_Kernel))
+  {
+    m_Kernel = KERNEL_SCALAR;
+  }
+
+  const char first = (m_Find.empty() ? 0: m_Find.front());
+  const char last = (m_Find.empty() ? 0: m_Find.back());
+
+  m_First[0] = m_MatchCase ? first: ToLower(first);
+  m_First[1] = m_MatchCase ? first: ToUpper(first);
+  m_Last[0] = m_MatchCase ? last: ToLower(last);
+  m_Last[1] = m_MatchCase ? last: ToUpper(last);
+}
+
+bool wxExSearcher::Equal(const char* text) const
+{
+  if (m_MatchCase)
+  {
+    return memcmp(text, m_Find.data(), m_Find.size()) == 0;
+  }
+
+  for (size_t i = 0; i < m_FindUpper.size(); i++)
+  {
+    if (ToUpper(text[i]) != m_FindUpper[i]) return false;
+  }
+
+  return true;
+}
+
+size_t wxExSearcher::Find(const std::string_view& text, size_t pos) const
+{
+  if (m_Find.empty() || pos > text.size() || text.size() - pos < m_Find.size())
+  {
+    return std::string::npos;
+  }
+
+  size_t found = std::string::npos;
+
+  switch (m_Kernel)
+  {
+    case KERNEL_AVX2: found = FindAVX2(text.data() + pos, text.size() - pos); break;
+    case KERNEL_SSE2: found = FindSSE2(text.data() + pos, text.size() - pos); break;
+    default: found = FindScalar(text.data() + pos, text.size() - pos);
+  }
+
+  return found != std::string::npos ? found + pos: found;
+}
+
+#ifdef EX_SEARCHER_AVX2
+__attribute__((target("avx2")))
+#endif
+size_t wxExSearcher::FindAVX2(const char* text, size_t size) const
+{
+  size_t i = 0;
+
+#ifdef EX_SEARCHER_AVX2
+  const size_t last = m_Find.size() - 1;
+  const __m256i f0 = _mm256_set1_epi8(m_First[0]), f1 = _mm256_set1_epi8(m_First[1]);
+  const __m256i l0 = _mm256_set1_epi8(m_Last[0]), l1 = _mm256_set1_epi8(m_Last[1]);
+
+  for (; i + last + 32 <= size; i += 32)
+  {
+    const __m256i bf = _mm256_loadu_si256((const __m256i*)(text + i));
+    const __m256i bl = _mm256_loadu_si256((const __m256i*)(text + i + last));
+    const __m256i eq = _mm256_and_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(bf, f0), _mm256_cmpeq_epi8(bf, f1)),
+      _mm256_or_si256(_mm256_cmpeq_epi8(bl, l0), _mm256_cmpeq_epi8(bl, l1)));
+
+    for (unsigned int mask = _mm256_movemask_epi8(eq); mask != 0; mask &= mask - 1)
+    {
+      if (const size_t pos = i + TrailingZeros(mask); Equal(text + pos)) return pos;
+    }
+  }
+#endif
+
+  const auto found = FindScalar(text + i, size - i);
+  return found != std::string::npos ? found + i: found;
+}
+
+size_t wxExSearcher::FindScalar(const char* text, size_t size) const
+{
+  if (size < m_Find.size()) return std::string::npos;
+
+  if (m_MatchCase)
+  {
+    return std::string_view(text, size).find(m_Find);
+  }
+
+  for (size_t i = 0; i <= size - m_Find.size(); i++)
+  {
+    if ((text[i] == m_First[0] || text[i] == m_First[1]) && Equal(text + i))
+    {
+      return i;
+    }
+  }
+
+  return std::string::npos;
+}
+
+size_t wxExSearcher::FindSSE2(const char* text, size_t size) const
+{
+  size_t i = 0;
+
+#ifdef EX_SEARCHER_SSE2
+  const size_t last = m_Find.size() - 1;
+  const __m128i f0 = _mm_set1_epi8(m_First[0]), f1 = _mm_set1_epi8(m_First[1]);
+  const __m128i l0 = _mm_set1_epi8(m_Last[0]), l1 = _mm_set1_epi8(m_Last[1]);
+
+  for (; i + last + 16 <= size; i += 16)
+  {
+    const __m128i bf = _mm_loadu_si128((const __m128i*)(text + i));
+    const __m128i bl = _mm_loadu_si128((const __m128i*)(text + i + last));
+    const __m128i eq = _mm_and_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(bf, f0), _mm_cmpeq_epi8(bf, f1)),
+      _mm_or_si128(_mm_cmpeq_epi8(bl, l0), _mm_cmpeq_epi8(bl, l1)));
+
+    for (unsigned int mask = _mm_movemask_epi8(eq); mask != 0; mask &= mask - 1)
+    {
+      if (const size_t pos = i + TrailingZeros(mask); Equal(text + pos)) return pos;
+    }
+  }
+#endif
+
+  const auto found = FindScalar(text + i, size - i);
+  return found != std::string::npos ? found + i: found;
+}
+
+bool wxExSearcher::IsSupported(wxExSearcherKernel kernel)
+{
+  switch (kernel)
+  {
+#ifdef EX_SEARCHER_AVX2
+    case KERNEL_AVX2: return __builtin_cpu_supports("avx2");
+#endif
+#ifdef EX_SEARCHER_SSE2
+    case KERNEL_SSE2: return true;
+#endif
+    case KERNEL_DEFAULT:
+    case KERNEL_SCALAR: return true;
+    default: return false;
+  }
+}
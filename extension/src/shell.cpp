@@ -9,6 +9,7 @@
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
 #endif
+#include <algorithm>
 #include <functional>
 #include <numeric>
 #include <wx/config.h>
@@ -30,6 +31,7 @@ wxExShell::wxExShell(
   , m_Echo(echo)
   , m_CommandsSaveInConfig(commands_save_in_config)
   , m_Prompt(prompt)
+  , m_MaxLines(wxConfigBase::Get()->ReadLong(_("Shell lines"), 0))
 {
   // Override defaults from config.
   SetEdgeMode(wxSTC_EDGE_NONE);
@@ -273,8 +275,23 @@ wxExShell::~wxExShell()
   }
 }
 
+void wxExShell::AppendOutput(const std::string& text)
+{
+  if (text.empty()) return;
+
+  if (m_Output.empty())
+  {
+    CallAfter(&wxExShell::Flush);
+  }
+
+  m_Output += text;
+}
+
 void wxExShell::AppendText(const wxString& text)
 {
+  // Output collected is appended first.
+  Flush();
+
   const bool pos_at_end = (GetCurrentPos() >= GetTextLength());
 
   wxExSTC::AppendText(text);
@@ -374,6 +391,74 @@ const std::string wxExShell::GetHistory() const
   return std::accumulate(m_Commands.begin(), m_Commands.end(), std::string());
 }
 
+void wxExShell::Flush()
+{
+  if (m_Output.empty()) return;
+
+  std::string text;
+  text.swap(m_Output);
+
+  const long long lines = std::count(text.begin(), text.end(), '\n');
+
+  m_Statistics.Inc(_("Bytes appended").ToStdString(), text.size());
+  m_Statistics.Inc(_("Lines appended").ToStdString(), lines);
+
+  const bool pos_at_end = (GetCurrentPos() >= GetTextLength());
+
+  // Appending output is no edit.
+  UseModificationMarkers(false);
+  SetUndoCollection(false);
+
+  // A line is counted if it ends with an eol, so the last line 
+  // (e.g. an empty line after the output) is not counted.
+  if (m_MaxLines > 0 && lines > m_MaxLines)
+  {
+    // All lines present, and the first lines of the output would be
+    // removed at once, so these are never appended, nor styled.
+    // Find the eol of the last line removed.
+    auto pos = text.size();
+
+    for (int i = 0; i <= m_MaxLines; i++)
+    {
+      pos = text.rfind('\n', pos - 1);
+    }
+
+    m_Statistics.Inc(_("Bytes dropped").ToStdString(), GetTextLength() + pos + 1);
+    m_Statistics.Inc(_("Lines dropped").ToStdString(), 
+      GetLineCount() - 1 + lines - m_MaxLines);
+
+    ClearAll();
+    text.erase(0, pos + 1);
+  }
+
+  wxExSTC::AppendText(text);
+
+  if (const auto excess = GetLineCount() - 1 - m_MaxLines; 
+    m_MaxLines > 0 && excess > 0)
+  {
+    // Remove the oldest lines in one range.
+    const auto end = PositionFromLine(excess);
+
+    m_Statistics.Inc(_("Bytes dropped").ToStdString(), end);
+    m_Statistics.Inc(_("Lines dropped").ToStdString(), excess);
+
+    DeleteRange(0, end);
+  }
+
+  SetUndoCollection(true);
+  UseModificationMarkers(true);
+
+  m_CommandStartPosition = GetTextLength();
+
+  EmptyUndoBuffer();
+
+  if (pos_at_end)
+  {
+    DocumentEnd();
+    EnsureCaretVisible();
+  }
+}
+
 void wxExShell::KeepCommand()
 {
   // Prevent large commands, in case command end is not eol.
@@ -30,18 +30,35 @@ const std::string wxExStat::GetModificationTime() const
 //#endif
 }
 
+bool wxExStat::IsDirectory() const
+{
+  return m_IsOk && (st_mode & S_IFMT) == S_IFDIR;
+}
+
 bool wxExStat::IsReadOnly() const 
 {
+  if (!m_IsReadOnly)
+  {
 #ifdef _MSC_VER
-  return (m_IsOk && ((st_mode & wxS_IWUSR) == 0));
-//  return (m_IsOk && _access(m_FullPath.c_str(), 4) == -1);
+    m_IsReadOnly = (m_IsOk && ((st_mode & wxS_IWUSR) == 0));
+//  m_IsReadOnly = (m_IsOk && _access(m_FullPath.c_str(), 4) == -1);
 #else
-  return (m_IsOk && access(m_FullPath.c_str(), W_OK) == -1);
+    m_IsReadOnly = (m_IsOk && access(m_FullPath.c_str(), W_OK) == -1);
 #endif
+  }
+
+  return *m_IsReadOnly;
+}
+
+bool wxExStat::IsRegularFile() const
+{
+  return m_IsOk && (st_mode & S_IFMT) == S_IFREG;
 }
 
 bool wxExStat::Sync() 
 {
+  m_IsReadOnly.reset();
+
   if (m_FullPath.empty())
   {
     m_IsOk = false;
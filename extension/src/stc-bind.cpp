@@ -324,6 +324,10 @@ void wxExSTC::BindAll()
 
   Bind(wxEVT_STC_UPDATEUI, [=](wxStyledTextEvent& event) {
     event.Skip();
+    if (HexMode())
+    {
+      m_HexMode.RenderLines(GetFirstVisibleLine() + 2 * LinesOnScreen());
+    }
     wxExFrame::UpdateStatusBar(this, "PaneInfo");});
     
   Bind(wxEVT_MENU, [=](wxCommandEvent& event) {Copy();}, wxID_COPY);
@@ -41,6 +41,7 @@ public:
     {_("Print flags"), ITEM_TEXTCTRL_INT, (long)wxSTC_PRINT_BLACKONWHITE},
     {_("Scroll bars"), ITEM_CHECKBOX, true},
     {_("Search engine"), ITEM_COMBOBOX, std::string("https://duckduckgo.com")},
+    {_("Shell lines"), ITEM_TEXTCTRL_INT, 0l},
     {_("Show mode"), ITEM_CHECKBOX, true},
 #if wxCHECK_VERSION(3,1,1)
     {_("Tab draw mode"), ITEM_TEXTCTRL_INT, (long)wxSTC_TD_LONGARROW},
@@ -49,7 +50,8 @@ public:
     {_("Tab width"), ITEM_TEXTCTRL_INT, 2l},
     {_("Text font"), ITEM_FONTPICKERCTRL, wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT)},
     {_("vi mode"), ITEM_CHECKBOX, true},
-    {_("vi tag fullpath"), ITEM_CHECKBOX, true}}) {;};
+    {_("vi tag fullpath"), ITEM_CHECKBOX, true},
+    {_("vi tag fuzzy"), ITEM_CHECKBOX, false}}) {;};
 };
   
 bool wxExSTC::AutoIndentation(int c)
@@ -135,8 +137,10 @@ int wxExSTC::ConfigDialog(const wxExWindowData& par)
                _("Scroll bars"),
                _("Autocomplete"),
                _("vi mode"),
-               _("vi tag fullpath")}},
-            {_("Search engine"), ITEM_COMBOBOX}}},
+               _("vi tag fullpath"),
+               _("vi tag fuzzy")}},
+            {_("Search engine"), ITEM_COMBOBOX},
+            {_("Shell lines"), 0l, INT_MAX}}},
           {_("Page2"), 
             {{_("Auto indent"), {
                {INDENT_NONE, _("None")},
@@ -139,6 +139,13 @@ bool wxExSTC::FindNext(
 
   if (SearchInTarget(text) == -1)
   {
+    // In hex mode the text might be in lines not yet rendered,
+    // if searching forward, or backward from the end.
+    if (find_next != recursive && m_HexMode.RenderFind(text, find_next))
+    {
+      return FindNext(text, find_flags, find_next);
+    }
+
     wxExFrame::StatusText(
       wxExGetFindResult(text, find_next, recursive), std::string());
     
@@ -308,12 +308,12 @@ const std::string wxExSTC::GetWordAtPos(int pos) const
 void wxExSTC::GuessType()
 {
   // Get a small sample from this document to detect the file mode.
-  const auto length = (!HexMode() ? GetTextLength(): m_HexMode.GetBuffer().size());
+  const auto length = (!HexMode() ? GetTextLength(): m_HexMode.GetHexBuffer().GetSize());
   const auto sample_size = (length > 255 ? 255: length);
   const std::string text((!HexMode() ? GetTextRange(0, sample_size).ToStdString(): 
-    m_HexMode.GetBuffer().substr(0, sample_size)));
+    m_HexMode.GetHexBuffer().Get(0, sample_size)));
   const std::string text2((!HexMode() ? GetTextRange(length - sample_size, length).ToStdString(): 
-    m_HexMode.GetBuffer().substr(length - sample_size, sample_size)));
+    m_HexMode.GetHexBuffer().Get(length - sample_size, sample_size)));
 
   std::vector<std::string> v;  
   
@@ -397,6 +397,18 @@ bool wxExSTC::LinkOpen(int mode, std::string* filename)
   return false;
 }
 
+bool wxExSTC::MarkerAddChange(int line)
+{
+  if (!wxExLexers::Get()->MarkerIsLoaded(m_MarkerChange))
+  {
+    return false;
+  }
+  
+  MarkerAdd(line, m_MarkerChange.GetNo());
+  
+  return true;
+}
+
 bool wxExSTC::MarkerDeleteAllChange()
 {
   if (!wxExLexers::Get()->MarkerIsLoaded(m_MarkerChange))
@@ -599,16 +611,30 @@ void wxExSTC::PropertiesMessage(long flags)
   }
 }
 
+void wxExSTC::Redo()
+{
+  if (HexMode())
+  {
+    m_HexMode.Redo();
+  }
+  else
+  {
+    wxStyledTextCtrl::Redo();
+  }
+}
+
 int wxExSTC::ReplaceAll(
   const std::string& find_text,
   const std::string& replace_text)
 {
   int selection_from_end = 0;
+  bool selection = false;
 
   if (SelectionIsRectangle() || wxExGetNumberOfLines(GetSelectedText().ToStdString()) > 1)
   {
     TargetFromSelection();
     selection_from_end = GetLength() - GetTargetEnd();
+    selection = true;
   }
   else
   {
@@ -620,8 +646,20 @@ int wxExSTC::ReplaceAll(
   SetSearchFlags(-1);
   BeginUndoAction();
 
-  while (SearchInTarget(find_text) != -1)
+  while (true)
   {
+    if (GetTargetStart() >= GetTargetEnd() || SearchInTarget(find_text) == -1)
+    {
+      // In hex mode the text might be in lines not yet rendered.
+      if (selection || !m_HexMode.RenderFind(find_text))
+      {
+        break;
+      }
+
+      SetTargetEnd(GetLength());
+      continue;
+    }
+
     bool skip_replace = false;
 
     // Check that the target is within the rectangular selection.
@@ -660,11 +698,6 @@ int wxExSTC::ReplaceAll(
 
     SetTargetStart(GetTargetEnd());
     SetTargetEnd(GetLength() - selection_from_end);
-    
-    if (GetTargetStart() >= GetTargetEnd())
-    {
-      break;
-    }
   }
 
   EndUndoAction();
@@ -699,7 +732,13 @@ bool wxExSTC::ReplaceNext(
     SetTargetStart(GetCurrentPos());
     SetTargetEnd(GetLength());
     SetSearchFlags(find_flags);
-    if (SearchInTarget(find_text) == -1) return false;
+
+    // In hex mode the text might be in lines not yet rendered.
+    while (SearchInTarget(find_text) == -1)
+    {
+      if (!m_HexMode.RenderFind(find_text)) return false;
+      SetTargetEnd(GetLength());
+    }
   }
 
   if (HexMode())
@@ -871,8 +910,16 @@ void wxExSTC::Sync(bool start)
 
 void wxExSTC::Undo()
 {
-  wxStyledTextCtrl::Undo();
-  m_HexMode.Undo();
+  if (HexMode())
+  {
+    // The hex buffer keeps its own undo journal.
+    m_HexMode.Undo();
+  }
+  else
+  {
+    wxStyledTextCtrl::Undo();
+    m_HexMode.Undo();
+  }
 }
 
 void wxExSTC::UseModificationMarkers(bool use)
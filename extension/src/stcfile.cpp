@@ -11,6 +11,7 @@
 #endif
 #include <pugixml.hpp>
 #include <wx/extension/stcfile.h>
+#include <wx/extension/ctags-indexer.h>
 #include <wx/extension/filedlg.h>
 #include <wx/extension/lexers.h>
 #include <wx/extension/log.h>
@@ -42,6 +43,16 @@ wxExSTCFile::wxExSTCFile(wxExSTC* stc, const std::string& filename)
   }
 }
 
+bool wxExSTCFile::CanSaveInPlace() const
+{
+  // A hex edit that did not insert or delete bytes is written in place,
+  // if the file was not changed by others since it was loaded or saved.
+  return 
+    m_STC->GetHexMode().Active() && 
+   !m_STC->GetHexMode().GetHexBuffer().IsResized() &&
+    IsUnchangedOnDisk();
+}
+
 bool wxExSTCFile::DoFileLoad(bool synced)
 {
   if (
@@ -51,18 +62,12 @@ bool wxExSTCFile::DoFileLoad(bool synced)
     return false;
   }
 
-  // Synchronizing by appending only new data only works for log files.
-  // Other kind of files might get new data anywhere inside the file,
-  // we cannot sync that by keeping pos. 
-  // Also only do it for reasonably large files.
-  const bool isLog = (GetFileName().GetExtension().find(".log") == 0);
-  
   m_STC->UseModificationMarkers(false);
 
-  ReadFromFile(
-    synced &&
-    isLog &&
-    m_STC->GetTextLength() > 1024);
+  // Synchronizing by appending only new data is done for any file
+  // that only grew, otherwise (truncated, rotated, or changed inside)
+  // the file is read again.
+  ReadFromFile(synced && IsAppended());
 
   if (!synced)
   {
@@ -96,7 +101,18 @@ void wxExSTCFile::DoFileSave(bool save_as)
 {
   if (m_STC->GetHexMode().Active())
   {
-    Write(m_STC->GetHexMode().GetBuffer());
+    if (IsSavedInPlace())
+    {
+      // Only the bytes changed are written, the file keeps its size.
+      for (const auto& it : m_STC->GetHexMode().GetHexBuffer().GetChanged())
+      {
+        Write(it.first, m_STC->GetHexMode().GetHexBuffer().Get(it.first, it.second));
+      }
+    }
+    else
+    {
+      Write(m_STC->GetHexMode().GetBuffer());
+    }
   }
   else
   {
@@ -116,6 +132,11 @@ void wxExSTCFile::DoFileSave(bool save_as)
   VLOG(1) << "saved: " << GetFileName().Path().string();
   
   CheckWellFormed(m_STC, GetFileName());
+
+  if (auto* indexer = wxExCTagsIndexer::Get(false); indexer != nullptr)
+  {
+    indexer->Update(GetFileName().Path().string());
+  }
 }
 
 bool wxExSTCFile::GetContentsChanged() const 
@@ -142,9 +163,23 @@ void wxExSTCFile::ReadFromFile(bool get_only_new_data)
     m_STC->ClearDocument();
   }
 
-  m_PreviousLength = Length();
+  const auto buffer = Read(offset);
+
+  m_PreviousLength = offset + buffer->length();
 
-  if (const auto buffer = Read(offset); !m_STC->GetHexMode().Active())
+  if (m_STC->GetHexMode().Active())
+  {
+    if (offset == 0)
+    {
+      m_STC->GetHexMode().SetText(std::string(buffer->data(), buffer->length()));
+      m_STC->GetHexMode().SetSavePoint();
+    }
+    else
+    {
+      m_STC->GetHexMode().AppendText(std::string(buffer->data(), buffer->length()));
+    }
+  }
+  else
   {
     m_STC->Allocate(buffer->length());
     
@@ -152,10 +187,6 @@ void wxExSTCFile::ReadFromFile(bool get_only_new_data)
       m_STC->AppendTextRaw((const char *)buffer->data(), buffer->length()):
       m_STC->AddTextRaw((const char *)buffer->data(), buffer->length());
   }
-  else
-  {
-    m_STC->GetHexMode().AppendText(std::string(buffer->data(), buffer->length()));
-  }
 
   if (get_only_new_data)
   {
@@ -181,4 +212,5 @@ void wxExSTCFile::ReadFromFile(bool get_only_new_data)
 void wxExSTCFile::ResetContentsChanged()
 {
   m_STC->SetSavePoint();
+  m_STC->GetHexMode().SetSavePoint();
 }
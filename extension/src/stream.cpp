@@ -9,17 +9,12 @@
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
 #endif
-#include <algorithm>
-#include <cctype>
-#ifndef __WXMSW__
-#include <experimental/algorithm>
-#include <experimental/functional>
-#endif
+#include <cstring>
 #include <fstream>
-#include <iostream>
 #include <wx/config.h>
 #include <wx/extension/stream.h>
 #include <wx/extension/frd.h>
+#include <wx/extension/mapped-file.h>
 #include <wx/extension/util.h>
 
 bool wxExStream::m_Asked = false;
@@ -32,91 +27,137 @@ wxExStream::wxExStream(const wxExPath& filename, const wxExTool& tool)
 {
 }
 
-bool wxExStream::Process(std::string& line, size_t line_no)
+bool wxExStream::FindInLine(const std::string_view& line, size_t line_no)
 {
-  bool match = false;
-  int count = 1;
   int pos = -1;
 
   if (m_FRD->UseRegEx())
   {
     pos = m_FRD->RegExMatches(line);
-    match = (pos >= 0);
+  }
+  else if (const auto found = m_Searcher.Find(line);
+    found != std::string::npos)
+  {
+    pos = found;
 
-    if (match && m_Tool.GetId() == ID_TOOL_REPLACE)
+    if (const auto next = found + m_Searcher.GetFindString().size(); 
+        m_FRD->MatchWord() && 
+        ((pos > 0 && IsWordCharacter(line[pos - 1])) ||
+         (next < line.size() && IsWordCharacter(line[next]))))
     {
-      count = m_FRD->RegExReplaceAll(line);
-      if (!m_Modified) m_Modified = (count > 0);
+      pos = -1;
     }
   }
-  else
+
+  return pos < 0 || HandleMatch(line, line_no, pos, 1);
+}
+
+bool wxExStream::FindInText(const std::string_view& text)
+{
+  const char* last = text.data() + text.size();
+  size_t line_no = 0;
+
+  for (const char* line = text.data(); line < last; )
   {
-    if (m_Tool.GetId() == ID_TOOL_REPORT_FIND)
+    // Without regex, lines before the first occurrence 
+    // of the find string are skipped.
+    const char* it = line;
+
+    if (!m_FRD->UseRegEx())
     {
-      if (const auto it = (!m_FRD->MatchCase() ?
-        std::search(line.begin(), line.end(), m_FindString.begin(), m_FindString.end(),
-          [](char ch1, char ch2) {return std::toupper(ch1) == ch2;}):
-#ifndef __WXMSW__
-        std::experimental::search(line.begin(), line.end(), 
-          std::experimental::make_boyer_moore_searcher(m_FindString.begin(), m_FindString.end())));
-#else
-        std::search(line.begin(), line.end(), 
-          m_FindString.begin(), m_FindString.end()));
-#endif
-        it != line.end())
+      if (const auto found = m_Searcher.Find(text, line - text.data());
+        found == std::string::npos)
       {
-        match = true;
-        pos = it - line.begin();
-
-        if (m_FRD->MatchWord() && 
-            ((it != line.begin() && IsWordCharacter(*std::prev(it))) ||
-              IsWordCharacter(*std::next(it, m_FindString.length()))))
-        {
-          match = false;
-        }
+        break;
+      }
+      else
+      {
+        it = text.data() + found;
       }
     }
-    else
+
+    for (const char* eol; 
+      (eol = (const char*)memchr(line, '\n', it - line)) != nullptr; line_no++)
+    {
+      line = eol + 1;
+    }
+
+    const char* eol = (const char*)memchr(it, '\n', last - it);
+
+    if (!FindInLine(
+      std::string_view(line, (eol != nullptr ? eol: last) - line), line_no))
     {
-      count = wxExReplaceAll(
-        line, 
-        m_FRD->GetFindString(), 
-        m_FRD->GetReplaceString(),
-        &pos);
-
-      match = (count > 0);
-      if (!m_Modified) m_Modified = match;
+      return false;
     }
+
+    if (eol == nullptr) break;
+
+    line = eol + 1;
+    line_no++;
   }
 
-  if (match)
+  return true;
+}
+
+bool wxExStream::HandleMatch(
+  const std::string_view& line, size_t line_no, int pos, int count)
+{
+  if (m_Tool.GetId() == ID_TOOL_REPORT_FIND)
   {
-    if (m_Tool.GetId() == ID_TOOL_REPORT_FIND)
+    ProcessMatch(std::string(line), line_no, pos);
+  }
+  
+  if (const auto ac = IncActionsCompleted(count);
+    !m_Asked && m_Threshold != -1 && (ac - m_Prev > m_Threshold))
+  {
+    if (wxMessageBox(
+      "More than " + std::to_string(m_Threshold) + " matches in: " + 
+        m_Path.Path().string() + "?",
+      _("Continue"),
+      wxYES_NO | wxICON_QUESTION) == wxNO)
     {
-      ProcessMatch(line, line_no, pos);
+      return false;
     }
-    
-    if (const auto ac = IncActionsCompleted(count);
-      !m_Asked && m_Threshold != -1 && (ac - m_Prev > m_Threshold))
+    else
     {
-      if (wxMessageBox(
-        "More than " + std::to_string(m_Threshold) + " matches in: " + 
-          m_Path.Path().string() + "?",
-        _("Continue"),
-        wxYES_NO | wxICON_QUESTION) == wxNO)
-      {
-        return false;
-      }
-      else
-      {
-        m_Asked = true;
-      }
+      m_Asked = true;
     }
   }
 
   return true;
 }
 
+bool wxExStream::Process(std::string& line, size_t line_no)
+{
+  if (m_Tool.GetId() == ID_TOOL_REPORT_FIND)
+  {
+    return FindInLine(line, line_no);
+  }
+
+  int count = 0;
+  int pos = -1;
+
+  if (m_FRD->UseRegEx())
+  {
+    if ((pos = m_FRD->RegExMatches(line)) >= 0)
+    {
+      count = m_FRD->RegExReplaceAll(line);
+    }
+  }
+  else
+  {
+    count = wxExReplaceAll(
+      line, 
+      m_FRD->GetFindString(), 
+      m_FRD->GetReplaceString(),
+      &pos);
+  }
+
+  if (!m_Modified) m_Modified = (count > 0);
+
+  return pos < 0 || HandleMatch(line, line_no, pos, count);
+}
+
 bool wxExStream::ProcessBegin()
 {
   if (
@@ -127,49 +168,65 @@ bool wxExStream::ProcessBegin()
     return false;
   }
 
-  m_FindString = wxExFindReplaceData::Get()->GetFindString();
+  m_Searcher = wxExSearcher(
+    wxExFindReplaceData::Get()->GetFindString(),
+    wxExFindReplaceData::Get()->MatchCase());
   m_Prev = m_Stats.Get(_("Actions Completed").ToStdString());
   m_Write = (m_Tool.GetId() == ID_TOOL_REPLACE);
 
-  if (!wxExFindReplaceData::Get()->MatchCase())
-  {
-    for (auto & c : m_FindString) c = std::toupper(c);
-  }
-  
   return true;
 }
   
 bool wxExStream::RunTool()
 {
-  std::ifstream ifs(m_Path.Path());
+  wxExMappedFile file(m_Path.Path().string());
 
-  if (!ifs.is_open() || !ProcessBegin())
+  if (!file.IsOpened() || !ProcessBegin())
   {
     return false;
   }
 
   m_Stats.m_Elements.Set(_("Files").ToStdString(), 1);
-  
-  int line_no = 0;
-  std::vector<std::string> v;
 
-  for (std::string line; std::getline(ifs, line); )
+  const auto text(file.GetContents());
+  
+  if (m_Tool.GetId() == ID_TOOL_REPORT_FIND)
   {
-    if (!Process(line, line_no++)) return false;
+    if (!FindInText(text)) return false;
+  }
+  else
+  {
+    std::string line, out;
+    size_t line_no = 0;
 
     if (m_Write)
     {
-      v.emplace_back(line);
+      out.reserve(text.size());
     }
-  }
 
-  if (m_Modified && m_Write)
-  {
-    std::ofstream ofs(m_Path.Path());
-  
-    for (const auto & it : v)
+    for (size_t start = 0; start < text.size(); )
+    {
+      const auto eol = text.find('\n', start);
+      const auto end = (eol != std::string_view::npos ? eol: text.size());
+
+      line.assign(text.substr(start, end - start));
+      
+      if (!Process(line, line_no++)) return false;
+
+      if (m_Write)
+      {
+        out += line;
+        if (eol != std::string_view::npos) out += '\n';
+      }
+
+      start = end + 1;
+    }
+
+    if (m_Modified && m_Write)
     {
-      ofs << it << std::endl;
+      file.Close();
+      std::ofstream ofs(m_Path.Path(), std::ios::binary);
+      ofs.write(out.data(), out.size());
     }
   }
   
@@ -25,12 +25,15 @@
 #include <wx/extension/filedlg.h>
 #include <wx/extension/frame.h>
 #include <wx/extension/frd.h>
+#include <wx/extension/glob.h>
 #include <wx/extension/lexer.h>
 #include <wx/extension/lexers.h>
 #include <wx/extension/log.h>
 #include <wx/extension/managedframe.h>
 #include <wx/extension/path.h>
 #include <wx/extension/process.h>
+#include <wx/extension/regex-cache.h>
+#include <wx/extension/searcher.h>
 #include <wx/extension/stc.h>
 #include <wx/extension/tokenizer.h>
 #include <wx/extension/tostring.h>
@@ -393,9 +396,21 @@ int wxExGetNumberOfLines(const std::string& text, bool trim)
 const std::string wxExGetStringSet(
   const std::set<std::string>& kset, size_t min_size, const std::string& prefix)
 {
-  return std::accumulate(kset.begin(), kset.end(), std::string{}, 
-    [&](const std::string& a, const std::string& b) {
-      return (b.size() >= min_size && b.find(prefix) == 0) ? a + b + ' ': a;});
+  std::string out;
+
+  // The set is sorted, so all keys starting with prefix 
+  // follow the lower bound of the prefix.
+  for (auto it = kset.lower_bound(prefix); 
+    it != kset.end() && it->compare(0, prefix.size(), prefix) == 0; ++it)
+  {
+    if (it->size() >= min_size)
+    {
+      out += *it;
+      out += ' ';
+    }
+  }
+
+  return out;
 }
 
 const std::string wxExGetWord(std::string& text,
@@ -523,13 +538,15 @@ bool wxExMarkerAndRegisterExpansion(wxExEx* ex, std::string& text)
   return true;
 }
   
-int wxExMatch(const std::string& reg, const std::string& text, 
-  std::vector < std::string > & v)
+namespace
 {
-  try 
+  // Matches, a regex error is thrown to the caller, 
+  // that knows what to log.
+  int Match(const std::regex& reg, const std::string& text, 
+    std::vector < std::string > & v)
   {
     if (std::match_results<std::string::const_iterator> m;
-      !std::regex_search(text, m, std::regex(reg))) 
+      !std::regex_search(text, m, reg)) 
     {
       return -1;
     }
@@ -541,6 +558,15 @@ int wxExMatch(const std::string& reg, const std::string& text,
 
     return v.size();
   }
+}
+
+int wxExMatch(const std::string& reg, const std::string& text, 
+  std::vector < std::string > & v)
+{
+  try 
+  {
+    return Match(*wxExRegexCache::Get(reg), text, v);
+  }
   catch (std::regex_error& e) 
   {
     wxExLog(e) << reg << "code:" << e.code();
@@ -548,22 +574,24 @@ int wxExMatch(const std::string& reg, const std::string& text,
   }
 }
 
-bool wxExMatchesOneOf(const std::string& fullname, const std::string& pattern)
+int wxExMatch(const std::regex& reg, const std::string& text, 
+  std::vector < std::string > & v)
 {
-  if (pattern == "*") return true; // asterix matches always.
-
-  // Make a regex of pattern matching chars.
-  auto re(pattern); 
-  wxExReplaceAll(re, ".", "\\.");
-  wxExReplaceAll(re, "*", ".*");
-  wxExReplaceAll(re, "?", ".?");
-  
-  for (wxExTokenizer tkz(re, ";"); tkz.HasMoreTokens(); )
+  try 
   {
-    if (std::regex_match(fullname, std::regex(tkz.GetNextToken()))) return true;
+    return Match(reg, text, v);
+  }
+  catch (std::regex_error& e) 
+  {
+    // The pattern is not known here, the code tells what failed.
+    wxExLog(e) << "regex search code:" << e.code();
+    return -1;
   }
-  
-  return false;
+}
+
+bool wxExMatchesOneOf(const std::string& fullname, const std::string& pattern)
+{
+  return wxExGlob::Get(pattern)->Matches(fullname);
 }
 
 void wxExNodeProperties(const pugi::xml_node* node, std::vector<wxExProperty>& properties)
@@ -603,9 +631,7 @@ int wxExOpenFiles(wxExFrame* frame, const std::vector< wxExPath > & files,
   
   for (const auto& it : files)
   {
-    if (
-      it.Path().string().find("*") != std::string::npos || 
-      it.Path().string().find("?") != std::string::npos)
+    if (wxExGlob::IsWildcard(it.Path().string()))
     {
       count += wxExDirOpenFile(frame, 
         wxExPath::Current(),
@@ -723,22 +749,34 @@ int wxExReplaceAll(std::string& text,
   const std::string& replace,
   int* match_pos) 
 {
+  const wxExSearcher searcher(search);
+  std::string output;
+  size_t prev = 0;
   int count = 0;
-  bool update = false;
 
-  for (size_t pos = 0; (pos = text.find(search, pos)) != std::string::npos; ) 
+  // Build the output in one pass, instead of replacing in place,
+  // which moves the remaining text for each match.
+  for (size_t pos = 0; 
+    (pos = searcher.Find(text, pos)) != std::string::npos; 
+    pos += search.length()) 
   {
-    if (match_pos != nullptr && !update)
+    if (count == 0)
     {
-      *match_pos = (int)pos;
-      update = true;
+      if (match_pos != nullptr) *match_pos = (int)pos;
+      output.reserve(text.size());
     }
 
-    text.replace(pos, search.length(), replace);
-    pos += replace.length();
+    output.append(text, prev, pos - prev).append(replace);
+    prev = pos + search.length();
 
     count++;
   }
+
+  if (count > 0)
+  {
+    output.append(text, prev, std::string::npos);
+    text.swap(output);
+  }
   
   return count;
 }
@@ -18,6 +18,7 @@
 #include <wx/extension/stc.h>
 #include <wx/extension/util.h>
 #include <wx/extension/variable.h>
+#include <wx/extension/vi.h>
 #include <wx/extension/vi-macros.h>
 #include <easylogging++.h>
 #include "vi-macros-fsm.h"
@@ -70,6 +71,62 @@ wxExViMacrosFSM::wxExViMacrosFSM()
   m_fsm.add_debug_fn(Verbose);
 }
 
+const wxExViMacrosFSM::Program& wxExViMacrosFSM::Compile(
+  const std::string& macro)
+{
+  const auto& source(wxExViMacros::m_Macros[macro]);
+  auto& program(m_Programs[macro]);
+  
+  if (program.m_Source == source)
+  {
+    return program;
+  }
+
+  program.m_Source = source;
+  program.m_Commands.clear();
+  
+  for (const auto& it : source)
+  {
+    std::vector<std::string> v;
+
+    if (it.empty())
+    {
+      program.m_Commands.push_back({it});
+    }
+    else if (it.front() == ':' && it.back() != WXK_ESCAPE)
+    {
+      program.m_Commands.push_back({it, Operations::EX});
+    }
+    // Motions that only loop for their count (these never fail, 
+    // at the end of the document the motion does nothing) are the 
+    // same as one motion with the counts multiplied, so these are merged.
+    else if (wxExMatch("^([1-9][0-9]{0,5})?([jkbweE])$", it, v) == 2)
+    {
+      if (!program.m_Commands.empty() && 
+           program.m_Commands.back().m_Operation == Operations::MOTION &&
+           program.m_Commands.back().m_Text == it)
+      {
+        program.m_Commands.back().m_Count++;
+      }
+      else
+      {
+        program.m_Commands.push_back({it, Operations::MOTION, v[1][0], 
+          v[0].empty() ? 1: std::stoi(v[0])});
+      }
+    }
+    else
+    {
+      program.m_Commands.push_back({it});
+    }
+  }
+
+  VLOG(9) << "vi macro " << macro << 
+    " compiled " << source.size() << 
+    " commands into " << program.m_Commands.size();
+  
+  return program;
+}
+
 bool wxExViMacrosFSM::Execute(
   Triggers trigger, const std::string& macro, wxExEx* ex, int repeat) 
 {
@@ -271,27 +328,34 @@ bool wxExViMacrosFSM::IsPlayback() const
 void wxExViMacrosFSM::Playback()
 {
   wxBusyCursor wait;
+  m_ex->GetSTC()->Freeze();
   m_ex->GetSTC()->BeginUndoAction();
   m_playback = true;
     
   SetAskForInput();
   
-  const auto& macro_commands(wxExViMacros::m_Macros[m_macro]);
+  // Copy the commands, a command might change the macro.
+  const auto commands(Compile(m_macro).m_Commands);
 
-  for (int i = 0; i < m_count && !m_error; i++)
+  // A macro that is only a motion, is repeated at once.
+  const int repeat = (commands.size() == 1 && 
+    commands.front().m_Operation == Operations::MOTION ? m_count: 1);
+
+  for (int i = 0; i < m_count / repeat && !m_error; i++)
   {
-    for (const auto& it : macro_commands)
+    for (const auto& it : commands)
     { 
-      if (!m_ex->Command(it))
+      if (!Run(it, repeat))
       {
         m_error = true;
-        wxLogStatus(_("Macro aborted at '") + it + "'");
+        wxLogStatus(_("Macro aborted at '") + it.m_Text + "'");
         break;
       }
     }
   }
 
   m_ex->GetSTC()->EndUndoAction();
+  m_ex->GetSTC()->Thaw();
   m_playback = false;
 
   if (!m_error)
@@ -301,6 +365,48 @@ void wxExViMacrosFSM::Playback()
   }
 }
 
+bool wxExViMacrosFSM::Run(const Command& command, int repeat) const
+{
+  const auto count = command.m_Count * repeat;
+  
+  // In normal mode, without a key map on the command, vi passes 
+  // an ex command to ex, and a motion with count is the same 
+  // as repeating the motion, so these are run directly.
+  if (
+    command.m_Operation != Operations::VI &&
+    m_ex == &m_ex->GetSTC()->GetVi() &&
+    m_ex->GetSTC()->GetVi().Mode().Normal() &&
+    m_ex->GetMacros().GetKeysMap().find(command.m_Text.front()) == 
+      m_ex->GetMacros().GetKeysMap().end())
+  {
+    switch (command.m_Operation)
+    {
+      case Operations::EX:
+        for (int i = 0; i < count; i++)
+        {
+          if (!m_ex->wxExEx::Command(command.m_Text)) return false;
+        }
+        return true;
+
+      case Operations::MOTION:
+        return m_ex->Command(
+          std::to_string(count * command.m_MotionCount) + command.m_Motion);
+
+      default: break;
+    }
+  }
+
+  for (int i = 0; i < count; i++)
+  {
+    if (!m_ex->Command(command.m_Text))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void wxExViMacrosFSM::SetAskForInput() const
 {
   for (auto& it : wxExViMacros::m_Variables)
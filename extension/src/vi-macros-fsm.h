@@ -5,7 +5,9 @@
 // Copyright: (c) 2018 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <map>
 #include <string>
+#include <vector>
 #include <fsm.h>
 
 enum class States
@@ -92,10 +94,44 @@ public:
       default: return "unhandled trigger";
     };};
 private:
+  /// The operations a macro command is compiled into.
+  enum class Operations
+  {
+    EX,     ///< an ex command
+    MOTION, ///< a motion that only loops for a count
+    VI,     ///< any other command, parsed by vi
+  };
+
+  /// A command of a macro, compiled for playback.
+  struct Command
+  {
+    /// the command as recorded
+    std::string m_Text;
+    /// the operation
+    Operations m_Operation {Operations::VI};
+    /// the motion (for a motion operation)
+    char m_Motion {0};
+    /// the count of the motion within the command
+    int m_MotionCount {1};
+    /// number of times the command is repeated
+    int m_Count {1};
+  };
+
+  /// A macro compiled for playback, kept until the macro changes.
+  struct Program
+  {
+    /// the macro commands compiled
+    std::vector<std::string> m_Source;
+    /// the compiled commands
+    std::vector<Command> m_Commands;
+  };
+
+  const Program& Compile(const std::string& macro);
   void ExpandingTemplate();
   void ExpandingVariable();
   bool ExpandingVariable(const std::string& name, std::string* value) const;
   void Playback();
+  bool Run(const Command& command, int repeat) const;
   void SetAskForInput() const;
   void StartRecording();
   void StopRecording();
@@ -107,6 +143,7 @@ private:
   wxExVariable m_variable;
   std::string* m_expanded {nullptr};
   static inline std::string m_macro;
+  static inline std::map<std::string, Program> m_Programs;
 
   FSM::Fsm<States, States::IDLE, Triggers> m_fsm;
 };
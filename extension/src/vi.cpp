@@ -255,12 +255,14 @@ wxExVi::wxExVi(wxExSTC* stc)
     {"G", [&](const std::string& command){
       if (m_Count == 1)
       {
+        GetSTC()->GetHexMode().RenderAll();
         m_Mode.Visual() ?
           GetSTC()->DocumentEndExtend():
           GetSTC()->DocumentEnd();
       }
       else
       {
+        GetSTC()->GetHexMode().RenderLines(m_Count - 1);
         (void)wxExSTCData(GetSTC()).Control(
            wxExControlData().Line(m_Count)).Inject();
       }
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-autocomplete-index.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <wx/extension/autocomplete-index.h>
+#include "../test.h"
+
+TEST_CASE( "wxExAutoCompleteIndex" )
+{
+  wxExAutoCompleteIndex index(3, 3);
+
+  index.Assign({"class", "classic", "clear", "co", "const", "continue", "do"});
+
+  REQUIRE( index.GetSize() == 5);
+  REQUIRE( index.Get("xx").empty());
+  REQUIRE( index.Get("c") == "class classic clear ");
+  REQUIRE( index.Get("cl") == "class classic clear ");
+  REQUIRE( index.Get("cla") == "class classic ");
+  REQUIRE( index.Get("class") == "class classic ");
+  REQUIRE( index.Get("classi") == "classic ");
+  REQUIRE( index.Get("classix").empty());
+  REQUIRE( index.Get("con") == "const continue ");
+
+  REQUIRE( index.Add("cons"));
+  REQUIRE(!index.Add("cons"));
+  REQUIRE(!index.Add("xy"));
+  REQUIRE( index.Get("con") == "cons const continue ");
+  REQUIRE( index.Get("co") == "cons const continue ");
+  REQUIRE( index.Get("").size() == std::string("class classic clear ").size());
+
+  index.Clear();
+  REQUIRE( index.GetSize() == 0);
+  REQUIRE( index.Get("c").empty());
+
+  SUBCASE("Typing")
+  {
+    // Simulate typing each word of a vocabulary,
+    // with a backspace now and then.
+    const int max = 50000;
+    std::set<std::string> words;
+
+    for (int i = 0; words.size() < max; i++)
+    {
+      std::string word;
+
+      for (int n = i * 7919 + 1; n > 0; n /= 26)
+      {
+        word += 'a' + n % 26;
+      }
+
+      words.insert(word + "_id");
+    }
+
+    wxExAutoCompleteIndex vocabulary(3);
+    vocabulary.Assign(words);
+
+    size_t found = 0;
+    const auto start = std::chrono::system_clock::now();
+
+    for (const auto& word : words)
+    {
+      std::string text;
+
+      for (const auto c : word)
+      {
+        text += c;
+
+        if (text.size() == 4)
+        {
+          text.pop_back();
+          found += vocabulary.Get(text).size();
+          text += c;
+        }
+
+        found += vocabulary.Get(text).size();
+      }
+
+      // The word itself is the first candidate.
+      REQUIRE( vocabulary.Get(text).find(word + " ") == 0);
+    }
+
+    const auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
+
+    REQUIRE( vocabulary.GetSize() == max);
+    REQUIRE( found > 0);
+
+    MESSAGE( "typing " << max << " words: " << milli.count() << " ms");
+  }
+}
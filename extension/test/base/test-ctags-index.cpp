@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-ctags-index.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <experimental/filesystem>
+#include <fstream>
+#include <wx/extension/ctags-entry.h>
+#include <wx/extension/ctags-index.h>
+#include "../test.h"
+
+TEST_CASE( "wxExCTagsIndex" )
+{
+  namespace fs = std::experimental::filesystem;
+
+  const auto index(wxExCTagsIndex::Get(GetTestPath("tags").Path().string()));
+
+  REQUIRE( index != nullptr);
+  REQUIRE( index->IsOk());
+  REQUIRE( index->GetSize() == 2);
+  REQUIRE( wxExCTagsIndex::Get(GetTestPath("tags").Path().string()) == index);
+  REQUIRE( wxExCTagsIndex::Get("xxx") == nullptr);
+
+  REQUIRE( index->Find("wxExTestApp") == std::make_pair((size_t)0, (size_t)2));
+  REQUIRE( index->Find("wxExTest").first == index->Find("wxExTest").second);
+  REQUIRE( index->FindPrefix("wxExTest") == std::make_pair((size_t)0, (size_t)2));
+  REQUIRE( index->FindPrefix("xx").first == index->FindPrefix("xx").second);
+
+  const auto tag(index->GetTag(0));
+  REQUIRE( tag.m_Name == "wxExTestApp");
+  REQUIRE( tag.m_File == "test.h");
+  REQUIRE( tag.m_Pattern == "/^  wxExTestApp() {}$/");
+  REQUIRE( tag.m_Kind == "f");
+  REQUIRE( tag.m_Class == "wxExTestApp");
+  REQUIRE( tag.m_Access == wxExCTagsIndex::ACCESS_NONE);
+  REQUIRE( index->GetTag(1).m_Kind == "c");
+
+  REQUIRE( index->Filter(0, wxExCTagsEntry()));
+  REQUIRE( index->Filter(0, wxExCTagsEntry().Kind("f").Class("wxExTestApp")));
+  REQUIRE(!index->Filter(1, wxExCTagsEntry().Kind("f")));
+  REQUIRE(!index->Filter(0, wxExCTagsEntry().Access("public")));
+  REQUIRE( index->GetClassRows("wxExTestApp")->size() == 1);
+  REQUIRE( index->GetClassRows("xxx") == nullptr);
+
+  int fuzzy = 0;
+  index->FindFuzzy("wTA", [&](size_t row) {fuzzy++; return true;});
+  REQUIRE( fuzzy == 2);
+  index->FindFuzzy("wAT", [&](size_t row) {fuzzy++; return true;});
+  REQUIRE( fuzzy == 2);
+
+  const fs::path tags(fs::temp_directory_path() / "wxex-test-tags");
+
+  const auto write = [&](int max) {
+    std::ofstream ofs(tags);
+    ofs << "!_TAG_FILE_SORTED\t1\t/0=unsorted, 1=sorted, 2=foldcase/\n";
+    for (int i = max - 1; i >= 0; i--)
+    {
+      ofs << "tag" << i << "\tfile" << i % 100 << ".cpp\t" << i + 1 <<
+        ";\"\tkind:f\tclass:class" << i % 1000 << "\taccess:public\n";
+    }};
+
+  SUBCASE("Large")
+  {
+    const int max = 200000;
+    write(max);
+
+    const wxExCTagsIndex large(tags.string());
+    size_t found = 0;
+
+    for (int i = 0; i < 10000; i++)
+    {
+      const auto range(large.FindPrefix("tag" + std::to_string(i)));
+      found += range.second - range.first;
+    }
+
+    REQUIRE( large.GetSize() == max);
+    REQUIRE( large.GetName(0) == "tag0");
+    REQUIRE( large.GetTag(large.Find("tag12").first).m_LineNumber == 13);
+    REQUIRE( large.GetTag(0).m_Access == wxExCTagsIndex::ACCESS_PUBLIC);
+    REQUIRE( large.GetClassRows("class7")->size() == max / 1000);
+    REQUIRE( found > 10000);
+  }
+
+  SUBCASE("Reload")
+  {
+    write(10);
+    const auto first(wxExCTagsIndex::Get(tags.string()));
+    REQUIRE( first->GetSize() == 10);
+
+    write(20);
+    fs::last_write_time(tags,
+      fs::last_write_time(tags) + std::chrono::seconds(10));
+
+    // The current index is used until the reload is ready.
+    REQUIRE( wxExCTagsIndex::Get(tags.string()) == first);
+
+    wxExCTagsIndex::Wait(tags.string());
+
+    const auto next(wxExCTagsIndex::Get(tags.string()));
+    REQUIRE( next != first);
+    REQUIRE( next->GetSize() == 20);
+    REQUIRE( first->GetSize() == 10);
+  }
+
+  SUBCASE("Update")
+  {
+    write(10);
+    REQUIRE( wxExCTagsIndex::Reload(tags.string()));
+    const auto first(wxExCTagsIndex::Get(tags.string()));
+    REQUIRE( first->GetSize() == 10);
+
+    REQUIRE( wxExCTagsIndex::Update(tags.string(), {
+      {"file3.cpp", {"new\tfile3.cpp\t5;\"\tkind:f\tclass:added"}},
+      {"file4.cpp", {}}}));
+
+    // The tags file is not loaded again.
+    const auto next(wxExCTagsIndex::Get(tags.string()));
+    REQUIRE( next != first);
+    REQUIRE( next->GetSize() == 9);
+    REQUIRE( next->GetName(0) == "new");
+    REQUIRE( next->GetTag(0).m_File == "file3.cpp");
+    REQUIRE( next->GetTag(0).m_LineNumber == 5);
+    REQUIRE( next->GetTag(next->Find("tag5").first).m_LineNumber == 6);
+    REQUIRE( next->Find("tag3").first == next->Find("tag3").second);
+    REQUIRE( next->Find("tag4").first == next->Find("tag4").second);
+    REQUIRE( next->GetClassRows("added")->size() == 1);
+    REQUIRE( next->GetClassRows("class3") == nullptr);
+    REQUIRE( first->GetSize() == 10);
+
+    // Saving a file updates a large index in a fraction 
+    // of the time needed to load the tags file.
+    const int max = 200000;
+    write(max);
+    auto start = std::chrono::system_clock::now();
+    REQUIRE( wxExCTagsIndex::Reload(tags.string()));
+    const auto load = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now() - start);
+
+    std::vector<std::string> lines;
+    for (int i = 7; i < max; i += 100)
+    {
+      lines.emplace_back("tag" + std::to_string(i) + "\tfile7.cpp\t1;\"\tkind:f");
+    }
+
+    start = std::chrono::system_clock::now();
+    const int updates = 10;
+
+    for (int i = 0; i < updates; i++)
+    {
+      REQUIRE( wxExCTagsIndex::Update(tags.string(), {{"file7.cpp", lines}}));
+    }
+
+    const auto update = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now() - start);
+
+    REQUIRE( wxExCTagsIndex::Get(tags.string())->GetSize() == max);
+    REQUIRE( wxExCTagsIndex::Get(tags.string())->GetClassRows("class7") == nullptr);
+
+    MESSAGE("ctags index of " << max << " tags, load: " << load.count() <<
+      " ms, update of " << lines.size() << " tags: " << 
+      update.count() / updates << " ms");
+  }
+
+  fs::remove(tags);
+}
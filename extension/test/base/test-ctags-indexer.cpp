@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-ctags-indexer.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <experimental/filesystem>
+#include <fstream>
+#include <wx/extension/ctags-index.h>
+#include <wx/extension/ctags-indexer.h>
+#include "../test.h"
+
+TEST_CASE( "wxExCTagsIndexer" )
+{
+  namespace fs = std::experimental::filesystem;
+
+  // Universal-ctags is required.
+  if (system("ctags --version > /dev/null 2>&1") != 0) return;
+
+  const fs::path dir(fs::temp_directory_path() / "wxex-test-indexer");
+  const fs::path tags(dir / "tags");
+  fs::create_directories(dir / ".git");
+
+  const auto write = [&](const std::string& name, const std::string& text) {
+    std::ofstream ofs(dir / name);
+    ofs << text;};
+
+  write("one.cpp", "int one() {return 1;}\n");
+  write("two.cpp", "class two {};\n");
+  write(".git/hidden.cpp", "int hidden() {return 0;}\n");
+
+  {
+    wxExCTagsIndexer indexer(tags.string());
+    indexer.Add(dir.string(), "*.cpp");
+    indexer.Wait();
+
+    auto index(wxExCTagsIndex::Get(tags.string()));
+    REQUIRE( index != nullptr);
+    REQUIRE( index->Find("one").first != index->Find("one").second);
+    REQUIRE( index->Find("two").first != index->Find("two").second);
+    REQUIRE( index->Find("hidden").first == index->Find("hidden").second);
+    REQUIRE( fs::exists(tags.string() + ".manifest"));
+
+    // A saved file is indexed again.
+    write("one.cpp", "int one() {return 1;}\nint three() {return 3;}\n");
+    REQUIRE( indexer.Update((dir / "one.cpp").string()));
+    REQUIRE(!indexer.Update((dir / "xxx.cpp").string()));
+    indexer.Wait();
+
+    index = wxExCTagsIndex::Get(tags.string());
+    REQUIRE( index->Find("three").first != index->Find("three").second);
+    REQUIRE( index->Find("two").first != index->Find("two").second);
+  }
+
+  // Unchanged files are not indexed again, tags are taken from the file.
+  {
+    wxExCTagsIndexer indexer(tags.string());
+    const auto time = fs::last_write_time(tags);
+    indexer.Add((dir / "two.cpp").string());
+    indexer.Wait();
+    REQUIRE( fs::last_write_time(tags) == time);
+    REQUIRE( indexer.Update((dir / "two.cpp").string()));
+  }
+
+  fs::remove_all(dir);
+}
@@ -5,7 +5,11 @@
 // Copyright: (c) 2017 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <chrono>
+#include <experimental/filesystem>
+#include <fstream>
 #include <wx/extension/dir.h>
+#include <wx/extension/lexers.h>
 #include "../test.h"
 
 TEST_CASE( "wxExDir" ) 
@@ -38,4 +42,73 @@ TEST_CASE( "wxExDir" )
     REQUIRE(wxExGetAllFiles(std::string("./"), "*.txt", DIR_FILES).size() == 4);
     REQUIRE(wxExGetAllFiles(wxExPath("./"), "*.txt", DIR_DIRS).empty());
   }
+
+  SUBCASE( "Shared lexers" ) 
+  {
+    // Each path found has a lexer, that shares its definition 
+    // with the lexers, so walking and copying paths is cheap.
+    REQUIRE(wxExLexers::Get() != nullptr);
+
+    namespace fs = std::experimental::filesystem;
+    const fs::path tree(fs::temp_directory_path() / "wxex-test-dir-lexers");
+    const int max = 2000;
+
+    fs::remove_all(tree);
+
+    for (int i = 0; i < max; i++)
+    {
+      const auto dir(tree / std::to_string(i % 20));
+      fs::create_directories(dir);
+      std::ofstream(dir / (std::to_string(i) + 
+        std::vector<std::string>{".cpp", ".h", ".xml", ".txt", ".md"}[i % 5]));
+    }
+
+    const auto files(wxExGetAllFiles(wxExPath(tree), "*", DIR_FILES | DIR_RECURSIVE));
+    std::vector<wxExPath> copies;
+
+    for (int i = 0; i < 10; i++)
+    {
+      copies.insert(copies.end(), files.begin(), files.end());
+    }
+
+    REQUIRE(files.size() == max);
+    REQUIRE(copies.size() == 10 * max);
+    REQUIRE(&copies.front().GetLexer().GetKeywords() == 
+      &wxExLexers::Get()->FindByFileName(
+        copies.front().GetFullName()).GetKeywords());
+
+    // Benchmark of walking 200k entries, and of copying the paths 
+    // found, by copying (after), and by a new lookup of lexer 
+    // and stat, as the copy constructor did before.
+    const int walks = 100;
+    auto start = std::chrono::system_clock::now();
+    size_t found = 0;
+
+    for (int i = 0; i < walks; i++)
+    {
+      found += wxExGetAllFiles(wxExPath(tree), "*", DIR_FILES | DIR_RECURSIVE).size();
+    }
+
+    const auto walk_milli = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
+
+    REQUIRE(found == walks * max);
+
+    std::vector<wxExPath> after, before;
+    after.reserve(walks * max);
+    before.reserve(walks * max);
+    
+    start = std::chrono::system_clock::now();
+    for (int i = 0; i < walks; i++) for (const auto& f : files) after.emplace_back(f);
+    const auto after_milli = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
+
+    start = std::chrono::system_clock::now();
+    for (int i = 0; i < walks; i++) for (const auto& f : files) before.emplace_back(f.Path());
+    const auto before_milli = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
+
+    MESSAGE( "wxExGetAllFiles: " << walk_milli.count() << " ms for " << 
+      found << " entries, copy paths before: " << before_milli.count() << 
+      " ms, after: " << after_milli.count() << " ms");
+
+    fs::remove_all(tree);
+  }
 }
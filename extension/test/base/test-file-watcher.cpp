@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-file-watcher.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <wx/extension/file-watcher.h>
+#include "../test.h"
+
+bool WaitFor(const std::function<bool()>& f)
+{
+  for (int i = 0; i < 200 && !f(); i++)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  return f();
+}
+
+TEST_CASE( "wxExFileWatcher" ) 
+{
+  auto* watcher = wxExFileWatcher::Get();
+  REQUIRE( watcher != nullptr);
+  REQUIRE( watcher->Watch("XXXXX") == nullptr);
+
+  if (!watcher->IsAvailable()) return;
+
+  std::ofstream("test-watch.log") << "first line\n";
+
+  auto watch = watcher->Watch("test-watch.log");
+  REQUIRE( watch != nullptr);
+  REQUIRE( watch->GetFullPath() == "test-watch.log");
+  REQUIRE( watch->IsChanged());
+  watch->Reset();
+  REQUIRE(!watch->IsChanged());
+
+  std::ofstream("test-watch.log", std::ios::app) << "second line\n";
+  REQUIRE( WaitFor([&] {return watch->IsChanged();}));
+  REQUIRE(!watch->IsLost());
+
+  // Rotate the file.
+  REQUIRE( rename("test-watch.log", "test-watch.log.1") == 0);
+  REQUIRE( WaitFor([&] {return watch->IsLost();}));
+
+  watch.reset();
+  
+  REQUIRE( remove("test-watch.log.1") == 0);
+}
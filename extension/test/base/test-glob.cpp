@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-glob.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <regex>
+#include <wx/extension/glob.h>
+#include <wx/extension/tokenizer.h>
+#include <wx/extension/util.h>
+#include "../test.h"
+
+TEST_CASE( "wxExGlob" ) 
+{
+  SUBCASE( "Matches" ) 
+  {
+    REQUIRE( wxExGlob("*").Matches("test.txt"));
+    REQUIRE(!wxExGlob().Matches("test.txt"));
+    REQUIRE(!wxExGlob("*.cpp").Matches("test.txt"));
+    REQUIRE( wxExGlob("*.cpp;*.txt").Matches("test.txt"));
+    REQUIRE( wxExGlob("test.txt").Matches("test.txt"));
+    REQUIRE( wxExGlob("test*").Matches("test.txt"));
+    REQUIRE( wxExGlob("t?st.*").Matches("test.txt"));
+    REQUIRE(!wxExGlob("t?st.*").Matches("tst.txt"));
+    REQUIRE( wxExGlob("makefile*.*").Matches("makefile.am"));
+    REQUIRE(!wxExGlob("makefile*.*").Matches("makefile"));
+    REQUIRE( wxExGlob("*.cpp;*.txt").GetPattern() == "*.cpp;*.txt");
+
+    REQUIRE( wxExGlob::IsWildcard("*.txt"));
+    REQUIRE( wxExGlob::IsWildcard("test.tx?"));
+    REQUIRE(!wxExGlob::IsWildcard("test.txt"));
+
+    REQUIRE( wxExGlob::Get("*.h") == wxExGlob::Get("*.h"));
+    REQUIRE( wxExGlob::Get("*.h")->Matches("test.h"));
+  }
+
+  SUBCASE( "Same as regex" ) 
+  {
+    const std::string spec("*.cpp;*.h;*.hpp;makefile*.*;CMakeLists.txt");
+    const std::vector<std::string> ext {".cpp", ".h", ".txt", ".am", ".xml"};
+    std::vector<std::string> names;
+
+    for (int i = 0; i < 1000; i++)
+    {
+      names.emplace_back((i % 7 == 0 ? "makefile": "file") + 
+        std::to_string(i) + ext[i % ext.size()]);
+    }
+
+    // The regex matching as done before wxExGlob.
+    auto re(spec); 
+    wxExReplaceAll(re, ".", "\\.");
+    wxExReplaceAll(re, "*", ".*");
+    wxExReplaceAll(re, "?", ".?");
+
+    int matches = 0;
+
+    for (const auto& name : names)
+    {
+      bool regex_match = false;
+
+      for (wxExTokenizer tkz(re, ";"); tkz.HasMoreTokens() && !regex_match; )
+      {
+        regex_match = std::regex_match(name, std::regex(tkz.GetNextToken()));
+      }
+
+      REQUIRE( wxExMatchesOneOf(name, spec) == regex_match);
+
+      if (regex_match) matches++;
+    }
+
+    REQUIRE( matches > 0);
+  }
+
+  SUBCASE( "Timing" ) 
+  {
+    const std::string spec("*.cpp;*.h;*.hpp;makefile*.*;CMakeLists.txt");
+    const std::vector<std::string> ext {".cpp", ".h", ".txt", ".am", ".xml"};
+    std::vector<std::string> names;
+
+    for (int i = 0; i < 100000; i++)
+    {
+      names.emplace_back((i % 7 == 0 ? "makefile": "file") + 
+        std::to_string(i) + ext[i % ext.size()]);
+    }
+
+    // The regex matching as done before wxExGlob.
+    auto re(spec); 
+    wxExReplaceAll(re, ".", "\\.");
+    wxExReplaceAll(re, "*", ".*");
+    wxExReplaceAll(re, "?", ".?");
+
+    int regex_matches = 0;
+    const auto regex_start = std::chrono::system_clock::now();
+
+    for (const auto& name : names)
+    {
+      for (wxExTokenizer tkz(re, ";"); tkz.HasMoreTokens(); )
+      {
+        if (std::regex_match(name, std::regex(tkz.GetNextToken()))) 
+        {
+          regex_matches++;
+          break;
+        }
+      }
+    }
+
+    const auto regex_milli = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - regex_start);
+
+    int glob_matches = 0;
+    const auto glob_start = std::chrono::system_clock::now();
+
+    for (const auto& name : names)
+    {
+      if (wxExMatchesOneOf(name, spec)) glob_matches++;
+    }
+
+    const auto glob_milli = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - glob_start);
+
+    REQUIRE( glob_matches == regex_matches);
+    
+    MESSAGE( "regex: " << regex_milli.count() << " ms, glob: " << 
+      glob_milli.count() << " ms for " << names.size() << " names");
+  }
+}
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-hex-buffer.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wx/extension/hex-buffer.h>
+#include "../test.h"
+
+TEST_CASE( "wxExHexBuffer" )
+{
+  wxExHexBuffer buffer;
+
+  REQUIRE( buffer.GetSize() == 0);
+  REQUIRE( buffer.Get().empty());
+  REQUIRE(!buffer.Erase(0, 1));
+  REQUIRE(!buffer.Replace(0, 'x'));
+  REQUIRE( buffer.Insert(0, "0123"));
+  REQUIRE( buffer.Get() == "0123");
+
+  buffer.Assign("0123456789");
+  REQUIRE( buffer.GetSize() == 10);
+  REQUIRE( buffer.Get(2, 3) == "234");
+  REQUIRE( buffer.Get(8) == "89");
+  REQUIRE( buffer.Get(10).empty());
+
+  REQUIRE( buffer.Replace(1, 'x'));
+  REQUIRE(!buffer.Replace(10, 'x'));
+  REQUIRE( buffer.Get() == "0x23456789");
+  REQUIRE( buffer.Insert(3, "abc"));
+  REQUIRE( buffer.Insert(6, "d"));
+  REQUIRE(!buffer.Insert(15, "d"));
+  REQUIRE( buffer.Get() == "0x2abcd3456789");
+  REQUIRE( buffer.Erase(1, 4));
+  REQUIRE( buffer.Get() == "0cd3456789");
+  REQUIRE( buffer.Erase(8, 100));
+  REQUIRE( buffer.Get() == "0cd34567");
+
+  char copy[4];
+  REQUIRE( buffer.Copy(1, 4, copy) == 4);
+  REQUIRE( std::string(copy, 4) == "cd34");
+  REQUIRE( buffer.Copy(6, 4, copy) == 2);
+
+  buffer.Append("xyz");
+  REQUIRE( buffer.Get() == "0cd34567xyz");
+
+  // Each edit is undone and redone.
+  REQUIRE( buffer.IsModified());
+  REQUIRE( buffer.IsResized());
+  REQUIRE( buffer.CanUndo());
+  REQUIRE(!buffer.CanRedo());
+  auto change(buffer.Undo());
+  REQUIRE( buffer.Get() == "0cd3456789xyz");
+  REQUIRE( change.m_Offset == 8);
+  REQUIRE( change.m_Resized);
+  change = buffer.Redo();
+  REQUIRE( buffer.Get() == "0cd34567xyz");
+  while (buffer.CanUndo()) buffer.Undo();
+  REQUIRE( buffer.Get() == "0123456789xyz");
+  REQUIRE(!buffer.IsModified());
+  REQUIRE( buffer.CanRedo());
+  change = buffer.Redo();
+  REQUIRE( buffer.Get() == "0x23456789xyz");
+  REQUIRE( change.m_Offset == 1);
+  REQUIRE( change.m_Length == 1);
+  REQUIRE(!change.m_Resized);
+
+  // An edit groups changes.
+  buffer.Assign("0123456789");
+  buffer.BeginEdit();
+  buffer.Replace(2, 'a');
+  buffer.Replace(7, 'b');
+  buffer.EndEdit();
+  buffer.Replace(9, 'c');
+  REQUIRE( buffer.Get() == "01a3456b8c");
+  REQUIRE(!buffer.IsResized());
+  const std::vector<std::pair<size_t, size_t>> changed{{2, 1}, {7, 1}, {9, 1}};
+  REQUIRE( buffer.GetChanged() == changed);
+  buffer.Undo();
+  change = buffer.Undo();
+  REQUIRE( buffer.Get() == "0123456789");
+  REQUIRE( change.m_Offset == 2);
+  REQUIRE( change.m_Length == 6);
+  REQUIRE( buffer.GetChanged().empty());
+
+  // Changes are relative to the save point.
+  buffer.Replace(0, 'x');
+  buffer.SetSavePoint();
+  REQUIRE(!buffer.IsModified());
+  buffer.Insert(1, "ab");
+  buffer.Erase(3, 2);
+  REQUIRE( buffer.Get() == "xab3456789");
+  REQUIRE( buffer.IsModified());
+  REQUIRE( buffer.GetChanged().size() == 1);
+  REQUIRE( buffer.GetChanged().front() == std::make_pair((size_t)1, (size_t)2));
+  buffer.ClearSavePoint();
+  REQUIRE( buffer.IsModified());
+  REQUIRE( buffer.IsResized());
+
+  // Search spans the pieces.
+  REQUIRE( buffer.Search("ab3") == 1);
+  REQUIRE( buffer.Search("ab3", 2) == std::string::npos);
+  REQUIRE( buffer.Search("AB", 0, false) == 1);
+  REQUIRE( buffer.Search("AB") == std::string::npos);
+  REQUIRE( buffer.SearchLast("9") == 9);
+  REQUIRE( buffer.SearchLast("xx") == std::string::npos);
+
+  SUBCASE("Many edits")
+  {
+    // Edit a large buffer, compared to the same edits on a string.
+    const int max = 1000000;
+    std::string text(max, 0);
+    for (int i = 0; i < max; i++) text[i] = i % 256;
+
+    buffer.Assign(text);
+
+
+    for (int i = 0; i < 1000; i++)
+    {
+      const size_t offset = (size_t)i * 7919 % text.size();
+
+      switch (i % 3)
+      {
+        case 0: 
+          buffer.Replace(offset, 'x'); 
+          text[offset] = 'x'; 
+          break;
+        case 1: 
+          buffer.Insert(offset, "abc"); 
+          text.insert(offset, "abc"); 
+          break;
+        case 2: 
+          buffer.Erase(offset, 5); 
+          text.erase(offset, 5); 
+          break;
+      }
+
+      REQUIRE( buffer.Get(offset, 16) == text.substr(offset, 16));
+    }
+
+    REQUIRE( buffer.GetSize() == text.size());
+    REQUIRE( buffer.Get() == text);
+
+    while (buffer.CanUndo()) buffer.Undo();
+    REQUIRE( buffer.GetSize() == max);
+    REQUIRE(!buffer.IsModified());
+  }
+}
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-listview-sort.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <wx/extension/listview-sort.h>
+#include "../test.h"
+
+TEST_CASE( "wxExListViewSortKeys" )
+{
+  SUBCASE("Int")
+  {
+    wxExListViewSortKeys keys;
+    for (const auto i : {5, 3, 9, 3, -1}) keys.Add((int64_t)i);
+    REQUIRE( keys.GetSize() == 5);
+    REQUIRE( keys.Sort(true) == std::vector<long>({4, 1, 3, 0, 2}));
+    REQUIRE( keys.Sort(false) == std::vector<long>({2, 0, 1, 3, 4}));
+  }
+
+  SUBCASE("Float")
+  {
+    wxExListViewSortKeys keys;
+    for (const auto f : {2.5, 0.5, 1.0}) keys.Add(f);
+    REQUIRE( keys.Sort(true) == std::vector<long>({1, 2, 0}));
+  }
+
+  SUBCASE("String")
+  {
+    wxExListViewSortKeys keys;
+    for (const auto& s : {"b", "B", "a", "A"}) keys.Add(std::string(s));
+    REQUIRE( keys.Sort(true) == std::vector<long>({3, 1, 2, 0}));
+
+    wxExListViewSortKeys nocase(false);
+    for (const auto& s : {"b", "B", "a", "A"}) nocase.Add(std::string(s));
+    REQUIRE( nocase.Sort(true) == std::vector<long>({2, 3, 0, 1}));
+    REQUIRE( nocase.Sort(false) == std::vector<long>({0, 1, 2, 3}));
+  }
+
+  SUBCASE("Empty")
+  {
+    REQUIRE( wxExListViewSortKeys().Sort(true).empty());
+  }
+
+  SUBCASE("Many rows")
+  {
+    // Sort 1M rows, large enough to be sorted using several threads,
+    // and compare with a plain stable sort.
+    const long max = 1000000;
+    std::mt19937 gen(1);
+    std::vector<std::string> rows;
+
+    for (long i = 0; i < max; i++)
+    {
+      rows.emplace_back(std::to_string(gen() % 100000));
+    }
+
+    for (const bool match_case : {true, false})
+    {
+      wxExListViewSortKeys ints, strings(match_case);
+
+      for (const auto& row : rows)
+      {
+        ints.Add((int64_t)std::stoll(row));
+        strings.Add("file" + row);
+      }
+
+      const auto start = std::chrono::system_clock::now();
+      const auto order_ints(ints.Sort(true));
+      const auto order_strings(strings.Sort(false));
+      const auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
+
+      MESSAGE( "sort " << max << " ints and strings (match case " << 
+        match_case << "): " << milli.count() << " ms");
+
+      std::vector<long> expect(max);
+      for (long i = 0; i < max; i++) expect[i] = i;
+      std::stable_sort(expect.begin(), expect.end(), [&](long x, long y) {
+        return std::stoll(rows[x]) < std::stoll(rows[y]);});
+
+      REQUIRE( order_ints == expect);
+      REQUIRE( order_strings.size() == max);
+      REQUIRE( std::is_sorted(order_strings.begin(), order_strings.end(), 
+        [&](long x, long y) {return rows[y] < rows[x];}));
+    }
+  }
+}
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-listview-store.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wx/extension/listview-store.h>
+#include "../test.h"
+
+TEST_CASE( "wxExListViewStore" )
+{
+  wxExListViewStore store;
+  store.AddColumn(wxExListViewStore::STORE_STRING);
+  store.AddColumn(wxExListViewStore::STORE_INT);
+  store.AddColumn(wxExListViewStore::STORE_TEXT);
+
+  REQUIRE( store.GetColumns() == 3);
+  REQUIRE( store.GetRows() == 0);
+
+  REQUIRE( store.AddRow() == 0);
+  store.Set(0, 0, "test.h");
+  store.Set(0, 1, "12");
+  store.Set(0, 2, "  xx yy");
+  store.SetData(0, 1);
+  store.SetImage(0, 3);
+
+  REQUIRE( store.Get(0, 0) == "test.h");
+  REQUIRE( store.Get(0, 1) == "12");
+  REQUIRE( store.Get(0, 2) == "  xx yy");
+  REQUIRE( store.GetData(0) == 1);
+  REQUIRE( store.GetImage(0) == 3);
+
+  REQUIRE( store.CopyRow(0) == 1);
+  store.Set(1, 1, "-7");
+  store.Set(1, 2, std::string());
+  REQUIRE( store.Get(1, 0) == "test.h");
+  REQUIRE( store.Get(1, 1) == "-7");
+  REQUIRE( store.Get(1, 2).empty());
+  REQUIRE( store.GetData(1) == 1);
+
+  REQUIRE( store.Insert(0) == 0);
+  REQUIRE( store.GetRows() == 3);
+  REQUIRE( store.Get(0, 0).empty());
+  REQUIRE( store.Get(0, 1).empty());
+  REQUIRE( store.GetImage(0) == -1);
+  REQUIRE( store.Get(1, 1) == "12");
+
+  SUBCASE("Permute")
+  {
+    store.Permute({2, 0, 1});
+    REQUIRE( store.Get(0, 1) == "-7");
+    REQUIRE( store.Get(1, 1).empty());
+    REQUIRE( store.Get(2, 1) == "12");
+    REQUIRE( store.Get(2, 2) == "  xx yy");
+    REQUIRE( store.GetImage(2) == 3);
+  }
+
+  SUBCASE("Delete")
+  {
+    store.Delete(0);
+    REQUIRE( store.GetRows() == 2);
+    REQUIRE( store.Get(0, 1) == "12");
+    store.Clear();
+    REQUIRE( store.GetRows() == 0);
+    REQUIRE( store.GetColumns() == 3);
+    REQUIRE( store.AddRow() == 0);
+    REQUIRE( store.Get(0, 0).empty());
+  }
+
+  SUBCASE("Int becomes string")
+  {
+    store.Set(0, 1, "007");
+    REQUIRE( store.GetType(1) == wxExListViewStore::STORE_STRING);
+    REQUIRE( store.Get(0, 1) == "007");
+    REQUIRE( store.Get(1, 1) == "12");
+    REQUIRE( store.Get(2, 1) == "-7");
+  }
+
+  SUBCASE("Many rows")
+  {
+    const long max = 500000;
+
+    store.Clear();
+
+    for (long i = 0; i < max; i++)
+    {
+      const auto row = store.AddRow();
+      store.Set(row, 0, "file" + std::to_string(i % 100) + ".cpp");
+      store.Set(row, 1, std::to_string(i));
+      store.Set(row, 2, "a line of context with a match");
+    }
+
+    REQUIRE( store.GetRows() == max);
+    REQUIRE( store.Get(max - 1, 0) == "file99.cpp");
+    REQUIRE( store.Get(max - 1, 1) == std::to_string(max - 1));
+    REQUIRE( store.Get(max - 1, 2) == "a line of context with a match");
+
+    store.Delete(0);
+    REQUIRE( store.GetRows() == max - 1);
+    REQUIRE( store.Get(0, 0) == "file1.cpp");
+  }
+}
@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-mapped-file.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wx/extension/mapped-file.h>
+#include "../test.h"
+
+TEST_CASE( "wxExMappedFile" ) 
+{
+  wxExMappedFile file(GetTestPath("test.h").Path().string());
+
+  REQUIRE( file.IsOpened());
+  REQUIRE(!file.GetContents().empty());
+  REQUIRE( file.GetContents().find("test") != std::string_view::npos);
+#ifdef __UNIX__
+  REQUIRE( file.IsMapped());
+#endif
+
+  file.Close();
+  REQUIRE(!file.IsOpened());
+  REQUIRE( file.GetContents().empty());
+
+  REQUIRE(!file.Open("XXXXX"));
+  REQUIRE(!file.IsOpened());
+  REQUIRE(!wxExMappedFile().IsOpened());
+
+  REQUIRE( file.Open(GetTestPath("test.bin").Path().string()));
+  REQUIRE(!file.GetContents().empty());
+}
@@ -6,6 +6,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <chrono>
+#include <fstream>
 #include <wx/extension/path.h>
 #include "../test.h"
 
@@ -56,6 +57,32 @@ TEST_CASE( "wxExPath" )
     REQUIRE( wxExPath("XXXXX").MakeAbsolute("yyy").GetFullName() == "XXXXX");
   }
 
+  SUBCASE( "Sync" ) 
+  {
+    namespace fs = std::experimental::filesystem;
+    const auto name((fs::temp_directory_path() / "wxex-test-path-sync").string());
+
+    fs::remove(name);
+
+    // The stat is kept until sync, also by copies.
+    wxExPath path(name);
+    REQUIRE(!path.FileExists());
+    std::ofstream(name) << "hello";
+    REQUIRE(!path.FileExists());
+    REQUIRE(!wxExPath(path).FileExists());
+    REQUIRE( path.Sync());
+    REQUIRE( path.FileExists());
+    REQUIRE( wxExPath(path).GetStat().st_size == 5);
+
+    // A path with a stat does not retrieve it again.
+    const wxExStat stat(name);
+    fs::remove(name);
+    REQUIRE( wxExPath(name, stat).FileExists());
+    REQUIRE(!wxExPath(name).FileExists());
+    REQUIRE(!path.Sync());
+    REQUIRE(!path.FileExists());
+  }
+
   SUBCASE( "Timing" ) 
   {
     const int max = 1000;
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-process-reader.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
+#include <wx/wfstream.h>
+#include <wx/extension/process-reader.h>
+#include "../test.h"
+
+TEST_CASE( "wxExProcessReader" )
+{
+#ifdef __UNIX__
+  SUBCASE( "lines" )
+  {
+    FILE* fp = popen("printf 'one\\ntwo\\nthree'", "r");
+    REQUIRE( fp != nullptr);
+
+    int notified = 0;
+    std::string output;
+
+    {
+      wxExProcessReader reader({new wxFileInputStream(dup(fileno(fp)))}, [&] {notified++;});
+
+      while (!reader.IsEnded())
+      {
+        reader.Wait(std::chrono::milliseconds(100));
+        output += reader.Get();
+      }
+    }
+
+    REQUIRE( output == "one\ntwo\nthree");
+    REQUIRE( notified > 0);
+    pclose(fp);
+  }
+
+  SUBCASE( "large" )
+  {
+    // Stream 100MB through cat.
+    const size_t size = 100000000;
+    FILE* fp = popen(
+      "yes 0123456789012345678901234567890123456789 | head -c 100000000 | cat", "r");
+    REQUIRE( fp != nullptr);
+
+    size_t read = 0;
+    const auto start = std::chrono::system_clock::now();
+
+    {
+      wxExProcessReader reader({new wxFileInputStream(dup(fileno(fp)))});
+
+      while (!reader.IsEnded())
+      {
+        reader.Wait(std::chrono::milliseconds(100));
+        read += reader.Get().size();
+      }
+    }
+
+    const std::chrono::duration<double> seconds(
+      std::chrono::system_clock::now() - start);
+
+    REQUIRE( read == size);
+    pclose(fp);
+
+    MESSAGE("process reader: " << read / 1000000 << " MB in " <<
+      seconds.count() << " s, " << read / 1000000 / seconds.count() << " MB/s");
+  }
+#endif
+}
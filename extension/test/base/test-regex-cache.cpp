@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-regex-cache.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <thread>
+#include <wx/extension/regex-cache.h>
+#include "../test.h"
+
+TEST_CASE( "wxExRegexCache" ) 
+{
+  wxExRegexCache::Reset();
+  REQUIRE( wxExRegexCache::GetSize() == 0);
+  REQUIRE( wxExRegexCache::GetHits() == 0);
+  REQUIRE( wxExRegexCache::GetMisses() == 0);
+
+  const auto re(wxExRegexCache::Get("([0-9]+)ok"));
+  REQUIRE( std::regex_search("1999ok", *re));
+  REQUIRE( wxExRegexCache::Get("([0-9]+)ok") == re);
+  REQUIRE( wxExRegexCache::Get("([0-9]+)ok", std::regex::icase) != re);
+  REQUIRE( wxExRegexCache::GetHits() == 1);
+  REQUIRE( wxExRegexCache::GetMisses() == 2);
+  REQUIRE( wxExRegexCache::GetSize() == 2);
+
+  REQUIRE_THROWS_AS( wxExRegexCache::Get("(xx"), std::regex_error);
+  REQUIRE( wxExRegexCache::GetSize() == 2);
+
+  // The cache is bounded, least recently used are removed.
+  for (size_t i = 0; i < wxExRegexCache::GetMaxSize() + 10; i++)
+  {
+    wxExRegexCache::Get("x" + std::to_string(i));
+  }
+
+  REQUIRE( wxExRegexCache::GetSize() == wxExRegexCache::GetMaxSize());
+  REQUIRE( wxExRegexCache::Get("([0-9]+)ok") != re);
+
+  // The cache can be used by several threads.
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < 4; i++)
+  {
+    threads.emplace_back([] {
+      for (int j = 0; j < 1000; j++)
+      {
+        wxExRegexCache::Get("y" + std::to_string(j % 200));
+      }});
+  }
+
+  for (auto& thread : threads) thread.join();
+
+  REQUIRE( wxExRegexCache::GetSize() == wxExRegexCache::GetMaxSize());
+}
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-regex-dfa.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <tuple>
+#include <vector>
+#include <wx/extension/regex-dfa.h>
+#include "../test.h"
+
+TEST_CASE( "wxExRegExDFA" ) 
+{
+  SUBCASE( "Find" ) 
+  {
+    const wxExRegExDFA dfa("find[0-9]+");
+    REQUIRE( dfa.GetStates() > 0);
+    REQUIRE( dfa.Matches("some text find9 other text") == 10);
+    REQUIRE( dfa.Matches("some text finda other text") == -1);
+    REQUIRE( dfa.Find("find1 find23", 1) == std::make_pair<size_t, size_t>(6, 6));
+    REQUIRE( dfa.Find("find1 find23", 7).first == std::string::npos);
+
+    REQUIRE( wxExRegExDFA("^a").Matches("baa") == -1);
+    REQUIRE( wxExRegExDFA("a$").Matches("aab") == -1);
+    REQUIRE( wxExRegExDFA("a$").Matches("baa") == 2);
+    REQUIRE( wxExRegExDFA("HELLO", false).Matches("say hello") == 4);
+    REQUIRE( wxExRegExDFA("[^a]", false).Matches("aAb") == 2);
+    REQUIRE( wxExRegExDFA("(ab){2,3}c").Matches("abcabababc") == 3);
+    REQUIRE( wxExRegExDFA("\\d+\\.\\d+").Matches("version 3.14") == 8);
+    REQUIRE( wxExRegExDFA("(?:x|y)z").Matches("ayz") == 1);
+
+    // Not supported constructs.
+    REQUIRE_THROWS_AS( wxExRegExDFA("a*?"), std::regex_error);
+    REQUIRE_THROWS_AS( wxExRegExDFA("(?=a)"), std::regex_error);
+    REQUIRE_THROWS_AS( wxExRegExDFA("(a)\\1"), std::regex_error);
+    REQUIRE_THROWS_AS( wxExRegExDFA("\\bword"), std::regex_error);
+    REQUIRE_THROWS_AS( wxExRegExDFA("find[0-9"), std::regex_error);
+    REQUIRE_THROWS_AS( wxExRegExDFA("x*"), std::regex_error);
+    REQUIRE_THROWS_AS( wxExRegExDFA("(a*)+b"), std::regex_error);
+
+    // A search that fails goes over the text once.
+    REQUIRE( wxExRegExDFA("a*b").Matches(std::string(1000000, 'a')) == -1);
+  }
+
+  SUBCASE( "ReplaceAll" ) 
+  {
+    for (const auto type : {wxExRegExEngine::REGEX_STD, wxExRegExEngine::REGEX_DFA})
+    {
+      CAPTURE( type );
+      const auto engine(wxExRegExEngine::Create("find[0-9]", true, type));
+      std::string text("find1 find2 find3 find4");
+      REQUIRE( engine->ReplaceAll(text, "<$&>") == 4);
+      REQUIRE( text == "<find1> <find2> <find3> <find4>");
+      REQUIRE( engine->ReplaceAll(text, "x") == 4);
+      REQUIRE( engine->ReplaceAll(text, "x") == 0);
+      REQUIRE( text == "<x> <x> <x> <x>");
+
+      text = "axxb";
+      REQUIRE( wxExRegExEngine::Create("x*", true, type)->ReplaceAll(text, "-") == 4);
+      REQUIRE( text == "-a--b-");
+
+      text = "john smith";
+      REQUIRE( wxExRegExEngine::Create("(\\w+) (\\w+)", true, type)->ReplaceAll(text, "$2 $1") == 1);
+      REQUIRE( text == "smith john");
+    }
+
+    // Falls back to std::regex.
+    REQUIRE( wxExRegExEngine::Create("(a)\\1", true, wxExRegExEngine::REGEX_DFA)->Matches("xaa") == 1);
+    REQUIRE_THROWS_AS( wxExRegExEngine::Create("find[0-9", true, wxExRegExEngine::REGEX_DFA), std::regex_error);
+  }
+
+  SUBCASE( "Same as std::regex" ) 
+  {
+    // Matches are leftmost-first, as ECMAScript, not leftmost-longest.
+    for (const auto& [regex, match_case, text] : 
+      std::vector<std::tuple<std::string, bool, std::string>> {
+        {"A+(ab)*", false, "aAAb1a1"},
+        {"a|ab", true, "xabab"},
+        {"(a|ab)(c|bcd)", true, "abcd"},
+        {"[0-9]+|[0-9]+\\.[0-9]+", true, "3.14 and 2.71"},
+        {"x.+y|x", true, "xay xyy\nxy"},
+        {"(ab|a)+b?", true, "ababab aab"},
+        {"^ab|b$", true, "abab"},
+        {"ERROR.*file[0-9]+\\.cpp", true, "ERROR in file1.cpp and file22.cpp"}})
+    {
+      CAPTURE( regex );
+      CAPTURE( text );
+
+      std::string text_std(text), text_dfa(text);
+      const auto engine(wxExRegExEngine::Create(regex, match_case, wxExRegExEngine::REGEX_STD));
+      const wxExRegExDFA dfa(regex, match_case);
+
+      REQUIRE( dfa.Matches(text) == engine->Matches(text));
+      REQUIRE( dfa.ReplaceAll(text_dfa, "<$&>") == engine->ReplaceAll(text_std, "<$&>"));
+      REQUIRE( text_dfa == text_std);
+    }
+  }
+
+  SUBCASE( "Timing" ) 
+  {
+    std::vector<std::string> lines;
+
+    for (int i = 0; i < 100000; i++)
+    {
+      lines.emplace_back("2018-03-0" + std::to_string(i % 9 + 1) + 
+        " 12:34:56.789 [thread-" + std::to_string(i % 16) + "] " + 
+        (i % 50 == 0 ? "ERROR": "INFO ") + 
+        " processing file /home/user/src/file" + std::to_string(i) + 
+        ".cpp in " + std::to_string(i % 1000) + " ms");
+    }
+
+    for (const auto type : {wxExRegExEngine::REGEX_STD, wxExRegExEngine::REGEX_DFA})
+    {
+      const auto engine(wxExRegExEngine::Create("ERROR.*file[0-9]+\\.cpp", true, type));
+      const auto start = std::chrono::system_clock::now();
+      int matches = 0, replaced = 0;
+
+      for (auto line : lines)
+      {
+        if (engine->Matches(line) >= 0) matches++;
+        replaced += engine->ReplaceAll(line, "x");
+      }
+
+      const auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
+
+      REQUIRE( matches == 2000);
+      REQUIRE( replaced == 2000);
+
+      MESSAGE( (type == wxExRegExEngine::REGEX_STD ? "std::regex: ": "dfa: ") << 
+        milli.count() << " ms for " << lines.size() << " lines");
+    }
+  }
+}
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-searcher.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <wx/extension/searcher.h>
+#include <wx/extension/util.h>
+#include "../test.h"
+
+TEST_CASE( "wxExSearcher" ) 
+{
+  const std::vector<wxExSearcher::wxExSearcherKernel> kernels {
+    wxExSearcher::KERNEL_SCALAR, 
+    wxExSearcher::KERNEL_SSE2, 
+    wxExSearcher::KERNEL_AVX2};
+
+  SUBCASE( "Find" ) 
+  {
+    REQUIRE( wxExSearcher::IsSupported(wxExSearcher::KERNEL_SCALAR));
+    REQUIRE( wxExSearcher().Find("hello") == std::string::npos);
+    REQUIRE( wxExSearcher("hello").GetFindString() == "hello");
+    REQUIRE( wxExSearcher("hello").MatchCase());
+    REQUIRE( wxExSearcher("x", true, wxExSearcher::KERNEL_SCALAR).GetKernel() == 
+      wxExSearcher::KERNEL_SCALAR);
+    REQUIRE( wxExSearcher("x").GetKernel() != wxExSearcher::KERNEL_DEFAULT);
+
+    // Texts longer than one block, with matches near the block boundaries.
+    const std::string text(
+      std::string(29, '-') + "Hello" + std::string(40, '-') + "hello" + "--xhellx");
+
+    for (const auto kernel : kernels)
+    {
+      CAPTURE( kernel );
+      REQUIRE( wxExSearcher("hello", true, kernel).Find(text) == 74);
+      REQUIRE( wxExSearcher("hello", false, kernel).Find(text) == 29);
+      REQUIRE( wxExSearcher("HELLO", false, kernel).Find(text, 30) == 74);
+      REQUIRE( wxExSearcher("hello", true, kernel).Find(text, 75) == std::string::npos);
+      REQUIRE( wxExSearcher("hellx", true, kernel).Find(text) == text.size() - 5);
+      REQUIRE( wxExSearcher("-", true, kernel).Find(text, 50) == 50);
+      REQUIRE( wxExSearcher("xyz", true, kernel).Find(text) == std::string::npos);
+      REQUIRE( wxExSearcher("hello", true, kernel).Find("hell") == std::string::npos);
+      REQUIRE( wxExSearcher("hello", true, kernel).Find(text, 1000) == std::string::npos);
+    }
+  }
+
+  SUBCASE( "wxExReplaceAll" ) 
+  {
+    std::string text("aaabaaab");
+    int match_pos = -1;
+    REQUIRE( wxExReplaceAll(text, "ab", "x", &match_pos) == 2);
+    REQUIRE( text == "aaxaax");
+    REQUIRE( match_pos == 2);
+    REQUIRE( wxExReplaceAll(text, "", "x") == 0);
+    REQUIRE( wxExReplaceAll(text, "z", "x") == 0);
+    REQUIRE( text == "aaxaax");
+  }
+  
+  SUBCASE( "Kernels" ) 
+  {
+    // Matches at each offset within a block, all kernels
+    // should find the same matches as std::string.
+    const std::string line(
+      "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod\n");
+    std::string text;
+
+    for (int i = 0; i < 64; i++)
+    {
+      text += line.substr(0, i) + (i % 2 == 0 ? "Needle": "needle") + line;
+    }
+
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+    for (const auto kernel : kernels)
+    {
+      for (const auto match_case : {true, false})
+      {
+        const wxExSearcher searcher("needle", match_case, kernel);
+        const auto& other(match_case ? text: lower);
+
+        CAPTURE( searcher.GetKernel() );
+        CAPTURE( match_case );
+
+        int matches = 0;
+        auto expect = other.find("needle");
+
+        for (auto pos = searcher.Find(text); pos != std::string::npos; 
+          pos = searcher.Find(text, pos + 1))
+        {
+          REQUIRE( pos == expect);
+          expect = other.find("needle", expect + 1);
+          matches++;
+        }
+
+        REQUIRE( expect == std::string::npos);
+        REQUIRE( matches == (match_case ? 32: 64));
+      }
+    }
+  }
+
+  SUBCASE( "Throughput" ) 
+  {
+    // The corpus size in MB can be set using WXEX_SEARCHER_MB.
+    const auto* env = std::getenv("WXEX_SEARCHER_MB");
+    const size_t mb = (env != nullptr && atoi(env) > 0 ? atoi(env): 256);
+    const std::string text(std::string(mb * 1024 * 1024, '-') + "Needle");
+
+    for (const auto kernel : kernels)
+    {
+      const wxExSearcher searcher("needle", false, kernel);
+      const auto start = std::chrono::steady_clock::now();
+      REQUIRE( searcher.Find(text) == text.size() - 6);
+      const std::chrono::duration<double> seconds(
+        std::chrono::steady_clock::now() - start);
+
+      MESSAGE( "kernel " << searcher.GetKernel() << ": " << 
+        text.size() / seconds.count() / 1e9 << " GB/s for " << mb << " MB");
+    }
+  }
+}
@@ -15,6 +15,11 @@ TEST_CASE( "wxExStat" )
   REQUIRE( stat.IsOk());
   REQUIRE(!stat.GetModificationTime().empty());
   REQUIRE(!stat.IsReadOnly());
+  REQUIRE( stat.IsRegularFile());
+  REQUIRE(!stat.IsDirectory());
+  REQUIRE( wxExStat(GetTestPath().Path().string()).IsDirectory());
+  REQUIRE(!wxExStat("XXXXX").IsRegularFile());
+  REQUIRE(!wxExStat("XXXXX").IsReadOnly());
   REQUIRE( stat.Sync(GetTestPath("test-base.link").Path().string()));
   REQUIRE( stat.Sync());
   REQUIRE(!stat.GetModificationTime().empty());
@@ -5,6 +5,7 @@
 // Copyright: (c) 2017 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <wx/extension/frd.h>
 #include <wx/extension/util.h>
 #include <wx/extension/report/dir.h>
 #include <wx/extension/report/listviewfile.h>
@@ -33,6 +34,21 @@ TEST_CASE("wxExDirTool")
   dir.FindFiles();
 
   wxExLogStatus(tool.Info(&dir.GetStatistics().GetElements()));
+  
+  wxExFindReplaceData::Get()->SetUseRegEx(false);
+  wxExFindReplaceData::Get()->SetFindString("TEST_CASE");
+  
+  wxExDirTool parallel(
+    tool,
+    "../../../extension/test/gui-report",
+    "*.cpp",
+    DIR_FILES);
+
+  const auto items = report->GetItemCount();
+  
+  REQUIRE( parallel.FindFiles() > 5);
+  REQUIRE( parallel.GetStatistics().Get(_("Files").ToStdString()) > 5);
+  REQUIRE( report->GetItemCount() > items + 5);
 }
 
 TEST_CASE("wxExDirWithListView")
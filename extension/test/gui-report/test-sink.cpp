@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-sink.cpp
+// Purpose:   Implementation for wxExtension report unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <thread>
+#include <wx/extension/report/sink.h>
+#include "test.h"
+
+TEST_CASE("wxExResultSink")
+{
+  wxExListView* report = new wxExListView(wxExListViewData().Type(LIST_FIND));
+  AddPane(GetFrame(), report);
+
+  wxExResultSink sink(report);
+
+  REQUIRE( sink.GetListView() == report);
+  REQUIRE( sink.IsEmpty());
+  REQUIRE( sink.Drain(true) == 0);
+
+  const auto items = report->GetItemCount();
+
+  sink.Push(GetTestPath("test.h"), "xx", {{0, "xx yy"}, {4, "  xx zz"}});
+  REQUIRE(!sink.IsEmpty());
+  REQUIRE( sink.Drain(true) == 2);
+  REQUIRE( sink.IsEmpty());
+  REQUIRE( report->GetItemCount() == items + 2);
+  REQUIRE( report->GetItemText(items, _("Line No").ToStdString()) == "1");
+  REQUIRE( report->GetItemText(items + 1, _("Line").ToStdString()) == "  xx zz");
+  REQUIRE( report->GetItemText(items + 1, _("Match").ToStdString()) == "xx");
+
+  // A batch directly after the previous one is postponed.
+  sink.Push(GetTestPath("test.h"), "xx", {{1, "xx"}});
+  REQUIRE( sink.Drain() == 0);
+  REQUIRE(!sink.IsEmpty());
+  REQUIRE( sink.Drain(true) == 1);
+
+  SUBCASE("Threads")
+  {
+    const int threads = 4;
+    const int files = 250;
+    std::vector<std::thread> v;
+
+    for (int i = 0; i < threads; i++)
+    {
+      v.emplace_back([&] {
+        for (int j = 0; j < files; j++)
+        {
+          sink.Push(GetTestPath("test.h"), "xx", {{j, "xx"}, {j + 1, "xx"}});
+        }});
+    }
+
+    for (auto& it : v)
+    {
+      it.join();
+    }
+
+    REQUIRE( sink.Drain(true) == threads * files * 2);
+    REQUIRE( sink.IsEmpty());
+  }
+}
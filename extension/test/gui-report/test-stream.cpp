@@ -38,4 +38,12 @@ TEST_CASE("wxExStreamToListView")
   wxExStreamToListView textFile3(GetTestPath("test.h"), tool3);
   REQUIRE( textFile3.RunTool());
   REQUIRE(!textFile3.GetStatistics().GetElements().GetItems().empty());
+  
+  // Destroying the report deletes its sink, with results not reported.
+  wxExListView* closed = new wxExListView(wxExListViewData().Type(LIST_FIND));
+  REQUIRE(wxExStreamToListView::SetupTool(tool, GetFrame(), closed));
+  REQUIRE(wxExStreamToListView::GetSink()->GetListView() == closed);
+  wxExStreamToListView::GetSink()->Push(GetTestPath("test.h"), "xx", {{0, "xx"}});
+  delete closed;
+  REQUIRE(wxExStreamToListView::GetSink() == nullptr);
 }
@@ -207,6 +207,28 @@ TEST_CASE("wxExAddressRange")
   REQUIRE( wxExAddressRange(ex, "%").Substitute("/'//"));
   REQUIRE( stc->GetText().Contains("char  present"));
   
+  // Test Substitute on many lines.
+  std::string many;
+  for (int i = 0; i < 500000; i++) many += "line xxxx xxxx\n";
+  stc->SetText(many);
+  REQUIRE( wxExAddressRange(ex, "%").Substitute("/x/y/g"));
+  REQUIRE( stc->GetLineCount() == 500001);
+  REQUIRE(!stc->GetText().Contains("x"));
+  REQUIRE( wxExAddressRange(ex, "2,3").Substitute("/y/\\U&/"));
+  REQUIRE( stc->GetLine(0) == "line yyyy yyyy\n");
+  REQUIRE( stc->GetLine(1) == "line Yyyy yyyy\n");
+  REQUIRE( stc->GetLine(2) == "line Yyyy yyyy\n");
+  REQUIRE( stc->GetLine(3) == "line yyyy yyyy\n");
+  stc->Undo();
+  REQUIRE( stc->GetLine(1) == "line yyyy yyyy\n");
+  
+  // Test Substitute keeps text after a nul char.
+  stc->ClearAll();
+  stc->AddTextRaw("a\0b xx\nc\n", 9);
+  REQUIRE( wxExAddressRange(ex, "%").Substitute("/x/y/g"));
+  REQUIRE( stc->GetTextLength() == 9);
+  REQUIRE( stc->GetLine(1) == "c\n");
+  
   // Test Substitute and flags.
   REQUIRE(!wxExAddressRange(ex, "1").Substitute("//y"));
   REQUIRE(!wxExAddressRange(ex, "0").Substitute("/x/y"));
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-batch.cpp
+// Purpose:   Implementation for wxExtension unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2018 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <experimental/filesystem>
+#include <fstream>
+#include <iterator>
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+#include <wx/extension/batch.h>
+#include "test.h"
+
+TEST_CASE("wxExBatch")
+{
+  namespace fs = std::experimental::filesystem;
+
+  const fs::path dir(fs::temp_directory_path() / "wxex-test-batch");
+  fs::create_directories(dir / ".git");
+
+  const auto write = [&](const std::string& name, const std::string& text) {
+    std::ofstream ofs(dir / name);
+    ofs << text;};
+
+  const auto read = [&](const std::string& name) {
+    std::ifstream ifs(dir / name);
+    return std::string(
+      std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());};
+
+  write("one.txt", "a x\nb\n");
+  write("two.txt", "c\n");
+
+  auto* top = wxTheApp->GetTopWindow();
+
+  // The ex commands use the frame, to show messages.
+  REQUIRE( wxExBatch({":%s/x/y/", ":g/b/d"}).Run({
+    wxExPath((dir / "one.txt").string()),
+    wxExPath((dir / "two.txt").string())}) == 0);
+  REQUIRE( read("one.txt") == "a y\n");
+  REQUIRE( read("two.txt") == "c\n");
+  REQUIRE( wxTheApp->GetTopWindow() == top);
+
+  REQUIRE( wxExBatch({":.s/x*//g"}).Run({wxExPath((dir / "two.txt").string())}) == 1);
+  REQUIRE( wxExBatch({":1"}).Run({wxExPath((dir / "xxx.txt").string())}) == 1);
+  REQUIRE( read("two.txt") == "c\n");
+
+  // A directory is expanded to all files, hidden directories are skipped.
+  write("three.cpp", "x\n");
+  write(".git/hidden.txt", "x\n");
+  REQUIRE( wxExBatch({":%s/x/z/"}).Run({wxExPath(dir.string())}) == 0);
+  REQUIRE( read("one.txt") == "a y\n");
+  REQUIRE( read("three.cpp") == "z\n");
+  REQUIRE( read(".git/hidden.txt") == "x\n");
+  REQUIRE( wxExBatch({":%s/z/x/"}).Run({wxExPath(dir.string())}, "*.txt") == 0);
+  REQUIRE( read("three.cpp") == "z\n");
+
+  // The file is replaced, a symbolic link and the permissions are kept.
+  const auto perms(fs::perms::owner_read | fs::perms::owner_write | fs::perms::group_read);
+  fs::permissions(dir / "one.txt", perms);
+  fs::create_symlink(dir / "one.txt", dir / "link.txt");
+  REQUIRE( wxExBatch({":%s/y/w/"}).Run({wxExPath((dir / "link.txt").string())}) == 0);
+  REQUIRE( fs::is_symlink(dir / "link.txt"));
+  REQUIRE( read("one.txt") == "a w\n");
+  REQUIRE( fs::status(dir / "one.txt").permissions() == perms);
+  REQUIRE(!fs::exists(dir / ".one.txt.tmp"));
+
+  fs::remove_all(dir);
+}
@@ -32,6 +32,15 @@ TEST_CASE("wxExCTags")
     REQUIRE( current.Kind() == "c" );
   }
 
+  SUBCASE("tags created on first use")
+  {
+    wxExEx* ex = &GetSTC()->GetVi();
+
+    REQUIRE( ex->GetCTags() != nullptr);
+    REQUIRE( ex->GetCTags() == ex->GetCTags());
+    REQUIRE( ex->GetCTags()->AutoComplete("wxExTest") == "wxExTestApp");
+  }
+
   SUBCASE("tags non-existing file")
   {
     data.CTagsFileName("xxx");
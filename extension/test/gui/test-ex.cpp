@@ -5,6 +5,7 @@
 // Copyright: (c) 2018 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <chrono>
 #include <vector>
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
@@ -193,8 +194,54 @@ TEST_CASE("wxExEx")
   
   // Test global move.
   stc->SetText("a\nb\nc\nd\ne\nf\ng\nh\ni\nj\nk\n");
-  REQUIRE(!ex->Command(":g/d/m$")); // possible infinite loop
-  REQUIRE( stc->GetText().Contains("d"));
+  REQUIRE( ex->Command(":g/d/m$"));
+  REQUIRE( stc->GetText() == "a\nb\nc\ne\nf\ng\nh\ni\nj\nk\nd\n");
+  REQUIRE( ex->Command(":g/[a-f]/m0"));
+  REQUIRE( stc->GetText() == "d\nf\ne\nc\nb\na\ng\nh\ni\nj\nk\n");
+  REQUIRE( ex->Command(":v/[a-f]/d"));
+  REQUIRE( stc->GetText() == "d\nf\ne\nc\nb\na\n");
+  REQUIRE( ex->Command(":g/[ace]/s//x/|s/x/y/"));
+  REQUIRE( stc->GetText() == "d\nf\ny\ny\nb\ny\n");
+  
+  // Test global on many lines.
+  std::string many;
+  for (int i = 0; i < 1000000; i++) many += (i % 2 ? "odd line\n": "even line\n");
+  stc->SetText(many);
+  auto start = std::chrono::system_clock::now();
+  REQUIRE( ex->Command(":g/odd/d"));
+  const auto milli_delete = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::system_clock::now() - start);
+  REQUIRE( stc->GetLineCount() == 500001);
+  start = std::chrono::system_clock::now();
+  REQUIRE( ex->Command(":g/even/s//line/"));
+  const auto milli_substitute = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::system_clock::now() - start);
+  REQUIRE(!stc->GetText().Contains("even"));
+  MESSAGE(":g/odd/d on 1000000 lines: " << milli_delete.count() << " ms, " <<
+    ":g/even/s//line/ on 500000 lines: " << milli_substitute.count() << " ms");
+  
+  // Test global with a range deleting a next matching line.
+  stc->SetText("a\nx1\nx2\nb");
+  REQUIRE( ex->Command(":g/x/.,+1d"));
+  REQUIRE( stc->GetText() == "a\nb");
+  
+  // Test global delete keeps marks on other lines.
+  stc->SetText("a\nx\nb\nx\nc\n");
+  REQUIRE( ex->MarkerAdd('a', 2));
+  REQUIRE( ex->Command(":g/x/d"));
+  REQUIRE( stc->GetText() == "a\nb\nc\n");
+  REQUIRE( ex->MarkerLine('a') == 1);
+  
+  // Test global keeps character markers, whatever their number.
+  wxExSTC* stcm = new wxExSTC(std::string("x\n"));
+  AddPane(GetFrame(), stcm);
+  wxExEx* exm = new wxExEx(stcm);
+  std::string marked("x\n");
+  for (char c = 'a'; c <= 'v'; c++) marked += "y\n";
+  stcm->SetText(marked);
+  for (char c = 'a'; c <= 'v'; c++) REQUIRE( exm->MarkerAdd(c, c - 'a' + 1));
+  REQUIRE( exm->Command(":g/x/d"));
+  for (char c = 'a'; c <= 'v'; c++) REQUIRE( exm->MarkerLine(c) == c - 'a');
   
   // Test substitute.
   stc->SetText("we have ccccc yyyy zzzz");
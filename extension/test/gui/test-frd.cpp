@@ -72,6 +72,15 @@ TEST_CASE("wxExFrd")
   const int res = frd->RegExReplaceAll(text);
   REQUIRE( res == 4);
   
+  frd->SetRegExEngine(wxExRegExEngine::REGEX_DFA);
+  REQUIRE( frd->GetRegExEngine() == wxExRegExEngine::REGEX_DFA);
+  REQUIRE( frd->UseRegEx());
+  REQUIRE( frd->RegExMatches("some text find9 other text") == 10);
+  text = "find1 find2 find3 find4";
+  REQUIRE( frd->RegExReplaceAll(text) == 4);
+  REQUIRE( text == "xxx xxx xxx xxx");
+  frd->SetRegExEngine(wxExRegExEngine::REGEX_STD);
+  
   frd->SetFindString("find[0-9");
   REQUIRE(!frd->UseRegEx());
   frd->SetUseRegEx(true);
@@ -5,10 +5,12 @@
 // Copyright: (c) 2017 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fstream>
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
 #endif
+#include <wx/extension/file.h>
 #include <wx/extension/hexmode.h>
 #include <wx/extension/lexers.h>
 #include <wx/extension/managedframe.h>
@@ -140,6 +142,54 @@ TEST_CASE("wxExHexMode")
   REQUIRE( hm->GetBuffer() == "hello world");
   REQUIRE( hm->GetSTC()->GetText() != "hello world");
   
+  // Test only lines needed are rendered.
+  hm->SetText(std::string(1000000, 'x'));
+  REQUIRE( hm->GetHexBuffer().GetSize() == 1000000);
+  REQUIRE( stc->GetLineCount() < 1000000 / 16);
+  hm->RenderLines(1000000 / 16);
+  REQUIRE( stc->GetLineCount() == 1000000 / 16);
+  REQUIRE( hm->Replace('y', 48));
+  REQUIRE( hm->GetHexBuffer().Get(0, 2) == "yx");
+  
+  // Test find renders the lines up to the text found only.
+  hm->SetText(std::string(500000, 'x') + "needle" + std::string(500000, 'x'));
+  REQUIRE( stc->GetLineCount() < 500000 / 16);
+  stc->DocumentStart();
+  REQUIRE( stc->FindNext(std::string("needle")));
+  REQUIRE( stc->GetLineCount() > 500000 / 16);
+  REQUIRE( stc->GetLineCount() < 1000000 / 16);
+  REQUIRE(!stc->FindNext(std::string("haystack")));
+  REQUIRE( stc->GetLineCount() < 1000000 / 16);
+  
+  // Test undo and redo, and save in place.
+  hm->SetText("0123456789");
+  REQUIRE( hm->Replace('x', 49));
+  REQUIRE( hm->GetBuffer() == "0x23456789");
+  stc->Undo();
+  REQUIRE( hm->GetBuffer() == "0123456789");
+  stc->Redo();
+  REQUIRE( hm->GetBuffer() == "0x23456789");
+  REQUIRE( stc->GetFile().FileSave());
+  REQUIRE(!hm->GetHexBuffer().IsModified());
+  REQUIRE( hm->Replace('y', 50));
+  REQUIRE( hm->GetHexBuffer().GetChanged().size() == 1);
+  REQUIRE( stc->GetFile().FileSave());
+  wxExFile file(GetTestPath("test.hex"));
+  REQUIRE( std::string(file.Read()->data(), 10) == "0xy3456789");
+  
+  // Test a file changed by others is written completely.
+  {
+    std::ofstream ofs(GetTestPath("test.hex").Path().string());
+    ofs << "abcdefghijkl";
+  }
+  REQUIRE( hm->Replace('z', 51));
+  REQUIRE( stc->GetFile().FileSave());
+  wxExFile changed(GetTestPath("test.hex"));
+  const auto* buffer = changed.Read();
+  REQUIRE( std::string(buffer->data(), buffer->length()) == "0xyz456789");
+  
+  hm->SetText("hello world");
+  
   wxKeyEvent event(wxEVT_KEY_DOWN);
   hm->SetPos(event);
   
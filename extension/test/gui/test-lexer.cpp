@@ -147,6 +147,37 @@ TEST_CASE("wxExLexer")
     REQUIRE( lexer.GetProperties().back().GetValue() == "one");
   }
 
+  SUBCASE("Shared definition")
+  {
+    REQUIRE( lexer.Set("cpp"));
+    wxExLexer copy(lexer);
+    REQUIRE(&copy.GetKeywords() == &lexer.GetKeywords());
+    REQUIRE(&wxExLexers::Get()->FindByName("cpp").GetKeywords() == &lexer.GetKeywords());
+
+    // Changing a copy leaves the lexers unchanged.
+    REQUIRE( copy.AddKeywords("hello"));
+    copy.SetProperty("test", "value");
+    REQUIRE( copy.IsKeyword("hello"));
+    REQUIRE(!lexer.IsKeyword("hello"));
+    REQUIRE(!wxExLexers::Get()->FindByName("cpp").IsKeyword("hello"));
+    REQUIRE( copy.GetProperties().size() == lexer.GetProperties().size() + 1);
+  }
+
+  SUBCASE("Version")
+  {
+    REQUIRE( lexer.Set("cpp"));
+    wxExLexer copy(lexer);
+    REQUIRE( copy.GetVersion() == lexer.GetVersion());
+
+    // Each change gets a new version.
+    const auto version = copy.GetVersion();
+    REQUIRE( copy.AddKeywords("hello"));
+    REQUIRE( copy.GetVersion() != version);
+    REQUIRE( copy.GetVersion() != lexer.GetVersion());
+    REQUIRE( lexer.Set("pascal"));
+    REQUIRE( lexer.GetVersion() != version);
+  }
+
   SUBCASE("Comment complete")
   {
     REQUIRE( lexer.Set("pascal"));
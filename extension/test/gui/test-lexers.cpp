@@ -45,6 +45,19 @@ TEST_CASE("wxExLexers")
 
   REQUIRE( wxExLexers::Get()->FindByFileName(
     GetTestPath("test.h").GetFullName()).GetScintillaLexer() == "cpp");
+
+  for (const auto& findby : std::vector<std::pair<std::string, std::string>> {
+    {"CMakeLists.txt", "cmake"},
+    {"test.cmake", "cmake"},
+    {"Makefile", "makefile"},
+    {"gnumakefile", "makefile"},
+    {"makefile.am", "makefile"},
+    {"Doxyfile", "bash"},
+    {"test.xxx", ""}})
+  {
+    REQUIRE( wxExLexers::Get()->FindByFileName(
+      findby.first).GetDisplayLexer() == findby.second);
+  }
     
   REQUIRE( wxExLexers::Get()->FindByName(
     "xxx").GetScintillaLexer().empty());
@@ -11,6 +11,7 @@
 #endif
 #include <wx/datetime.h>
 #include <wx/artprov.h> // for wxArt
+#include <wx/extension/listitem.h>
 #include <wx/extension/listview.h>
 #include <wx/extension/managedframe.h>
 #include "test.h"
@@ -122,4 +123,51 @@ TEST_CASE("wxExListView")
     wxCommandEvent* event = new wxCommandEvent(wxEVT_MENU, id);
     wxQueueEvent(listView2, event);
   }
+
+  wxExListView* listView3 = new wxExListView(wxExListViewData().Type(LIST_FIND));
+  AddPane(GetFrame(), listView3);
+  
+  REQUIRE( listView3->IsVirtual());
+  REQUIRE( listView3->GetStore() != nullptr);
+  REQUIRE(!listView->IsVirtual());
+  
+  for (int i = 0; i < 10; i++)
+  {
+    wxExListItem item(listView3, GetTestPath("test.h"));
+    item.Insert();
+    item.SetItem(_("Line No").ToStdString(), std::to_string(10 - i));
+    item.SetItem(_("Line").ToStdString(), "line " + std::to_string(i));
+  }
+  
+  REQUIRE( listView3->GetItemCount() == 10);
+  REQUIRE( listView3->GetStore()->GetRows() == 10);
+  REQUIRE( listView3->GetItemText(0) == "test.h");
+  REQUIRE( listView3->GetItemText(0, _("Line No").ToStdString()) == "10");
+  REQUIRE( listView3->ItemToText(0).find("line 0") != std::string::npos);
+  REQUIRE( listView3->FindNext("line 5"));
+  REQUIRE( listView3->GetFirstSelected() == 5);
+  REQUIRE( wxExListItem(listView3, 0).GetFileName().GetFullName() == "test.h");
+  
+  REQUIRE( listView3->SortColumn(_("Line No").ToStdString(), SORT_ASCENDING));
+  REQUIRE( listView3->GetItemText(0, _("Line No").ToStdString()) == "1");
+  REQUIRE( listView3->GetItemText(0, _("Line").ToStdString()) == "line 9");
+  
+  REQUIRE( listView3->DeleteItem(0));
+  REQUIRE( listView3->GetItemCount() == 9);
+  REQUIRE( listView3->GetStore()->GetRows() == 9);
+  REQUIRE( listView3->GetItemText(0, _("Line No").ToStdString()) == "2");
+
+  // Deleting using the base class also updates the store.
+  wxListCtrl* lc = listView3;
+  REQUIRE( lc->DeleteItem(0));
+  REQUIRE( listView3->GetStore()->GetRows() == 8);
+  REQUIRE( listView3->GetItemText(0, _("Line No").ToStdString()) == "3");
+  
+  wxExListItem(listView3, 0).SetReadOnly(true);
+  REQUIRE( listView3->IsItemReadOnly(0));
+  REQUIRE(!listView3->IsItemReadOnly(1));
+  
+  REQUIRE( lc->DeleteAllItems());
+  REQUIRE( listView3->GetItemCount() == 0);
+  REQUIRE( listView3->GetStore()->GetRows() == 0);
 }
@@ -86,6 +86,21 @@ TEST_CASE("wxExShell")
   REQUIRE( shell->GetText().find("aaa") != std::string::npos);
   REQUIRE( shell->GetText().find("bbb") == std::string::npos);
   
+  // Test bounded output.
+  shell->SetText("");
+  shell->SetMaxLines(100);
+  REQUIRE( shell->GetMaxLines() == 100);
+  for (int i = 0; i < 1000; i++) shell->AppendOutput("line\n");
+  shell->AppendText("x");
+  REQUIRE( shell->GetLineCount() == 101);
+  REQUIRE( shell->GetStatistics().Get(_("Lines appended").ToStdString()) == 1000);
+  REQUIRE( shell->GetStatistics().Get(_("Lines dropped").ToStdString()) == 900);
+  for (int i = 0; i < 10; i++) shell->AppendOutput("line\n");
+  shell->AppendText("");
+  REQUIRE( shell->GetLineCount() == 101);
+  REQUIRE( shell->GetStatistics().Get(_("Lines dropped").ToStdString()) == 910);
+  shell->SetMaxLines(0);
+  
   shell->SetProcess(nullptr);
   
   shell->DocumentEnd();
@@ -5,6 +5,9 @@
 // Copyright: (c) 2018 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <chrono>
+#include <experimental/filesystem>
+#include <fstream>
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
@@ -244,6 +247,46 @@ TEST_CASE("wxExSTC")
     stc.PropertiesMessage();
   }
 
+  SUBCASE("Open many files")
+  {
+    namespace fs = std::experimental::filesystem;
+    const auto dir(fs::temp_directory_path() / "wxex-test-stc");
+    fs::create_directories(dir);
+
+    std::vector<wxExPath> files;
+
+    for (int i = 0; i < 500; i++)
+    {
+      files.emplace_back((dir / ("file" + std::to_string(i) + ".cpp")).string());
+      std::ofstream(files.back().Path().string()) << 
+        "// file " << i << "\nint main()\n{\n  return " << i << ";\n}\n";
+    }
+
+    const auto start = std::chrono::system_clock::now();
+
+    for (int i = 0; i < (int)files.size(); i++)
+    {
+      wxExSTC stc(files[i]);
+      REQUIRE( stc.GetLineCount() == 6);
+      REQUIRE( stc.GetLexer().GetScintillaLexer() == "cpp");
+      REQUIRE( stc.GetLine(3).Contains("return " + std::to_string(i)));
+      
+      // Each stc uses the shared ex command table.
+      REQUIRE( stc.GetVi().Command(":f"));
+      REQUIRE( stc.GetVi().Command(":4"));
+      REQUIRE( stc.GetCurrentLine() == 3);
+      REQUIRE( stc.GetVi().Command(":1"));
+      REQUIRE( stc.GetCurrentLine() == 0);
+    }
+
+    const auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now() - start);
+
+    MESSAGE("open " << files.size() << " files: " << milli.count() << " ms");
+
+    fs::remove_all(dir);
+  }
+
   SUBCASE("xml complete")
   {
     REQUIRE( stc->GetLexer().Set("xml"));
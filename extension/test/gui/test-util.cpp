@@ -281,6 +281,9 @@ TEST_CASE("wxEx")
     REQUIRE( wxExMatch("(\\d+)ok(\\d+)nice", "19999ok245nice", v) == 2);
     REQUIRE( wxExMatch(" ([\\d\\w]+)", " 19999ok245nice ", v) == 1);
     REQUIRE( wxExMatch("([?/].*[?/])(,[?/].*[?/])([msy])", "/xx/,/yy/y", v) == 3);
+    REQUIRE( wxExMatch("(xx", "xx", v) == -1);
+    REQUIRE( wxExMatch(std::regex("([0-9]+)ok"), "19999ok", v) == 1);
+    REQUIRE( v[0] == "19999");
   }
   
   SUBCASE("wxExMatchesOneOf")
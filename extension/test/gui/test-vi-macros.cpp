@@ -95,6 +95,36 @@ TEST_CASE("wxExViMacros")
   
   REQUIRE( macros.Mode()->Transition("@a", vi) );
   
+  // Test playback of motions, and of the macro changed.
+  macros.Mode()->Transition("qc", vi);
+  macros.Record("j");
+  macros.Record("j");
+  macros.Mode()->Transition("q", vi);
+  stc->SetText(std::string(500, '\n'));
+  stc->DocumentStart();
+  REQUIRE( macros.Mode()->Transition("@c", vi, true, 100));
+  REQUIRE( stc->GetCurrentLine() == 200);
+  macros.Mode()->Transition("qC", vi);
+  macros.Record("k");
+  macros.Mode()->Transition("q", vi);
+  REQUIRE( macros.Mode()->Transition("@c", vi, true, 10));
+  REQUIRE( stc->GetCurrentLine() == 210);
+  
+  // Test playback of motions at the end, these do not fail.
+  stc->DocumentEnd();
+  const auto last = stc->GetCurrentLine();
+  REQUIRE( macros.Mode()->Transition("@c", vi, true, 10));
+  REQUIRE( stc->GetCurrentLine() == last - 1);
+  
+  // Test playback of ex commands and counted motions.
+  macros.Mode()->Transition("qd", vi);
+  macros.Record(":1");
+  macros.Record("2j");
+  macros.Record("2j");
+  macros.Mode()->Transition("q", vi);
+  REQUIRE( macros.Mode()->Transition("@d", vi));
+  REQUIRE( stc->GetCurrentLine() == 4);
+  
   // Test all builtin macro variables.
   for (auto& builtin : GetBuiltinVariables())
   {
@@ -5,12 +5,15 @@
 // Copyright: (c) 2018 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
 #endif
+#include <wx/extension/batch.h>
 #include <wx/extension/cmdline.h>
 #include <wx/extension/stc.h>
+#include <wx/extension/tokenizer.h>
 #include <wx/extension/tostring.h>
 #include <wx/extension/util.h>
 #include <wx/extension/version.h>
@@ -35,7 +38,9 @@ bool App::OnInit()
   if (bool exit = false;
     !wxExApp::OnInit() ||
     !wxExCmdLine(
-     {{{"d", "debug", "use debug mode"}, [&](bool on) {m_Debug = on;}},
+     {{{"b", "batch", "run script, command or macro on files without showing them"}, [&](bool on) {
+        m_Batch = on;}},
+      {{"d", "debug", "use debug mode"}, [&](bool on) {m_Debug = on;}},
       {{"H", "hex", "hex mode"}, [&](bool on) {
         if (!on) return;
         m_Data.Flags(STC_WIN_HEX, DATA_OR);}},
@@ -75,8 +80,12 @@ bool App::OnInit()
      {{{"c", "command", "vi command"}, {CMD_LINE_STRING, [&](const std::any& s) {
         m_Data.Control(wxExControlData().Command(std::any_cast<std::string>(s)));}}},
       {{"D", "logfile", "sets log file"}, {CMD_LINE_STRING, [&](const std::any& s) {}}},
+      {{"f", "filespec", "files to run batch on in directories"}, {CMD_LINE_STRING, [&](const std::any& s) {
+        m_FileSpec = std::any_cast<std::string>(s);}}},
       {{"L", "logflags", "sets log flags"}, {CMD_LINE_INT, [&](const std::any& s) {
         el::Loggers::addFlag((el::LoggingFlag)std::any_cast<int>(s));}}},
+      {{"M", "macro", "macro to run in batch"}, {CMD_LINE_STRING, [&](const std::any& s) {
+        m_Macro = std::any_cast<std::string>(s);}}},
       {{"m", "vmodule", "activates verbosity for files starting with main to level"}, {CMD_LINE_STRING, [&](const std::any& s) {}}},
       {{"s", "scriptin", "script in"}, {CMD_LINE_STRING, [&](const std::any& s) {
         m_Scriptin.Open(std::any_cast<std::string>(s));}}},
@@ -98,6 +107,40 @@ bool App::OnInit()
     return false;
   }
 
+  if (m_Batch)
+  {
+    std::vector<std::string> script;
+
+    if (m_Scriptin.IsOpened())
+    {
+      const auto buffer(m_Scriptin.Read());
+      wxExTokenizer tkz(std::string((const char *)buffer->data(), buffer->length()), "\r\n");
+      while (tkz.HasMoreTokens())
+      {
+        script.emplace_back(tkz.GetNextToken());
+      }
+    }
+    else if (!m_Macro.empty())
+    {
+      script.emplace_back(m_Macro.size() == 1 ? "@" + m_Macro: "@" + m_Macro + "@");
+    }
+    else if (!m_Data.Control().Command().Command().empty())
+    {
+      script.emplace_back(m_Data.Control().Command().Command());
+    }
+
+    if (script.empty())
+    {
+      std::cout << "batch needs a script, command or macro\n";
+      return false;
+    }
+
+    // The frame is not created, OnRun returns the result.
+    m_BatchResult = wxExBatch(script).Run(m_Files, m_FileSpec);
+
+    return true;
+  }
+
   Frame* frame = new Frame(this);
   
   if (!frame->IsClosing())
@@ -108,6 +151,12 @@ bool App::OnInit()
   return !frame->IsClosing();
 }
 
+int App::OnRun()
+{
+  // In batch mode the exit code is the number of files that failed.
+  return m_Batch ? std::min(m_BatchResult, 255): wxExApp::OnRun();
+}
+
 void App::Reset()
 {
   // do not reset flags
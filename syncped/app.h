@@ -28,12 +28,13 @@ private:
   virtual void MacOpenFiles(const wxArrayString& fileNames) override;
 #endif
   virtual bool OnInit() override;
+  virtual int OnRun() override;
 
-  std::string m_Tag; 
+  std::string m_FileSpec, m_Macro, m_Tag; 
   std::vector< wxExPath > m_Files;
   
-  bool m_Debug = false;
-  int m_Split;
+  bool m_Batch = false, m_Debug = false;
+  int m_BatchResult = 0, m_Split;
   wxExSTCData m_Data;
   wxExFile m_Scriptin, m_Scriptout;
 };